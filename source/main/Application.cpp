@@ -82,6 +82,7 @@ CVar* app_country;
 CVar* app_skip_main_menu;
 CVar* app_async_physics;
 CVar* app_num_workers;
+CVar* app_worker_spin_count;
 CVar* app_screenshot_format;
 CVar* app_rendersys_override;
 CVar* app_extra_mod_path;
@@ -110,6 +111,9 @@ CVar* sim_soft_reset_mode;
 CVar* sim_quickload_dialog;
 CVar* sim_live_repair_interval;
 CVar* sim_tuning_enabled;
+CVar* sim_buoyancy_parallel_threshold;
+CVar* sim_collision_mesh_cache;
+CVar* sim_deterministic;
 
 // Multiplayer
 CVar* mp_state;
@@ -262,6 +266,9 @@ CVar* gfx_reduce_shadows;
 CVar* gfx_enable_rtshaders;
 CVar* gfx_alt_actor_materials;
 CVar* gfx_auto_lod;
+CVar* gfx_static_batching;
+CVar* gfx_terrain_object_streaming;
+CVar* gfx_terrain_object_streaming_range;
 
 // Flexbodies
 CVar* flexbody_defrag_enabled;
@@ -271,6 +278,8 @@ CVar* flexbody_defrag_prog_down_penalty;
 CVar* flexbody_defrag_reorder_indices;
 CVar* flexbody_defrag_reorder_texcoords;
 CVar* flexbody_defrag_invert_lookup;
+CVar* flexbody_lod_max_interval;
+CVar* flexbody_still_epsilon;
 
 // GUI
 CVar* ui_show_live_repair_controls;
@@ -172,7 +172,7 @@ namespace RigDef
 {
 enum class Keyword
 {
-    // IMPORTANT! If you add a value here, you must also modify `RigDef::Regexes::IDENTIFY_KEYWORD`, it relies on numeric values of this enum.
+    // IMPORTANT! If you add a value here, you must also modify `KEYWORD_DEFS` in 'RigDef_Parser.cpp', it relies on numeric values of this enum.
 
     INVALID = 0,
 
@@ -622,6 +622,7 @@ extern CVar* app_country;
 extern CVar* app_skip_main_menu;
 extern CVar* app_async_physics;
 extern CVar* app_num_workers;
+extern CVar* app_worker_spin_count;      //!< int; times an idle thread re-checks for work before parking, 0 = park immediately
 extern CVar* app_screenshot_format;
 extern CVar* app_rendersys_override;
 extern CVar* app_extra_mod_path;
@@ -649,6 +650,9 @@ extern CVar* sim_soft_reset_mode;
 extern CVar* sim_quickload_dialog;
 extern CVar* sim_live_repair_interval; //!< Hold EV_COMMON_REPAIR_TRUCK to enter LiveRepair mode. 0 or negative interval disables.
 extern CVar* sim_tuning_enabled;
+extern CVar* sim_buoyancy_parallel_threshold; //!< Minimum number of buoyant cab triangles to split buoyancy across worker threads; 0 disables.
+extern CVar* sim_collision_mesh_cache; //!< Persist collision tris of terrain objects to the cache directory.
+extern CVar* sim_deterministic; //!< Reproducible physics (fixed summation order, no multithreaded inter-actor writes); actors record an `InputReplay`.
 
 // Multiplayer
 extern CVar* mp_state;
@@ -802,6 +806,9 @@ extern CVar* gfx_reduce_shadows;
 extern CVar* gfx_enable_rtshaders;
 extern CVar* gfx_alt_actor_materials;
 extern CVar* gfx_auto_lod;
+extern CVar* gfx_static_batching;          //!< bool; bake non-animated terrain objects into `Ogre::StaticGeometry` when loading terrain
+extern CVar* gfx_terrain_object_streaming; //!< bool; create/destroy visuals of TOBJ objects by distance, see `TerrainObjectManager::UpdateObjectStreaming()`
+extern CVar* gfx_terrain_object_streaming_range; //!< float; meters from camera or any actor
 
 // Flexbodies
 extern CVar* flexbody_defrag_enabled;
@@ -811,6 +818,8 @@ extern CVar* flexbody_defrag_prog_down_penalty;
 extern CVar* flexbody_defrag_reorder_indices;
 extern CVar* flexbody_defrag_reorder_texcoords;
 extern CVar* flexbody_defrag_invert_lookup;
+extern CVar* flexbody_lod_max_interval;     //!< int; max frames between updates of small/distant flexbodies, 1 = update every frame
+extern CVar* flexbody_still_epsilon;        //!< float; node displacement (meters) below which a flexbody isn't recomputed
 
 // GUI
 extern CVar* ui_show_live_repair_controls; //!< bool
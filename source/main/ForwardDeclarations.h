@@ -99,6 +99,7 @@ namespace RoR
     class  Actor;
     class  ActorManager;
     class  ActorSpawner;
+    struct ActorSpawnTemplate;
     class  AeroEngine;
     class  Airbrake;
     class  Airfoil;
@@ -141,6 +142,7 @@ namespace RoR
     struct GuiManagerImpl;
     class  HydraxWater;
     class  InputEngine;
+    class  InputReplay;
     class  IGfxWater;
     class  Landusemap;
     class  LanguageEngine;
@@ -165,6 +167,7 @@ namespace RoR
     class  Renderdash;
     class  Replay;
     class  RigLoadingProfiler;
+    class  RodBatch;
     class  Screwprop;
     class  ScriptEngine;
     class  ShadowManager;
@@ -227,6 +230,8 @@ namespace RoR
     typedef std::shared_ptr<SkinDocument> SkinDocumentPtr;
     typedef std::shared_ptr<TObjDocument> TObjDocumentPtr;
     typedef std::shared_ptr<Terrn2Document> Terrn2DocumentPtr;
+    typedef std::shared_ptr<InputReplay> InputReplayPtr;
+    typedef std::shared_ptr<ActorSpawnTemplate> ActorSpawnTemplatePtr;
 
     typedef RefCountingObjectPtr<Actor> ActorPtr;
     typedef RefCountingObjectPtr<CacheEntry> CacheEntryPtr;
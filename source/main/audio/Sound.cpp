@@ -39,6 +39,8 @@ Sound::Sound(ALuint buffer, SoundManager* soundManager, int sourceIndex) :
     , loop(false)
     , should_play(false)
     , hardware_index(-1)
+    , virtual_offset(0.0f)
+    , virtual_since(-1.0f)
 {
 }
 
@@ -61,6 +63,10 @@ void Sound::computeAudibility(Vector3 pos)
             should_play = false;
         }
     }
+    else if (!loop && should_play && hardware_index == -1 && sound_manager->getVirtualPlaybackOffset(this) < 0.0f)
+    {
+        should_play = false; // finished while virtual
+    }
 
     // should it play at all?
     if (!should_play || gain == 0.0f)
@@ -113,6 +119,7 @@ bool Sound::getEnabled()
 void Sound::play()
 {
     should_play = true;
+    virtual_since = -1.0f; // (re)start from the beginning
     sound_manager->recomputeSource(source_index, REASON_PLAY, 0.0f, NULL);
 }
 
@@ -88,6 +88,10 @@ private:
 
     // this value is changed dynamically, depending on whether the input is played or not.
     int hardware_index;
+
+    // playback position of a virtual source (not assigned to a hardware source), see `SoundManager::retire()`
+    float virtual_offset; //!< Seconds into the buffer when the source was retired
+    float virtual_since;  //!< SoundManager clock when the source was retired; negative = start from the beginning
     ALuint buffer;
 
     Ogre::Vector3 position;
@@ -31,6 +31,9 @@
 
 #include <OgreResourceGroupManager.h>
 
+#include <algorithm>
+#include <cmath>
+
 #define LOGSTREAM Ogre::LogManager::getSingleton().stream() << "[RoR|Audio] "
 
 bool _checkALErrors(const char* filename, int linenum)
@@ -54,6 +57,8 @@ using namespace Ogre;
 const float SoundManager::MAX_DISTANCE = 500.0f;
 const float SoundManager::ROLLOFF_FACTOR = 1.0f;
 const float SoundManager::REFERENCE_DISTANCE = 7.5f;
+const float SoundManager::HARDWARE_SOURCE_HYSTERESIS = 1.25f;
+const float SoundManager::OBSTRUCTION_REQUERY_DISTANCE = 0.5f;
 
 SoundManager::SoundManager()
 {
@@ -307,6 +312,11 @@ void SoundManager::CleanUp()
         }
     }
 
+    for (ObstructionCacheEntry& cache_entry : m_obstruction_cache)
+    {
+        cache_entry.valid = false; // the terrain is going away
+    }
+
     // TODO: Delete Sounds and buffers
 }
 
@@ -408,6 +418,9 @@ void SoundManager::Update(const float dt)
     const auto water = App::GetGameContext()->GetTerrain()->getWater();
     m_listener_is_underwater = (water != nullptr ? water->IsUnderWater(m_listener_position) : false);
 
+    m_virtual_clock += dt;
+    m_obstruction_queries_left = MAX_OBSTRUCTION_QUERIES_PER_FRAME;
+
     this->UpdateGlobalDopplerFactor();
     this->recomputeAllSources();
     this->UpdateAlListener();
@@ -943,50 +956,59 @@ bool compareByAudibility(std::pair<int, float> a, std::pair<int, float> b)
     return a.second > b.second;
 }
 
-// called when the camera moves
 void SoundManager::recomputeAllSources()
 {
-    // Creates this issue: https://github.com/RigsOfRods/rigs-of-rods/issues/1054
-#if 0
-	if (!audio_device) return;
-
-	for (int i=0; i < m_audio_sources_in_use_count; i++)
-	{
-		audio_sources[i]->computeAudibility(m_listener_position);
-		audio_sources_most_audible[i].first = i;
-		audio_sources_most_audible[i].second = audio_sources[i]->audibility;
-	}
-	// sort first 'num_hardware_sources' sources by audibility
-	// see: https://en.wikipedia.org/wiki/Selection_algorithm
-	if ((m_audio_sources_in_use_count - 1) > hardware_sources_num)
-	{
-		std::nth_element(audio_sources_most_audible, audio_sources_most_audible+hardware_sources_num, audio_sources_most_audible + m_audio_sources_in_use_count - 1, compareByAudibility);
-	}
-	// retire out of range sources first
-	for (int i=0; i < m_audio_sources_in_use_count; i++)
-	{
-		if (audio_sources[audio_sources_most_audible[i].first]->hardware_index != -1 && (i >= hardware_sources_num || audio_sources_most_audible[i].second == 0))
-			retire(audio_sources_most_audible[i].first);
-	}
-	// assign new sources
-	for (int i=0; i < std::min(m_audio_sources_in_use_count, hardware_sources_num); i++)
-	{
-		if (audio_sources[audio_sources_most_audible[i].first]->hardware_index == -1 && audio_sources_most_audible[i].second > 0)
-		{
-			for (int j=0; j < hardware_sources_num; j++)
-			{
-				if (hardware_sources_map[j] == -1)
-				{
-					assign(audio_sources_most_audible[i].first, j);
-					break;
-				}
-			}
-		}
-	}
-#endif
+    if (!audio_device)
+        return;
+
+    // Rank the audible sources; the ones which already play get a bonus (hysteresis),
+    // so that sources of nearly equal audibility don't keep taking the hardware sources from each other.
+    int num_audible = 0;
+    for (int i = 0; i < m_audio_sources_in_use_count; i++)
+    {
+        audio_sources[i]->computeAudibility(m_listener_position);
+        if (audio_sources[i]->audibility > 0.0f)
+        {
+            float score = audio_sources[i]->audibility;
+            if (audio_sources[i]->hardware_index != -1)
+                score *= HARDWARE_SOURCE_HYSTERESIS;
+            audio_sources_most_audible[num_audible++] = std::make_pair(i, score);
+        }
+        else if (audio_sources[i]->hardware_index != -1)
+        {
+            retire(i);
+        }
+    }
+
+    // select the 'hardware_sources_num' most audible sources, the rest becomes virtual
+    // see: https://en.wikipedia.org/wiki/Selection_algorithm
+    if (num_audible > hardware_sources_num)
+    {
+        std::nth_element(audio_sources_most_audible, audio_sources_most_audible + hardware_sources_num, audio_sources_most_audible + num_audible, compareByAudibility);
+        for (int i = hardware_sources_num; i < num_audible; i++)
+        {
+            retire(audio_sources_most_audible[i].first); // no-op if it's virtual already
+        }
+        num_audible = hardware_sources_num;
+    }
+
+    // assign the selected sources - retiring went first, so there is a free hardware source for each
+    int hardware_index = 0;
+    for (int i = 0; i < num_audible; i++)
+    {
+        if (audio_sources[audio_sources_most_audible[i].first]->hardware_index != -1)
+            continue;
+
+        while (hardware_index < hardware_sources_num && hardware_sources_map[hardware_index] != -1)
+            hardware_index++;
+        if (hardware_index == hardware_sources_num)
+            break;
+
+        assign(audio_sources_most_audible[i].first, hardware_index);
+    }
 }
 
-void SoundManager::UpdateSourceFilters(const int hardware_index) const
+void SoundManager::UpdateSourceFilters(const int hardware_index)
 {
     bool source_is_obstructed = this->IsHardwareSourceObstructed(hardware_index);
 
@@ -1009,7 +1031,7 @@ void SoundManager::UpdateSourceFilters(const int hardware_index) const
     }
 }
 
-bool SoundManager::IsHardwareSourceObstructed(const int hardware_index) const
+bool SoundManager::IsHardwareSourceObstructed(const int hardware_index)
 {
     if (    hardware_sources_map[hardware_index] == -1                    // no sound assigned to hardware source
          || App::app_state->getEnum<AppState>()  != AppState::SIMULATION) // this is necessary to prevent a crash with enabled main menu music
@@ -1040,36 +1062,8 @@ bool SoundManager::IsHardwareSourceObstructed(const int hardware_index) const
     const Ogre::Ray             direct_path_to_sound = Ray(m_listener_position, direction_to_sound);
     bool                        obstruction_detected = false;
 
-    // perform line of sight check against collision meshes
-    // for this to work correctly, the direction vector of the ray must have
-    // the length of the distance from the listener to the sound
-    intersection = App::GetGameContext()->GetTerrain()->GetCollisions()->intersectsTris(direct_path_to_sound);
-    obstruction_detected = intersection.first;
-
-    if (!obstruction_detected)
-    {
-        // perform line of sight check agains collision boxes
-        for (const collision_box_t& collision_box : App::GetGameContext()->GetTerrain()->GetCollisions()->getCollisionBoxes())
-        {
-            if (!collision_box.enabled || collision_box.virt) { continue; }
-
-            Ogre::AxisAlignedBox collision_box_aab = Ogre::AxisAlignedBox(collision_box.lo, collision_box.hi);
-
-            // Skip cases where the obstruction filter detection becomes unstable
-            if (   collision_box_aab.contains(corresponding_sound->getPosition())
-                || collision_box_aab.distance(corresponding_sound->getPosition()) < 0.1f)
-            {
-                continue;
-            }
-
-            intersection = direct_path_to_sound.intersects(collision_box_aab);
-            obstruction_detected = intersection.first && intersection.second <= 1.0f;
-            if (obstruction_detected)
-            {
-                break;
-            }
-        }
-    }
+    // perform line of sight checks against collision meshes, boxes and terrain (cached)
+    obstruction_detected = this->IsHardwareSourceObstructedByStatics(hardware_index);
 
     if (!obstruction_detected)
     {
@@ -1108,13 +1102,56 @@ bool SoundManager::IsHardwareSourceObstructed(const int hardware_index) const
         }
     }
 
+    return obstruction_detected;
+}
+
+bool SoundManager::IsHardwareSourceObstructedByStatics(const int hardware_index)
+{
+    const SoundPtr&        corresponding_sound = audio_sources[hardware_sources_map[hardware_index]];
+    ObstructionCacheEntry& cache_entry         = m_obstruction_cache[hardware_index];
+
+    if (cache_entry.valid)
+    {
+        const bool moved =
+               cache_entry.listener_position.squaredDistance(m_listener_position) > OBSTRUCTION_REQUERY_DISTANCE * OBSTRUCTION_REQUERY_DISTANCE
+            || cache_entry.source_position.squaredDistance(corresponding_sound->getPosition()) > OBSTRUCTION_REQUERY_DISTANCE * OBSTRUCTION_REQUERY_DISTANCE;
+        if (!moved || m_obstruction_queries_left <= 0)
+        {
+            return cache_entry.obstructed; // up to date, or spread the work over next frames
+        }
+    }
+    m_obstruction_queries_left--; // a source without valid result is always queried, the budget may go negative
+
+    std::pair<bool, Ogre::Real> intersection;
+    const Ogre::Vector3         direction_to_sound   = corresponding_sound->getPosition() - m_listener_position;
+    const Ogre::Ray             direct_path_to_sound = Ray(m_listener_position, direction_to_sound);
+    Collisions*                 collisions           = App::GetGameContext()->GetTerrain()->GetCollisions();
+
+    // perform line of sight check against collision meshes
+    // for this to work correctly, the direction vector of the ray must have
+    // the length of the distance from the listener to the sound
+    intersection = collisions->intersectsTris(direct_path_to_sound);
+    bool obstruction_detected = intersection.first;
+
+    if (!obstruction_detected)
+    {
+        // perform line of sight check agains collision boxes
+        // skip boxes around the sound, where the obstruction filter detection becomes unstable
+        intersection = collisions->intersectsBoxes(direct_path_to_sound, /*skip_margin:*/0.1f);
+        obstruction_detected = intersection.first;
+    }
+
     if (!obstruction_detected)
     {
         // perform line of sight check against terrain
-        intersection = App::GetGameContext()->GetTerrain()->GetCollisions()->intersectsTerrain(direct_path_to_sound);
+        intersection = collisions->intersectsTerrain(direct_path_to_sound);
         obstruction_detected = intersection.first;
     }
 
+    cache_entry.valid = true;
+    cache_entry.obstructed = obstruction_detected;
+    cache_entry.listener_position = m_listener_position;
+    cache_entry.source_position = corresponding_sound->getPosition();
     return obstruction_detected;
 }
 
@@ -1396,8 +1433,8 @@ void SoundManager::recomputeSource(int source_index, int reason, float vfl, Vect
                         al_faintest = i;
                     }
                 }
-                // check to ensure that the sound is louder than the faintest sound currently playing
-                if (fv < audio_sources[source_index]->audibility)
+                // check to ensure that the sound is clearly louder than the faintest sound currently playing
+                if (fv * HARDWARE_SOURCE_HYSTERESIS < audio_sources[source_index]->audibility)
                 {
                     // this new m_audio_sources[source_index] is louder than the faintest!
                     retire(hardware_sources_map[al_faintest]);
@@ -1415,6 +1452,7 @@ void SoundManager::assign(int source_index, int hardware_index)
         return;
     audio_sources[source_index]->hardware_index = hardware_index;
     hardware_sources_map[hardware_index] = source_index;
+    m_obstruction_cache[hardware_index].valid = false;
 
     ALuint hw_source = hardware_sources[hardware_index];
     SoundPtr& audio_source = audio_sources[source_index];
@@ -1429,9 +1467,20 @@ void SoundManager::assign(int source_index, int hardware_index)
 
     if (audio_source->should_play)
     {
-        this->UpdateSourceFilters(audio_sources[source_index]->hardware_index);
-        alSourcePlay(hw_source);
+        // resume a virtual source where it would be now
+        const float offset = this->getVirtualPlaybackOffset(audio_source.GetRef());
+        if (offset < 0.0f)
+        {
+            audio_source->should_play = false; // finished while virtual
+        }
+        else
+        {
+            alSourcef(hw_source, AL_SEC_OFFSET, offset); // applied by the next `alSourcePlay()`
+            this->UpdateSourceFilters(audio_sources[source_index]->hardware_index);
+            alSourcePlay(hw_source);
+        }
     }
+    audio_source->virtual_since = -1.0f;
 
     hardware_sources_in_use_count++;
 }
@@ -1442,12 +1491,59 @@ void SoundManager::retire(int source_index)
         return;
     if (audio_sources[source_index]->hardware_index == -1)
         return;
-    alSourceStop(hardware_sources[audio_sources[source_index]->hardware_index]);
+
+    // remember the playback position, so that the source can be resumed seamlessly
+    ALuint hw_source = hardware_sources[audio_sources[source_index]->hardware_index];
+    int state = 0;
+    alGetSourcei(hw_source, AL_SOURCE_STATE, &state);
+    if (audio_sources[source_index]->should_play && state == AL_PLAYING)
+    {
+        alGetSourcef(hw_source, AL_SEC_OFFSET, &audio_sources[source_index]->virtual_offset);
+        audio_sources[source_index]->virtual_since = m_virtual_clock;
+    }
+    else
+    {
+        audio_sources[source_index]->virtual_since = -1.0f;
+    }
+
+    alSourceStop(hw_source);
     hardware_sources_map[audio_sources[source_index]->hardware_index] = -1;
     audio_sources[source_index]->hardware_index = -1;
     hardware_sources_in_use_count--;
 }
 
+float SoundManager::getVirtualPlaybackOffset(const Sound* sound) const
+{
+    if (sound->virtual_since < 0.0f)
+        return 0.0f;
+
+    const float duration = this->getBufferDuration(sound->buffer);
+    if (duration <= 0.0f)
+        return 0.0f;
+
+    const float offset = sound->virtual_offset + (m_virtual_clock - sound->virtual_since) * sound->pitch;
+    if (offset < duration)
+        return offset;
+    else if (sound->loop)
+        return std::fmod(offset, duration);
+    else
+        return -1.0f;
+}
+
+float SoundManager::getBufferDuration(ALuint buffer) const
+{
+    ALint size = 0, channels = 0, bits = 0, frequency = 0;
+    alGetBufferi(buffer, AL_SIZE, &size);
+    alGetBufferi(buffer, AL_CHANNELS, &channels);
+    alGetBufferi(buffer, AL_BITS, &bits);
+    alGetBufferi(buffer, AL_FREQUENCY, &frequency);
+    if (channels <= 0 || bits <= 0 || frequency <= 0)
+        return 0.0f;
+
+    const float num_samples = (size * 8.0f) / (channels * bits);
+    return num_samples / frequency;
+}
+
 void SoundManager::pauseAllSounds()
 {
     if (!audio_device)
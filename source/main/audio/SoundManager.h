@@ -204,8 +204,11 @@ public:
     static const float MAX_DISTANCE;
     static const float ROLLOFF_FACTOR;
     static const float REFERENCE_DISTANCE;
+    static const float HARDWARE_SOURCE_HYSTERESIS; //!< Audibility bonus of sources which already play, so that equally loud sources don't keep swapping
     static const unsigned int MAX_HARDWARE_SOURCES = 32;
     static const unsigned int MAX_AUDIO_BUFFERS = 8192;
+    static const float OBSTRUCTION_REQUERY_DISTANCE;
+    static const int MAX_OBSTRUCTION_QUERIES_PER_FRAME = 8;
 
 private:
     /**
@@ -219,6 +222,10 @@ private:
      */
     void UpdateListenerEnvironment();
 
+    /**
+     * Gives the hardware sources to the most audible audio sources. The rest become virtual,
+     * i.e. they keep advancing their playback position and resume from there when they get a hardware source back.
+     */
     void recomputeAllSources();
 
     /**
@@ -251,6 +258,14 @@ private:
      */
     void retire(int source_index);
 
+    /**
+     * @return Position (seconds) where a virtual source would be now; 0 if it should start from the beginning,
+     *         negative if a non-looping sound has already finished.
+     */
+    float getVirtualPlaybackOffset(const Sound* sound) const;
+
+    float getBufferDuration(ALuint buffer) const; //!< Seconds
+
     bool loadWAVFile(Ogre::String filename, ALuint buffer, Ogre::String resource_group_name = "");
 
     // active audio sources (hardware sources)
@@ -264,6 +279,18 @@ private:
     SoundPtr audio_sources[MAX_AUDIO_BUFFERS] = { nullptr };
     // helper for calculating the most audible sources
     std::pair<int, float> audio_sources_most_audible[MAX_AUDIO_BUFFERS];
+    float                 m_virtual_clock = 0.f; //!< Seconds, for advancing virtual sources
+
+    // cached results of `IsHardwareSourceObstructedByStatics()`
+    struct ObstructionCacheEntry
+    {
+        bool          valid = false;
+        bool          obstructed = false;
+        Ogre::Vector3 listener_position;
+        Ogre::Vector3 source_position;
+    };
+    ObstructionCacheEntry m_obstruction_cache[MAX_HARDWARE_SOURCES];
+    int                   m_obstruction_queries_left = MAX_OBSTRUCTION_QUERIES_PER_FRAME; //!< Reset every frame
 
     // audio buffers: Array of AL buffers and filenames
     int          audio_buffers_in_use_count = 0;
@@ -357,7 +384,7 @@ private:
      *   Helper function to call several other functions to update source filters.
      *   @param hardware_index The index of the hardware source.
      */
-    void    UpdateSourceFilters(const int hardware_index) const;
+    void    UpdateSourceFilters(const int hardware_index);
 
     /**
      *   Performs various checks against the environment of the listener to determine
@@ -365,7 +392,16 @@ private:
      *   @param hardware_index The index of the hardware source.
      *   @return True if the sound is obstructed from the listener's point of view, false otherwise.
      */
-    bool    IsHardwareSourceObstructed(const int hardware_index) const;
+    bool    IsHardwareSourceObstructed(const int hardware_index);
+
+    /**
+     *   Line of sight checks against static geometry (collision meshes, boxes, terrain), cached per hardware source.
+     *   The query is only repeated once the listener or the sound moved by `OBSTRUCTION_REQUERY_DISTANCE`,
+     *   and at most `MAX_OBSTRUCTION_QUERIES_PER_FRAME` times per frame - other sources keep their last result meanwhile.
+     *   @param hardware_index The index of the hardware source.
+     *   @return True if static geometry is in the way.
+     */
+    bool    IsHardwareSourceObstructedByStatics(const int hardware_index);
 
     /**
      *   Applies an obstruction filter to the provided hardware source.
@@ -30,6 +30,8 @@
 
 #include <OgreResourceGroupManager.h>
 
+#include <algorithm>
+
 using namespace Ogre;
 using namespace RoR;
 
@@ -58,21 +60,6 @@ SoundScriptManager::SoundScriptManager() :
         free_gains[i] = 0;
     }
 
-    // TODO: there is a memory corruption going on here, need to fix
-    for (int i = 0; i < SS_MAX_TRIG * MAX_INSTANCES_PER_GROUP; i++)
-    {
-        trigs[i] = 0;
-    }
-
-    for (int i = 0; i < SS_MAX_MOD * MAX_INSTANCES_PER_GROUP; i++)
-    {
-        pitches[i] = 0;
-        gains[i] = 0;
-    }
-
-    // reset all states
-    state_map.clear();
-
     sound_manager = new SoundManager();
 
     if (!sound_manager)
@@ -116,12 +103,13 @@ void SoundScriptManager::trigOnce(int actor_id, int trig, int linkType, int link
     if (disabled)
         return;
 
-    for (int i = 0; i < free_trigs[trig]; i++)
-    {
-        // cycle through all instance groups
-        const SoundScriptInstancePtr& inst = trigs[trig + i * SS_MAX_TRIG];
+    ActorSoundTable* table = this->FindActorTable(actor_id);
+    if (!table)
+        return;
 
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
+    for (SoundScriptInstance* inst : table->trigs[trig])
+    {
+        if (inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
         {
             inst->runOnce();
         }
@@ -146,13 +134,12 @@ void SoundScriptManager::trigStart(int actor_id, int trig, int linkType, int lin
     if (getTrigState(actor_id, trig, linkType, linkItemID))
         return;
 
-    state_map[linkType][linkItemID][actor_id][trig] = true;
+    ActorSoundTable& table = actor_tables[actor_id];
+    table.GetTrigStates(linkType, linkItemID)[trig] = true;
 
-    for (int i = 0; i < free_trigs[trig]; i++)
+    for (SoundScriptInstance* inst : table.trigs[trig])
     {
-        const SoundScriptInstancePtr& inst = trigs[trig + i * SS_MAX_TRIG];
-
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
+        if (inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
         {
             inst->start();
         }
@@ -177,12 +164,11 @@ void SoundScriptManager::trigStop(int actor_id, int trig, int linkType, int link
     if (!getTrigState(actor_id, trig, linkType, linkItemID))
         return;
 
-    state_map[linkType][linkItemID][actor_id][trig] = false;
-    for (int i = 0; i < free_trigs[trig]; i++)
+    ActorSoundTable* table = this->FindActorTable(actor_id); // Exists, the state is set
+    table->GetTrigStates(linkType, linkItemID)[trig] = false;
+    for (SoundScriptInstance* inst : table->trigs[trig])
     {
-        const SoundScriptInstancePtr& inst = trigs[trig + i * SS_MAX_TRIG];
-
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
+        if (inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
         {
             inst->stop();
         }
@@ -207,12 +193,11 @@ void SoundScriptManager::trigKill(int actor_id, int trig, int linkType, int link
     if (!getTrigState(actor_id, trig, linkType, linkItemID))
         return;
 
-    state_map[linkType][linkItemID][actor_id][trig] = false;
-    for (int i = 0; i < free_trigs[trig]; i++)
+    ActorSoundTable* table = this->FindActorTable(actor_id); // Exists, the state is set
+    table->GetTrigStates(linkType, linkItemID)[trig] = false;
+    for (SoundScriptInstance* inst : table->trigs[trig])
     {
-        const SoundScriptInstancePtr& inst = trigs[trig + i * SS_MAX_TRIG];
-
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
+        if (inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
         {
             inst->kill();
         }
@@ -256,8 +241,15 @@ bool SoundScriptManager::getTrigState(int actor_id, int trig, int linkType, int
 {
     if (disabled)
         return false;
+    if (trig < 0 || trig >= SS_MAX_TRIG)
+        return false;
+
+    ActorSoundTable* table = this->FindActorTable(actor_id);
+    if (!table)
+        return false;
 
-    return state_map[linkType][linkItemID][actor_id][trig];
+    std::bitset<SS_MAX_TRIG>* states = table->FindTrigStates(linkType, linkItemID);
+    return states && (*states)[trig];
 }
 
 void SoundScriptManager::modulate(const ActorPtr& actor, int mod, float value, int linkType, int linkItemID)
@@ -279,10 +271,13 @@ void SoundScriptManager::modulate(int actor_id, int mod, float value, int linkTy
     if (mod >= SS_MAX_MOD)
         return;
 
-    for (int i = 0; i < free_gains[mod]; i++)
+    ActorSoundTable* table = this->FindActorTable(actor_id);
+    if (!table)
+        return;
+
+    for (SoundScriptInstance* inst : table->gains[mod])
     {
-        const SoundScriptInstancePtr& inst = gains[mod + i * SS_MAX_MOD];
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
+        if (inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
         {
             // this one requires modulation
             float gain = value * value * inst->templ->gain_square + value * inst->templ->gain_multiplier + inst->templ->gain_offset;
@@ -292,10 +287,9 @@ void SoundScriptManager::modulate(int actor_id, int mod, float value, int linkTy
         }
     }
 
-    for (int i = 0; i < free_pitches[mod]; i++)
+    for (SoundScriptInstance* inst : table->pitches[mod])
     {
-        const SoundScriptInstancePtr& inst = pitches[mod + i * SS_MAX_MOD];
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
+        if (inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
         {
             // this one requires modulation
             float pitch = value * value * inst->templ->pitch_square + value * inst->templ->pitch_multiplier + inst->templ->pitch_offset;
@@ -305,6 +299,35 @@ void SoundScriptManager::modulate(int actor_id, int mod, float value, int linkTy
     }
 }
 
+SoundScriptManager::ActorSoundTable* SoundScriptManager::FindActorTable(int actor_id)
+{
+    auto itor = actor_tables.find(actor_id);
+    return (itor != actor_tables.end()) ? &itor->second : nullptr;
+}
+
+std::bitset<SS_MAX_TRIG>* SoundScriptManager::ActorSoundTable::FindTrigStates(int link_type, int link_item_id)
+{
+    for (TrigStates& entry : trig_states)
+    {
+        if (entry.link_type == link_type && entry.link_item_id == link_item_id)
+            return &entry.states;
+    }
+    return nullptr;
+}
+
+std::bitset<SS_MAX_TRIG>& SoundScriptManager::ActorSoundTable::GetTrigStates(int link_type, int link_item_id)
+{
+    std::bitset<SS_MAX_TRIG>* states = this->FindTrigStates(link_type, link_item_id);
+    if (states)
+        return *states;
+
+    TrigStates entry;
+    entry.link_type = link_type;
+    entry.link_item_id = link_item_id;
+    trig_states.push_back(entry);
+    return trig_states.back().states;
+}
+
 void SoundScriptManager::update(float dt)
 {
     if (App::sim_state->getEnum<SimState>() == SimState::RUNNING ||
@@ -387,17 +410,20 @@ SoundScriptInstancePtr SoundScriptManager::createInstance(Ogre::String templaten
     instance_counter++;
 
     // register to lookup tables
-    trigs[templ->trigger_source + free_trigs[templ->trigger_source] * SS_MAX_TRIG] = inst;
+    ActorSoundTable& table = actor_tables[actor_id];
+    table.num_instances++;
+
+    table.trigs[templ->trigger_source].push_back(inst.GetRef());
     free_trigs[templ->trigger_source]++;
 
     if (templ->gain_source != SS_MOD_NONE)
     {
-        gains[templ->gain_source + free_gains[templ->gain_source] * SS_MAX_MOD] = inst;
+        table.gains[templ->gain_source].push_back(inst.GetRef());
         free_gains[templ->gain_source]++;
     }
     if (templ->pitch_source != SS_MOD_NONE)
     {
-        pitches[templ->pitch_source + free_pitches[templ->pitch_source] * SS_MAX_MOD] = inst;
+        table.pitches[templ->pitch_source].push_back(inst.GetRef());
         free_pitches[templ->pitch_source]++;
     }
 
@@ -412,63 +438,31 @@ SoundScriptInstancePtr SoundScriptManager::createInstance(Ogre::String templaten
 
 void SoundScriptManager::removeInstance(const SoundScriptInstancePtr& ssi)
 {
-    // Find lookup table entries
-    int trigsPos = -1;
-    for (int i = 0; i < free_trigs[ssi->templ->trigger_source]; i++)
-    {
-        if (trigs[ssi->templ->trigger_source + i * SS_MAX_TRIG] == ssi)
-        {
-            trigsPos = i;
-        }
-    }
-
-    int gainsPos = -1;
-    for (int i = 0; i < free_gains[ssi->templ->gain_source]; i++)
-    {
-        if (gains[ssi->templ->gain_source + i * SS_MAX_MOD] == ssi)
-        {
-            gainsPos = i;
-        }
-    }
-
-    int pitchesPos = -1;
-    for (int i = 0; i < free_gains[ssi->templ->pitch_source]; i++)
-    {
-        if (pitches[ssi->templ->pitch_source + i * SS_MAX_MOD] == ssi)
-        {
-            pitchesPos = i;
-        }
-    }
-
     // Erase lookup entries
-    if (trigsPos != -1)
+    ActorSoundTable* table = this->FindActorTable(ssi->actor_id);
+    if (table)
     {
-        for (int i = trigsPos + 1; i < free_trigs[ssi->templ->trigger_source]; i++)
+        auto erase_from = [&ssi](std::vector<SoundScriptInstance*>& list) -> bool
         {
-            trigs[ssi->templ->trigger_source + (i - 1) * SS_MAX_TRIG]
-                = trigs[ssi->templ->trigger_source + i * SS_MAX_TRIG];
-        }
-        free_trigs[ssi->templ->trigger_source]--;
-    }
+            auto itor = std::find(list.begin(), list.end(), ssi.GetRef());
+            if (itor == list.end())
+                return false;
+            list.erase(itor);
+            return true;
+        };
 
-    if (gainsPos != -1)
-    {
-        for (int i = gainsPos + 1; i < free_gains[ssi->templ->gain_source]; i++)
-        {
-            gains[ssi->templ->gain_source + (i - 1) * SS_MAX_MOD]
-                = gains[ssi->templ->gain_source + i * SS_MAX_MOD];
-        }
-        free_gains[ssi->templ->gain_source]--;
-    }
+        if (erase_from(table->trigs[ssi->templ->trigger_source]))
+            free_trigs[ssi->templ->trigger_source]--;
+        if (ssi->templ->gain_source != SS_MOD_NONE && erase_from(table->gains[ssi->templ->gain_source]))
+            free_gains[ssi->templ->gain_source]--;
+        if (ssi->templ->pitch_source != SS_MOD_NONE && erase_from(table->pitches[ssi->templ->pitch_source]))
+            free_pitches[ssi->templ->pitch_source]--;
 
-    if (pitchesPos != -1)
-    {
-        for (int i = pitchesPos + 1; i < free_pitches[ssi->templ->pitch_source]; i++)
+        table->num_instances--;
+        if (table->num_instances == 0)
         {
-            pitches[ssi->templ->pitch_source + (i - 1) * SS_MAX_MOD]
-                = pitches[ssi->templ->pitch_source + i * SS_MAX_MOD];
+            actor_tables.erase(ssi->actor_id); // The actor is being deleted
         }
-        free_pitches[ssi->templ->pitch_source]--;
     }
 
     // Finally remove the instance from list
@@ -30,6 +30,8 @@
 #include "SoundManager.h"
 
 #include <OgreScriptLoader.h>
+#include <bitset>
+#include <unordered_map>
 
 #define SOUND_PLAY_ONCE(_ACTOR_, _TRIG_)        App::GetSoundScriptManager()->trigOnce    ( (_ACTOR_), (_TRIG_) )
 #define SOUND_START(_ACTOR_, _TRIG_)            App::GetSoundScriptManager()->trigStart   ( (_ACTOR_), (_TRIG_) )
@@ -352,19 +354,35 @@ private:
     std::map <Ogre::String, SoundScriptTemplatePtr> templates;
     std::vector<SoundScriptInstancePtr> instances;
 
-    // instances lookup tables - using `std::array<>` because it does bounds checking under VisualStudio/Debug.
-    std::array<int, SS_MAX_TRIG> free_trigs;
-    std::array<SoundScriptInstancePtr, SS_MAX_TRIG* MAX_INSTANCES_PER_GROUP> trigs;
+    /// Per-actor lookup tables, so that trigger/modulate calls only visit sounds of the given actor.
+    /// Pointers are non-owning, `instances` holds the references.
+    struct ActorSoundTable
+    {
+        struct TrigStates
+        {
+            int link_type;
+            int link_item_id;
+            std::bitset<SS_MAX_TRIG> states;
+        };
+
+        std::bitset<SS_MAX_TRIG>* FindTrigStates(int link_type, int link_item_id);
+        std::bitset<SS_MAX_TRIG>& GetTrigStates(int link_type, int link_item_id); //!< Creates the entry if needed
+
+        std::array<std::vector<SoundScriptInstance*>, SS_MAX_TRIG> trigs;
+        std::array<std::vector<SoundScriptInstance*>, SS_MAX_MOD> gains;
+        std::array<std::vector<SoundScriptInstance*>, SS_MAX_MOD> pitches;
+        std::vector<TrigStates> trig_states; //!< One entry per used link; almost always just `SL_DEFAULT`
+        int num_instances = 0;
+    };
+
+    ActorSoundTable* FindActorTable(int actor_id);
 
+    std::unordered_map<int, ActorSoundTable> actor_tables;
+
+    // instance counts, for enforcing MAX_INSTANCES_PER_GROUP
+    std::array<int, SS_MAX_TRIG> free_trigs;
     std::array<int, SS_MAX_MOD> free_pitches;
-    std::array<SoundScriptInstancePtr, SS_MAX_MOD* MAX_INSTANCES_PER_GROUP> pitches;
-    
     std::array<int, SS_MAX_MOD> free_gains;
-    std::array<SoundScriptInstancePtr, SS_MAX_MOD* MAX_INSTANCES_PER_GROUP> gains;
-
-    // state map
-    // soundLinks, soundItems, actor_ids, triggers
-    std::map <int, std::map <int, std::map <int, std::map <int, bool > > > > state_map;
 
     void SetListenerEnvironment(Ogre::Vector3 position);
 
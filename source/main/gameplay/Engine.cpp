@@ -374,7 +374,7 @@ void Engine::UpdateEngine(float dt, int doUpdate)
                 // anti lag
                 if (m_turbo_has_antilag && m_cur_acc < 0.5)
                 {
-                    float f = frand();
+                    float f = frand(m_actor->ar_sim_rng_state);
                     if (m_cur_engine_rpm > m_antilag_min_rpm && f > m_antilag_rand_chance)
                     {
                         if (m_cur_turbo_rpm[i] > m_max_turbo_rpm * 0.35 && m_cur_turbo_rpm[i] < m_max_turbo_rpm)
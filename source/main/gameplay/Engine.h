@@ -42,6 +42,7 @@ class Engine : public RefCountingObject<Engine>
 {
     friend class ActorSpawner;
     friend class Actor; // For `get/setSimAttribute()`
+    friend class InputReplay;
 
 public:
 
@@ -0,0 +1,450 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "InputReplay.h"
+
+#include "Actor.h"
+#include "AeroEngine.h"
+#include "Engine.h"
+#include "ScrewProp.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fmt/format.h>
+
+using namespace Ogre;
+using namespace RoR;
+
+const char* InputReplay::SIGNATURE = "RoR/InputReplay";
+
+namespace {
+
+size_t PaddedLength(size_t len) { return (len + 3) & ~size_t(3); }
+
+template <typename T> void SyncValue(std::vector<float>& channels, size_t& i, bool apply, T& value)
+{
+    if (apply)
+    {
+        if (i < channels.size())
+        {
+            value = static_cast<T>(channels[i]);
+        }
+    }
+    else
+    {
+        if (i >= channels.size())
+        {
+            channels.resize(i + 1);
+        }
+        channels[i] = static_cast<float>(value);
+    }
+    ++i;
+}
+
+template <typename T> void SyncEnum(std::vector<float>& channels, size_t& i, bool apply, T& value)
+{
+    int tmp = static_cast<int>(value);
+    SyncValue(channels, i, apply, tmp);
+    value = static_cast<T>(tmp);
+}
+
+template <typename T> void AppendPod(std::vector<char>& buf, T value)
+{
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    buf.insert(buf.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T> T ReadPod(std::vector<char> const& buf, size_t& pos)
+{
+    T value;
+    std::memcpy(&value, &buf[pos], sizeof(T));
+    pos += sizeof(T);
+    return value;
+}
+
+} // namespace
+
+void InputReplay::SyncChannels(ActorPtr const& actor, bool apply)
+{
+    std::vector<float>& ch = m_channels;
+    size_t i = 0;
+
+    SyncEnum(ch, i, apply, actor->ar_state);
+
+    // Driver controls
+    SyncValue(ch, i, apply, actor->ar_hydro_dir_command);
+    bool speed_coupling = actor->ar_hydro_speed_coupling; // Bitfield
+    SyncValue(ch, i, apply, speed_coupling);
+    actor->ar_hydro_speed_coupling = speed_coupling;
+    SyncValue(ch, i, apply, actor->ar_brake);
+    SyncValue(ch, i, apply, actor->ar_parking_brake);
+    SyncValue(ch, i, apply, actor->ar_trailer_parking_brake);
+    SyncValue(ch, i, apply, actor->alb_mode);
+    SyncValue(ch, i, apply, actor->tc_mode);
+    SyncValue(ch, i, apply, actor->cc_mode);
+    SyncValue(ch, i, apply, actor->cc_target_speed);
+    SyncValue(ch, i, apply, actor->cc_target_rpm);
+    SyncValue(ch, i, apply, actor->ar_elevator);
+    SyncValue(ch, i, apply, actor->ar_rudder);
+    SyncValue(ch, i, apply, actor->ar_aileron);
+    SyncValue(ch, i, apply, actor->ar_aerial_flap);
+
+    // Command keys (1-MAX_COMMANDS)
+    for (int k = 1; k <= MAX_COMMANDS; k++)
+    {
+        SyncValue(ch, i, apply, actor->ar_command_key[k].playerInputValue);
+    }
+
+    // Propulsion
+    for (int k = 0; k < actor->ar_num_aeroengines; k++)
+    {
+        float throttle = actor->ar_aeroengines[k]->getThrottle();
+        SyncValue(ch, i, apply, throttle);
+        if (apply)
+            actor->ar_aeroengines[k]->setThrottle(throttle);
+    }
+    for (int k = 0; k < actor->ar_num_screwprops; k++)
+    {
+        float throttle = actor->ar_screwprops[k]->getThrottle();
+        float rudder = actor->ar_screwprops[k]->getRudder();
+        SyncValue(ch, i, apply, throttle);
+        SyncValue(ch, i, apply, rudder);
+        if (apply)
+        {
+            actor->ar_screwprops[k]->setThrottle(throttle);
+            actor->ar_screwprops[k]->setRudder(rudder);
+        }
+    }
+
+    // Engine and gearbox - also the shifting state, as main thread shifts gears directly.
+    if (actor->ar_engine)
+    {
+        Engine& engine = *actor->ar_engine;
+        SyncValue(ch, i, apply, engine.m_cur_acc);
+        SyncValue(ch, i, apply, engine.m_auto_cur_acc);
+        SyncValue(ch, i, apply, engine.m_cur_clutch);
+        SyncValue(ch, i, apply, engine.m_cur_gear);
+        SyncValue(ch, i, apply, engine.m_cur_gear_range);
+        SyncValue(ch, i, apply, engine.m_contact);
+        SyncValue(ch, i, apply, engine.m_starter);
+        SyncValue(ch, i, apply, engine.m_engine_is_running);
+        SyncEnum(ch, i, apply, engine.m_auto_mode);
+        SyncEnum(ch, i, apply, engine.m_autoselect);
+        SyncValue(ch, i, apply, engine.m_shifting);
+        SyncValue(ch, i, apply, engine.m_shift_val);
+        SyncValue(ch, i, apply, engine.m_shift_clock);
+        SyncValue(ch, i, apply, engine.m_post_shifting);
+        SyncValue(ch, i, apply, engine.m_post_shift_clock);
+    }
+}
+
+void InputReplay::CaptureInitialState(ActorPtr const& actor)
+{
+    m_actor_filename = actor->ar_filename;
+    m_actor_config = actor->getSectionConfig();
+    m_terrain_name = App::sim_terrain_name->getStr();
+    m_initial_origin = actor->ar_origin;
+    m_initial_sim_rng_state = actor->ar_sim_rng_state;
+
+    m_initial_nodes.resize(actor->ar_num_nodes);
+    for (int i = 0; i < actor->ar_num_nodes; i++)
+    {
+        m_initial_nodes[i].abs_position = actor->ar_nodes[i].AbsPosition;
+        m_initial_nodes[i].rel_position = actor->ar_nodes[i].RelPosition;
+        m_initial_nodes[i].velocity = actor->ar_nodes[i].Velocity;
+    }
+
+    this->SyncChannels(actor, /*apply:*/false);
+    m_initial_channels = m_channels;
+    m_prev_channels = m_channels;
+}
+
+void InputReplay::ApplyInitialState(ActorPtr const& actor)
+{
+    if (static_cast<int>(m_initial_nodes.size()) != actor->ar_num_nodes)
+    {
+        LOG(fmt::format("[RoR|InputReplay] Actor '{}' has {} nodes, recording has {}, stopping playback",
+            actor->ar_filename, actor->ar_num_nodes, m_initial_nodes.size()));
+        m_mode = Mode::STOPPED;
+        return;
+    }
+
+    actor->ar_origin = m_initial_origin;
+    actor->ar_sim_rng_state = m_initial_sim_rng_state;
+    for (int i = 0; i < actor->ar_num_nodes; i++)
+    {
+        actor->ar_nodes[i].AbsPosition = m_initial_nodes[i].abs_position;
+        actor->ar_nodes[i].RelPosition = m_initial_nodes[i].rel_position;
+        actor->ar_nodes[i].Velocity = m_initial_nodes[i].velocity;
+        actor->ar_nodes[i].Forces = Vector3::ZERO;
+    }
+    actor->updateSlideNodePositions();
+    actor->UpdateBoundingBoxes();
+    actor->calculateAveragePosition();
+    actor->GetGfxActor()->InvalidateSimNodeSnapshot();
+
+    m_channels = m_initial_channels;
+}
+
+void InputReplay::WriteFrame(int num_physics_steps)
+{
+    const size_t header_pos = m_frames.size();
+    AppendPod<uint16_t>(m_frames, static_cast<uint16_t>(num_physics_steps));
+    AppendPod<uint16_t>(m_frames, 0);
+
+    uint16_t num_changes = 0;
+    for (size_t i = 0; i < m_channels.size(); i++)
+    {
+        // Bitwise compare - channels only ever hold copied values, and NaN must count as unchanged.
+        if (i >= m_prev_channels.size() || std::memcmp(&m_channels[i], &m_prev_channels[i], sizeof(float)) != 0)
+        {
+            AppendPod<uint16_t>(m_frames, static_cast<uint16_t>(i));
+            AppendPod<float>(m_frames, m_channels[i]);
+            num_changes++;
+        }
+    }
+    std::memcpy(&m_frames[header_pos + sizeof(uint16_t)], &num_changes, sizeof(uint16_t));
+
+    m_prev_channels = m_channels;
+    m_num_frames++;
+}
+
+bool InputReplay::ReadFrame()
+{
+    const size_t CHANGE_SIZE = sizeof(uint16_t) + sizeof(float);
+    if (m_frame_pos + 2 * sizeof(uint16_t) > m_frames.size())
+    {
+        return false;
+    }
+    ReadPod<uint16_t>(m_frames, m_frame_pos); // num. physics steps, see `PeekNumPhysicsSteps()`
+    const uint16_t num_changes = ReadPod<uint16_t>(m_frames, m_frame_pos);
+    if (m_frame_pos + num_changes * CHANGE_SIZE > m_frames.size())
+    {
+        return false;
+    }
+    for (uint16_t i = 0; i < num_changes; i++)
+    {
+        const uint16_t channel = ReadPod<uint16_t>(m_frames, m_frame_pos);
+        const float value = ReadPod<float>(m_frames, m_frame_pos);
+        if (channel < m_channels.size())
+        {
+            m_channels[channel] = value;
+        }
+    }
+    m_frame_index++;
+    return true;
+}
+
+int InputReplay::PeekNumPhysicsSteps() const
+{
+    if (m_mode != Mode::PLAYBACK || m_frame_pos + sizeof(uint16_t) > m_frames.size())
+    {
+        return 0;
+    }
+    uint16_t num_steps;
+    std::memcpy(&num_steps, &m_frames[m_frame_pos], sizeof(uint16_t));
+    return num_steps;
+}
+
+void InputReplay::UpdateFrame(ActorPtr const& actor, int num_physics_steps)
+{
+    if (m_mode == Mode::RECORDING)
+    {
+        if (m_initial_nodes.empty())
+        {
+            this->CaptureInitialState(actor);
+        }
+        else
+        {
+            this->SyncChannels(actor, /*apply:*/false);
+        }
+        this->WriteFrame(num_physics_steps);
+    }
+    else if (m_mode == Mode::PLAYBACK)
+    {
+        if (m_frame_index == 0)
+        {
+            this->ApplyInitialState(actor);
+            if (m_mode != Mode::PLAYBACK)
+            {
+                return;
+            }
+        }
+
+        if (!this->ReadFrame())
+        {
+            LOG(fmt::format("[RoR|InputReplay] Recording of '{}' is damaged, stopping playback", actor->ar_filename));
+            m_mode = Mode::STOPPED;
+            return;
+        }
+        this->SyncChannels(actor, /*apply:*/true);
+
+        if (m_frame_index == m_num_frames)
+        {
+            LOG(fmt::format("[RoR|InputReplay] Playback of '{}' finished ({} frames)", actor->ar_filename, m_num_frames));
+            m_mode = Mode::STOPPED;
+        }
+    }
+}
+
+void InputReplay::Interrupt()
+{
+    if ((m_mode == Mode::RECORDING && m_num_frames == 0) || (m_mode == Mode::PLAYBACK && m_frame_index == 0))
+    {
+        return; // Positioning the freshly spawned actor - the initial state is taken/applied on first frame.
+    }
+
+    if (m_mode == Mode::RECORDING)
+    {
+        LOG(fmt::format("[RoR|InputReplay] Actor '{}' was reset or moved, recording ends after {} frames", m_actor_filename, m_num_frames));
+    }
+    else if (m_mode == Mode::PLAYBACK)
+    {
+        LOG(fmt::format("[RoR|InputReplay] Actor '{}' was reset or moved, playback stopped", m_actor_filename));
+    }
+    m_mode = Mode::STOPPED;
+}
+
+InputReplay::ResultCode InputReplay::SaveFile(std::string const& filename) const
+{
+    if (m_num_frames == 0)
+    {
+        return RESULT_CODE_ERR_NOTHING_RECORDED;
+    }
+
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return RESULT_CODE_ERR_FOPEN_FAILED;
+    }
+
+    const std::string* strings[] = { &m_actor_filename, &m_actor_config, &m_terrain_name };
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(FileHeader));
+    std::strncpy(header.signature, SIGNATURE, sizeof(header.signature));
+    header.file_format_version = FILE_FORMAT_VERSION;
+    header.num_nodes = static_cast<uint32_t>(m_initial_nodes.size());
+    header.num_channels = static_cast<uint32_t>(m_initial_channels.size());
+    header.num_frames = static_cast<uint32_t>(m_num_frames);
+    header.frames_size = static_cast<uint32_t>(m_frames.size());
+    header.sim_rng_state = m_initial_sim_rng_state;
+    for (int i = 0; i < 3; i++)
+    {
+        header.origin[i] = m_initial_origin[i];
+        header.strings_len[i] = static_cast<uint32_t>(strings[i]->size());
+    }
+
+    const char padding[4] = {};
+    bool ok = fwrite(&header, sizeof(FileHeader), 1, file) == 1;
+    for (const std::string* str: strings)
+    {
+        const size_t pad_len = PaddedLength(str->size()) - str->size();
+        ok = ok && fwrite(str->data(), 1, str->size(), file) == str->size();
+        ok = ok && fwrite(padding, 1, pad_len, file) == pad_len;
+    }
+    ok = ok && fwrite(m_initial_nodes.data(), sizeof(NodeState), m_initial_nodes.size(), file) == m_initial_nodes.size();
+    ok = ok && fwrite(m_initial_channels.data(), sizeof(float), m_initial_channels.size(), file) == m_initial_channels.size();
+    ok = ok && fwrite(m_frames.data(), 1, m_frames.size(), file) == m_frames.size();
+
+    fclose(file);
+    if (!ok)
+    {
+        std::remove(filename.c_str()); // Don't leave a half-written file behind.
+        return RESULT_CODE_FWRITE_OUTPUT_INCOMPLETE;
+    }
+    return RESULT_CODE_OK;
+}
+
+InputReplay::ResultCode InputReplay::LoadFile(std::string const& filename)
+{
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (file == nullptr)
+    {
+        return RESULT_CODE_ERR_FOPEN_FAILED;
+    }
+
+    FileHeader header;
+    if (fread(&header, sizeof(FileHeader), 1, file) != 1)
+    {
+        fclose(file);
+        return RESULT_CODE_ERR_FILE_TRUNCATED;
+    }
+    if (std::strncmp(header.signature, SIGNATURE, sizeof(header.signature)) != 0)
+    {
+        fclose(file);
+        return RESULT_CODE_ERR_SIGNATURE_MISMATCH;
+    }
+    if (header.file_format_version != FILE_FORMAT_VERSION)
+    {
+        fclose(file);
+        return RESULT_CODE_ERR_VERSION_MISMATCH;
+    }
+
+    // Validate the sizes against the file before allocating anything; 64-bit math so bogus values can't wrap around.
+    uint64_t expected_size = sizeof(FileHeader);
+    for (int i = 0; i < 3; i++)
+    {
+        expected_size += (static_cast<uint64_t>(header.strings_len[i]) + 3) & ~uint64_t(3);
+    }
+    expected_size += static_cast<uint64_t>(header.num_nodes) * sizeof(NodeState);
+    expected_size += static_cast<uint64_t>(header.num_channels) * sizeof(float);
+    expected_size += header.frames_size;
+    long file_size = -1;
+    if (fseek(file, 0, SEEK_END) == 0)
+    {
+        file_size = ftell(file);
+    }
+    if (file_size < 0 || expected_size > static_cast<uint64_t>(file_size)
+        || fseek(file, sizeof(FileHeader), SEEK_SET) != 0)
+    {
+        fclose(file);
+        return RESULT_CODE_ERR_FILE_TRUNCATED;
+    }
+
+    bool ok = true;
+    std::string* strings[] = { &m_actor_filename, &m_actor_config, &m_terrain_name };
+    for (int i = 0; i < 3; i++)
+    {
+        std::vector<char> buf(PaddedLength(header.strings_len[i]));
+        ok = ok && fread(buf.data(), 1, buf.size(), file) == buf.size();
+        strings[i]->assign(buf.data(), ok ? header.strings_len[i] : 0);
+    }
+
+    m_initial_nodes.resize(header.num_nodes);
+    m_initial_channels.resize(header.num_channels);
+    m_frames.resize(header.frames_size);
+    ok = ok && fread(m_initial_nodes.data(), sizeof(NodeState), m_initial_nodes.size(), file) == m_initial_nodes.size();
+    ok = ok && fread(m_initial_channels.data(), sizeof(float), m_initial_channels.size(), file) == m_initial_channels.size();
+    ok = ok && fread(m_frames.data(), 1, m_frames.size(), file) == m_frames.size();
+    fclose(file);
+    if (!ok)
+    {
+        return RESULT_CODE_ERR_FILE_TRUNCATED;
+    }
+
+    m_initial_origin = Vector3(header.origin[0], header.origin[1], header.origin[2]);
+    m_initial_sim_rng_state = header.sim_rng_state;
+    m_num_frames = header.num_frames;
+    m_frame_pos = 0;
+    m_frame_index = 0;
+    m_channels = m_initial_channels;
+    m_mode = Mode::PLAYBACK;
+    return RESULT_CODE_OK;
+}
@@ -0,0 +1,130 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "Application.h"
+
+#include <Ogre.h>
+#include <string>
+#include <vector>
+
+namespace RoR {
+
+/// @addtogroup Gameplay
+/// @{
+
+/// Deterministic replay of a single actor: the initial node state + for each sim frame, the number of physics steps
+/// and the control state (driver inputs, command keys, engine/gearbox) as left by main thread right before the physics runs.
+/// Compared to `Replay` (node positions at fixed intervals) it's tiny, but it must be re-simulated to be watched -
+/// and the result only matches with `sim_deterministic` on, on the same terrain, without interaction with other actors.
+/// Recording starts with the actor (see `ActorManager::CreateNewActor()`); teleports/resets end it, see `Interrupt()`.
+class InputReplay
+{
+public:
+    enum class Mode
+    {
+        RECORDING,
+        PLAYBACK,
+        STOPPED
+    };
+
+    enum ResultCode
+    {
+        RESULT_CODE_OK,
+        RESULT_CODE_ERR_FOPEN_FAILED,
+        RESULT_CODE_ERR_SIGNATURE_MISMATCH,
+        RESULT_CODE_ERR_VERSION_MISMATCH,
+        RESULT_CODE_ERR_FILE_TRUNCATED,
+        RESULT_CODE_ERR_NOTHING_RECORDED,
+        RESULT_CODE_FWRITE_OUTPUT_INCOMPLETE
+    };
+
+    static const char*        SIGNATURE;
+    static const unsigned int FILE_FORMAT_VERSION = 1;
+
+    InputReplay() {} //!< Starts in recording mode; the initial state is captured on first `UpdateFrame()`.
+
+    ResultCode  SaveFile(std::string const& filename) const;
+    ResultCode  LoadFile(std::string const& filename); //!< Switches to playback mode; spawn an actor from `GetActorFilename()` to play it.
+
+    /// To be invoked on main thread for each sim frame, just before the physics task is launched.
+    void        UpdateFrame(ActorPtr const& actor, int num_physics_steps);
+    int         PeekNumPhysicsSteps() const; //!< Playback: time steps of the next frame; the framerate of the recording is reproduced.
+    void        Interrupt(); //!< The actor was moved or reset outside the recorded controls; stop.
+
+    Mode        GetMode() const                    { return m_mode; }
+    bool        IsPlaying() const                  { return m_mode == Mode::PLAYBACK; }
+    size_t      GetNumFrames() const               { return m_num_frames; }
+    size_t      GetDataSize() const                { return m_frames.size(); }
+    std::string const& GetActorFilename() const    { return m_actor_filename; }
+    std::string const& GetActorConfig() const      { return m_actor_config; }
+    std::string const& GetTerrainName() const      { return m_terrain_name; }
+    Ogre::Vector3 GetInitialPosition() const       { return (m_initial_nodes.empty()) ? Ogre::Vector3::ZERO : m_initial_nodes[0].abs_position; }
+
+private:
+    struct NodeState
+    {
+        Ogre::Vector3 abs_position;
+        Ogre::Vector3 rel_position;
+        Ogre::Vector3 velocity;
+    };
+
+    struct FileHeader
+    {
+        char     signature[16];
+        uint32_t file_format_version;
+        uint32_t num_nodes;
+        uint32_t num_channels;
+        uint32_t num_frames;
+        uint32_t frames_size;     //!< In bytes
+        int32_t  sim_rng_state;
+        float    origin[3];
+        uint32_t strings_len[3];  //!< Actor filename, actor config, terrain name; each padded to 4 bytes
+    };
+
+    void        CaptureInitialState(ActorPtr const& actor);
+    void        ApplyInitialState(ActorPtr const& actor);
+    void        SyncChannels(ActorPtr const& actor, bool apply); //!< Copies the control state between actor and `m_channels`.
+    void        WriteFrame(int num_physics_steps);
+    bool        ReadFrame(); //!< False if the data ran out.
+
+    Mode                       m_mode = Mode::RECORDING;
+
+    // Initial state
+    std::string                m_actor_filename;
+    std::string                m_actor_config;
+    std::string                m_terrain_name;
+    std::vector<NodeState>     m_initial_nodes;
+    Ogre::Vector3              m_initial_origin = Ogre::Vector3::ZERO;
+    std::vector<float>         m_initial_channels;
+    int                        m_initial_sim_rng_state = 0;
+
+    // Per frame: uint16 num. physics steps, uint16 num. changed channels, {uint16 channel, float value} per change.
+    std::vector<char>          m_frames;
+    size_t                     m_num_frames = 0;
+    size_t                     m_frame_pos = 0;         //!< Playback: read offset into `m_frames`
+    size_t                     m_frame_index = 0;       //!< Playback: frames played so far
+    std::vector<float>         m_channels;              //!< Current control state
+    std::vector<float>         m_prev_channels;         //!< Recording: state written with the last frame
+};
+
+/// @} // addtogroup Gameplay
+
+} // namespace RoR
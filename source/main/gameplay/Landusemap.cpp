@@ -27,19 +27,28 @@
 #include "ErrorUtils.h"
 #include "GameContext.h"
 #include "Language.h"
+#include "PlatformUtils.h"
 #include "Terrain.h"
+#include "Utils.h"
 #ifdef USE_PAGED
 #include "PropertyMaps.h"
 #include "PagedGeometry.h"
 #endif
 #include <OgreConfigFile.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
 using namespace Ogre;
 using namespace RoR;
 
+const char* Landusemap::CACHE_SIGNATURE = "RoR/LanduseCache";
+
+static size_t PaddedLength(size_t len) { return (len + 3) & ~size_t(3); }
+
 Landusemap::Landusemap(String configFilename) :
-    data(0)
-    , default_ground_model(nullptr)
+    default_ground_model(nullptr)
     , mapsize(App::GetGameContext()->GetTerrain()->getMaxTerrainSize())
 {
     loadConfig(configFilename);
@@ -50,28 +59,23 @@ Landusemap::Landusemap(String configFilename) :
 
 Landusemap::~Landusemap()
 {
-    if (data != nullptr)
-        delete[] data;
 }
 
 ground_model_t* Landusemap::getGroundModelAt(int x, int z)
 {
-    if (!data)
+    if (m_raster_data == nullptr)
         return nullptr;
-#ifdef USE_PAGED
+
     // we return the default ground model if we are not anymore in this map
-    if (x < 0 || x >= mapsize.x || z < 0 || z >= mapsize.z)
+    if (x < 0 || x >= m_raster_width || z < 0 || z >= m_raster_height)
         return default_ground_model;
 
-    return data[x + z * (int)mapsize.x];
-#else
-    return nullptr;
-#endif // USE_PAGED
+    return m_palette[m_raster_data[x + z * m_raster_width]];
 }
 
 int Landusemap::loadConfig(const Ogre::String& filename)
 {
-    std::map<unsigned int, String> usemap;
+    UseMap usemap;
     String textureFilename = "";
 
     LOG("Parsing landuse config: '"+filename+"'");
@@ -138,32 +142,73 @@ int Landusemap::loadConfig(const Ogre::String& filename)
         }
     }
 #ifdef USE_PAGED
-    // process the config data and load the buffers finally
-    try
+    m_raster_width = static_cast<int>(mapsize.x);
+    m_raster_height = static_cast<int>(mapsize.z);
+
+    const std::string cache_key = this->makeCacheKey(textureFilename, usemap);
+    const std::string cache_filename = PathCombine(App::sys_cache_dir->getStr(), fmt::format("landuse_{}.dat", Sha1Hash(cache_key)));
+    if (this->loadCache(cache_filename, cache_key))
     {
-        Forests::ColorMap* colourMap = Forests::ColorMap::load(textureFilename, Forests::CHANNEL_COLOR);
-        colourMap->setFilter(Forests::MAPFILTER_NONE);
+        LOG("[RoR|Physics] Landuse: loaded from cache '" + cache_filename + "'");
+    }
+    else if (this->decodeTexture(textureFilename, usemap) && !cache_key.empty())
+    {
+        this->saveCache(cache_filename, cache_key);
+    }
 
-        /*
-        // debug things below
-        printf("found ground use definitions:\n");
-        for (std::map < uint32, String >::iterator it=usemap.begin(); it!=usemap.end(); it++)
+    // Resolve the names now - ground models may come from this very config, see 'frictionconfig'
+    m_palette.clear();
+    for (std::string const& name : m_palette_names)
+    {
+        m_palette.push_back(App::GetGameContext()->GetTerrain()->GetCollisions()->getGroundModelByString(name));
+    }
+#endif // USE_PAGED
+    return 0;
+}
+
+bool Landusemap::decodeTexture(Ogre::String const& texture_filename, UseMap const& usemap)
+{
+#ifdef USE_PAGED
+    // One palette entry per ground model, however many colors map to it.
+    m_palette_names.assign(1, "");
+    std::map<unsigned int, uint8_t> index_by_color;
+    for (auto& entry : usemap)
+    {
+        auto name_itor = std::find(m_palette_names.begin(), m_palette_names.end(), entry.second);
+        if (name_itor == m_palette_names.end())
         {
-            printf(" 0x%Lx : %s\n", it->first, it->second.c_str());
+            if (m_palette_names.size() > UINT8_MAX)
+            {
+                LOG("[RoR|Physics] Landuse: too many ground models in use-map, ignoring '" + entry.second + "'");
+                continue;
+            }
+            m_palette_names.push_back(entry.second);
+            name_itor = m_palette_names.end() - 1;
         }
-        */
+        index_by_color[entry.first] = static_cast<uint8_t>(name_itor - m_palette_names.begin());
+    }
+    auto lookup_color = [&index_by_color](unsigned int col) -> uint8_t
+    {
+        auto itor = index_by_color.find(col);
+        return (itor != index_by_color.end()) ? itor->second : 0;
+    };
+
+    try
+    {
+        Forests::ColorMap* colourMap = Forests::ColorMap::load(texture_filename, Forests::CHANNEL_COLOR);
+        colourMap->setFilter(Forests::MAPFILTER_NONE);
 
         bool bgr = colourMap->getPixelBox().format == PF_A8B8G8R8;
 
         Ogre::TRect<Ogre::Real> bounds = Forests::TBounds(0, 0, mapsize.x, mapsize.z);
 
-        // now allocate the data buffer to hold pointers to ground models
-        data = new ground_model_t*[(int)(mapsize.x * mapsize.z)];
-        ground_model_t** ptr = data;
-        //std::map < String, int > counters;
-        for (int z = 0; z < mapsize.z; z++)
+        m_raster.resize(static_cast<size_t>(m_raster_width) * m_raster_height);
+        uint8_t* ptr = m_raster.data();
+        unsigned int last_col = 0;
+        uint8_t last_index = lookup_color(last_col);
+        for (int z = 0; z < m_raster_height; z++)
         {
-            for (int x = 0; x < mapsize.x; x++)
+            for (int x = 0; x < m_raster_width; x++)
             {
                 unsigned int col = colourMap->getColorAt(x, z, bounds);
                 if (bgr)
@@ -174,30 +219,155 @@ int Landusemap::loadConfig(const Ogre::String& filename)
                     cols |= (col & 0xFF0000) >> 16;
                     col = cols;
                 }
-                String use = usemap[col];
-                //if (use!="")
-                //	counters[use]++;
 
-                // store the pointer to the ground model in the data slot
-                *ptr = App::GetGameContext()->GetTerrain()->GetCollisions()->getGroundModelByString(use);
-                ptr++;
+                // Neighbouring pixels mostly have the same color
+                if (col != last_col)
+                {
+                    last_col = col;
+                    last_index = lookup_color(col);
+                }
+                *ptr++ = last_index;
             }
         }
+        m_raster_data = m_raster.data();
+        return true;
     }
     catch (Ogre::Exception& oex)
     {
         LogFormat("[RoR|Physics] Landuse: failed to load texture '%s', <Ogre::Exception> message: '%s'",
-            textureFilename.c_str(), oex.getFullDescription().c_str());
+            texture_filename.c_str(), oex.getFullDescription().c_str());
     }
     catch (std::exception& stex)
     {
         LogFormat("[RoR|Physics] Landuse: failed to load texture '%s', <std::exception> message: '%s'",
-            textureFilename.c_str(), stex.what());
+            texture_filename.c_str(), stex.what());
     }
     catch (...)
     {
-        LogFormat("[RoR|Physics] Landuse: failed to load texture '%s', unknown error", textureFilename.c_str());
+        LogFormat("[RoR|Physics] Landuse: failed to load texture '%s', unknown error", texture_filename.c_str());
     }
 #endif // USE_PAGED
-    return 0;
+    m_raster.clear();
+    m_raster_data = nullptr;
+    return false;
+}
+
+std::string Landusemap::makeCacheKey(Ogre::String const& texture_filename, UseMap const& usemap)
+{
+    std::string texture_data;
+    try
+    {
+        DataStreamPtr stream = ResourceGroupManager::getSingleton().openResource(texture_filename, ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+        texture_data = stream->getAsString();
+    }
+    catch (...)
+    {
+        return ""; // Don't cache; `decodeTexture()` reports the error
+    }
+
+    std::string key = fmt::format("{}|{}|{}x{}", texture_filename, Sha1Hash(texture_data), m_raster_width, m_raster_height);
+    for (auto& entry : usemap)
+    {
+        key += fmt::format("|{:08x}={}", entry.first, entry.second);
+    }
+    return key;
+}
+
+bool Landusemap::loadCache(std::string const& filename, std::string const& key)
+{
+    if (key.empty() || !m_cache_file.Open(filename))
+        return false;
+
+    const char* data = m_cache_file.GetData();
+    const size_t size = m_cache_file.GetSize();
+    const size_t raster_size = static_cast<size_t>(m_raster_width) * m_raster_height;
+
+    CacheFileHeader header;
+    bool ok = size >= sizeof(CacheFileHeader);
+    if (ok)
+    {
+        std::memcpy(&header, data, sizeof(CacheFileHeader));
+        ok = std::strncmp(header.signature, CACHE_SIGNATURE, sizeof(header.signature)) == 0
+            && header.file_format_version == CACHE_FILE_FORMAT_VERSION
+            && header.key_len == key.size()
+            && header.palette_len >= 1 && header.palette_len <= UINT8_MAX + 1
+            && header.raster_width == static_cast<uint32_t>(m_raster_width)
+            && header.raster_height == static_cast<uint32_t>(m_raster_height);
+    }
+
+    // Key and palette
+    const size_t strings_size = ok ? PaddedLength(static_cast<size_t>(header.key_len) + header.palette_names_size) : 0;
+    ok = ok && sizeof(CacheFileHeader) + strings_size + raster_size <= size
+        && key.compare(0, key.size(), data + sizeof(CacheFileHeader), header.key_len) == 0;
+    m_palette_names.clear();
+    if (ok)
+    {
+        const char* pos = data + sizeof(CacheFileHeader) + header.key_len;
+        const char* end = pos + header.palette_names_size;
+        while (pos < end && m_palette_names.size() < header.palette_len)
+        {
+            const char* name_end = std::find(pos, end, '\0');
+            m_palette_names.push_back(std::string(pos, name_end));
+            pos = name_end + 1;
+        }
+        ok = m_palette_names.size() == header.palette_len;
+    }
+
+    // Raster - used straight from the mapping, the offset is 4-byte aligned
+    if (ok)
+    {
+        const uint8_t* raster = reinterpret_cast<const uint8_t*>(data + sizeof(CacheFileHeader) + strings_size);
+        ok = raster_size == 0 || *std::max_element(raster, raster + raster_size) < header.palette_len;
+        m_raster_data = raster;
+    }
+
+    if (!ok)
+    {
+        m_raster_data = nullptr;
+        m_palette_names.clear();
+        m_cache_file.Close();
+    }
+    return ok;
+}
+
+void Landusemap::saveCache(std::string const& filename, std::string const& key)
+{
+    std::string palette_names;
+    for (std::string const& name : m_palette_names)
+    {
+        palette_names += name;
+        palette_names += '\0';
+    }
+
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (file == nullptr)
+    {
+        LOG("[RoR|Physics] Landuse: could not write cache file '" + filename + "'");
+        return;
+    }
+
+    CacheFileHeader header;
+    std::memset(&header, 0, sizeof(CacheFileHeader));
+    std::strncpy(header.signature, CACHE_SIGNATURE, sizeof(header.signature));
+    header.file_format_version = CACHE_FILE_FORMAT_VERSION;
+    header.key_len = static_cast<uint32_t>(key.size());
+    header.palette_len = static_cast<uint32_t>(m_palette_names.size());
+    header.palette_names_size = static_cast<uint32_t>(palette_names.size());
+    header.raster_width = static_cast<uint32_t>(m_raster_width);
+    header.raster_height = static_cast<uint32_t>(m_raster_height);
+
+    const char padding[4] = {};
+    const size_t padding_len = PaddedLength(key.size() + palette_names.size()) - (key.size() + palette_names.size());
+    bool ok = fwrite(&header, sizeof(CacheFileHeader), 1, file) == 1;
+    ok = ok && fwrite(key.data(), 1, key.size(), file) == key.size();
+    ok = ok && fwrite(palette_names.data(), 1, palette_names.size(), file) == palette_names.size();
+    ok = ok && fwrite(padding, 1, padding_len, file) == padding_len;
+    ok = ok && fwrite(m_raster.data(), 1, m_raster.size(), file) == m_raster.size();
+
+    fclose(file);
+    if (!ok)
+    {
+        std::remove(filename.c_str()); // Don't leave a half-written file behind.
+        LOG("[RoR|Physics] Landuse: could not write cache file '" + filename + "'");
+    }
 }
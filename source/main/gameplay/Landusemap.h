@@ -23,17 +23,29 @@
 #pragma once
 
 #include "Application.h"
+#include "PlatformUtils.h"
 #include "SimData.h"
 
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
 namespace RoR {
 
 /// @addtogroup Terrain
 /// @{
 
+/// Ground model per square meter of terrain, decoded from a color-coded texture (see 'use-map' section of the config).
+/// Stored as a 1-byte palette index per meter; the decoded raster is cached in the cache dir,
+/// keyed by the texture contents, the color mapping and the map size, so later loads skip decoding the texture.
 class Landusemap
 {
 public:
 
+    static const char*        CACHE_SIGNATURE;
+    static const unsigned int CACHE_FILE_FORMAT_VERSION = 1;
+
     Landusemap(Ogre::String cfgfilename);
     ~Landusemap();
 
@@ -42,7 +54,31 @@ public:
 
 protected:
 
-    ground_model_t** data;
+    struct CacheFileHeader
+    {
+        char     signature[16];
+        uint32_t file_format_version;
+        uint32_t key_len;            //!< Followed by the key, then palette names (each NUL-terminated), padded to 4 bytes, then the raster
+        uint32_t palette_len;        //!< Number of names
+        uint32_t palette_names_size; //!< In bytes, without padding
+        uint32_t raster_width;
+        uint32_t raster_height;
+    };
+
+    typedef std::map<unsigned int, Ogre::String> UseMap; //!< Color (ARGB) => ground model name
+
+    bool decodeTexture(Ogre::String const& texture_filename, UseMap const& usemap); //!< Fills palette + raster
+    bool loadCache(std::string const& filename, std::string const& key);
+    void saveCache(std::string const& filename, std::string const& key);
+    std::string makeCacheKey(Ogre::String const& texture_filename, UseMap const& usemap);
+
+    std::vector<uint8_t>     m_raster;               //!< Decoded from the texture; unused when loaded from cache
+    MappedFile               m_cache_file;           //!< Holds the raster when loaded from cache
+    const uint8_t*           m_raster_data = nullptr; //!< Offset to `m_palette` per square meter, row-major; points to `m_raster` or `m_cache_file`
+    std::vector<std::string> m_palette_names;        //!< Index 0 = color missing in use-map; name is empty
+    std::vector<ground_model_t*> m_palette;          //!< Resolved `m_palette_names`; null if not found
+    int                      m_raster_width = 0;     //!< Meters
+    int                      m_raster_height = 0;    //!< Meters
     ground_model_t* default_ground_model;
 
     Ogre::Vector3 mapsize;
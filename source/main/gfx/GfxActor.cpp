@@ -43,6 +43,7 @@
 #include "MovableText.h"
 #include "OgreImGui.h"
 #include "Renderdash.h" // classic 'renderdash' material
+#include "RodBatch.h"
 #include "RoRnet.h"
 #include "ActorSpawner.h"
 #include "SlideNode.h"
@@ -110,12 +111,13 @@ RoR::GfxActor::~GfxActor()
     {
         try
         {
-            for (BeamGfx& rod: m_gfx_beams)
+            if (m_rods_task)
             {
-                Ogre::MovableObject* ogre_object = rod.rod_scenenode->getAttachedObject(0);
-                rod.rod_scenenode->detachAllObjects();
-                App::GetGfxScene()->GetSceneManager()->destroyEntity(static_cast<Ogre::Entity*>(ogre_object));
+                m_rods_task->join();
+                m_rods_task.reset();
             }
+            delete m_rod_batch;
+            m_rod_batch = nullptr;
             m_gfx_beams.clear();
 
             m_gfx_beams_parent_scenenode->removeAndDestroyAllChildren();
@@ -1676,27 +1678,68 @@ void RoR::GfxActor::CycleDebugViews()
 
 void RoR::GfxActor::UpdateRods()
 {
-    for (BeamGfx& rod: m_gfx_beams)
+    m_rods_task.reset();
+
+    // Skip if there are no rods or they're hidden (see `SetRodsVisible()`)
+    if (m_gfx_beams.empty() || !m_gfx_beams_parent_scenenode->isInSceneGraph())
+        return;
+
+    if (m_rod_batch == nullptr)
+    {
+        std::vector<std::string> rod_materials;
+        rod_materials.reserve(m_gfx_beams.size());
+        for (BeamGfx& rod: m_gfx_beams)
+        {
+            rod_materials.push_back(rod.rod_material_name);
+        }
+
+        try
+        {
+            m_rod_batch = new RodBatch(fmt::format("RodBatch-{}", m_actor->ar_instance_id), this->GetResourceGroup(), rod_materials, m_gfx_beams_parent_scenenode);
+        }
+        catch (...)
+        {
+            HandleGenericException(WhereFrom(this, "creating beam visuals"), HANDLEGENERICEXCEPTION_LOGFILE);
+            m_gfx_beams.clear(); // Don't retry every frame
+            return;
+        }
+    }
+
+    m_rods_task = App::GetThreadPool()->RunTask([this]{ this->GenerateRodVertices(); });
+}
+
+void RoR::GfxActor::GenerateRodVertices()
+{
+    NodeSB* nodes1 = this->GetSimNodeBuffer();
+    m_rod_batch->BeginUpdate(nodes1[0].AbsPosition);
+
+    for (size_t i = 0; i < m_gfx_beams.size(); ++i)
     {
-        rod.rod_scenenode->setVisible(rod.rod_is_visible);
+        const BeamGfx& rod = m_gfx_beams[i];
         if (!rod.rod_is_visible)
+        {
+            m_rod_batch->HideRod(i);
             continue;
+        }
 
-        NodeSB* nodes1 = this->GetSimNodeBuffer();
         Ogre::Vector3 pos1 = nodes1[rod.rod_node1].AbsPosition;
         NodeSB* nodes2 = rod.rod_target_actor->GetGfxActor()->GetSimNodeBuffer();
         Ogre::Vector3 pos2 = nodes2[rod.rod_node2].AbsPosition;
 
-        // Classic method
-        float beam_diameter = rod.rod_diameter;
-        float beam_length = pos1.distance(pos2);
-
-        rod.rod_scenenode->setPosition(pos1.midPoint(pos2));
-        rod.rod_scenenode->setScale(beam_diameter, beam_length, beam_diameter);
-        rod.rod_scenenode->setOrientation(GfxScene::SpecialGetRotationTo(Ogre::Vector3::UNIT_Y, (pos1 - pos2)));
+        m_rod_batch->SetRod(i, pos1, pos2, rod.rod_diameter);
     }
 }
 
+void RoR::GfxActor::FinishRodUpdates()
+{
+    if (!m_rods_task)
+        return;
+
+    m_rods_task->join();
+    m_rods_task.reset();
+    m_rod_batch->UploadVertices();
+}
+
 void RoR::GfxActor::ScaleActor(Ogre::Vector3 relpos, float ratio)
 {
     for (BeamGfx& rod: m_gfx_beams)
@@ -1758,6 +1801,21 @@ void RoR::GfxActor::SetRodsVisible(bool visible)
     }
 }
 
+void RoR::GfxActor::WriteSimNodeSnapshot()
+{
+    // Runs on sim thread while main thread may be reading `m_simbuf` - only touch the back buffer.
+    m_simbuf_nodes_back.resize(m_actor->ar_num_nodes); // No-op after the first time
+    const node_t* nodes = m_actor->ar_nodes;
+    NodeSB* dst = m_simbuf_nodes_back.data();
+    for (int i = 0; i < m_actor->ar_num_nodes; ++i)
+    {
+        dst[i].AbsPosition = nodes[i].AbsPosition;
+        dst[i].nd_has_contact = nodes[i].nd_has_ground_contact || nodes[i].nd_has_mesh_contact;
+        dst[i].nd_is_wet = false; // Filled from `m_gfx_nodes` on main thread
+    }
+    m_simbuf_nodes_back_valid = true;
+}
+
 void RoR::GfxActor::UpdateSimDataBuffer()
 {
     // PLEASE maintain the same order as in `struct ActorSB`
@@ -1785,12 +1843,23 @@ void RoR::GfxActor::UpdateSimDataBuffer()
     }
 
     // Elements: nodes
-    m_simbuf.simbuf_nodes.resize(m_actor->ar_num_nodes);
-    for (int i = 0; i < m_actor->ar_num_nodes; ++i)
+    if (m_simbuf_nodes_back_valid && m_simbuf_nodes_back.size() == (size_t)m_actor->ar_num_nodes)
     {
-        auto node = m_actor->ar_nodes[i];
-        m_simbuf.simbuf_nodes[i].AbsPosition = node.AbsPosition;
-        m_simbuf.simbuf_nodes[i].nd_has_contact = node.nd_has_ground_contact || node.nd_has_mesh_contact;
+        // Snapshot was already taken on sim thread, see `WriteSimNodeSnapshot()` - just flip the buffers.
+        std::swap(m_simbuf.simbuf_nodes, m_simbuf_nodes_back);
+        m_simbuf_nodes_back_valid = false;
+    }
+    else
+    {
+        m_simbuf.simbuf_nodes.resize(m_actor->ar_num_nodes);
+        const node_t* nodes = m_actor->ar_nodes;
+        NodeSB* dst = m_simbuf.simbuf_nodes.data();
+        for (int i = 0; i < m_actor->ar_num_nodes; ++i)
+        {
+            dst[i].AbsPosition = nodes[i].AbsPosition;
+            dst[i].nd_has_contact = nodes[i].nd_has_ground_contact || nodes[i].nd_has_mesh_contact;
+            dst[i].nd_is_wet = false;
+        }
     }
 
     for (NodeGfx& nx: m_gfx_nodes)
@@ -1944,8 +2013,6 @@ void RoR::GfxActor::UpdateCabMesh()
 
 void RoR::GfxActor::UpdateWheelVisuals()
 {
-    m_flexwheel_tasks.clear();
-
     for (WheelGfx& w: m_wheels)
     {
         if (w.wx_flex_mesh != nullptr && w.wx_flex_mesh->flexitPrepare())
@@ -1954,18 +2021,14 @@ void RoR::GfxActor::UpdateWheelVisuals()
                 {
                     w.wx_flex_mesh->flexitCompute();
                 });
-            auto task_handle = App::GetThreadPool()->RunTask(func);
-            m_flexwheel_tasks.push_back(task_handle);
+            App::GetThreadPool()->RunTask(m_flexwheel_tasks, func);
         }
     }
 }
 
 void RoR::GfxActor::FinishWheelUpdates()
 {
-    for (auto& task: m_flexwheel_tasks)
-    {
-        task->join();
-    }
+    App::GetThreadPool()->WaitForGroup(m_flexwheel_tasks);
     for (WheelGfx& w: m_wheels)
     {
         if (w.wx_scenenode != nullptr && w.wx_flex_mesh != nullptr)
@@ -3175,9 +3238,34 @@ void RoR::GfxActor::SortFlexbodies()
     std::sort(m_flexbodies.begin(), m_flexbodies.end(), [](FlexBody* a, FlexBody* b) { return a->getVertexCount() > b->getVertexCount(); });
 }
 
+int RoR::GfxActor::CalcFlexbodyUpdateInterval()
+{
+    // Full rate while the actor covers at least this fraction of screen height
+    const float FULL_RATE_SCREEN_RATIO = 0.25f;
+
+    const int max_interval = App::flexbody_lod_max_interval->getInt();
+    if (max_interval <= 1 || m_simbuf.simbuf_aabb.isNull() || m_simbuf.simbuf_aabb.isInfinite())
+        return 1;
+
+    Ogre::Camera* camera = App::GetCameraManager()->GetCamera();
+    const float radius = m_simbuf.simbuf_aabb.getHalfSize().length();
+    const float distance = m_simbuf.simbuf_aabb.getCenter().distance(App::GetCameraManager()->GetCameraNode()->getPosition());
+    if (distance <= radius)
+        return 1;
+
+    const float screen_ratio = radius / (distance * Ogre::Math::Tan(camera->getFOVy() * 0.5f));
+    if (screen_ratio >= FULL_RATE_SCREEN_RATIO)
+        return 1;
+
+    return std::min(max_interval, static_cast<int>(FULL_RATE_SCREEN_RATIO / screen_ratio));
+}
+
 void RoR::GfxActor::UpdateFlexbodies()
 {
-    m_flexbody_tasks.clear();
+    // Small/distant actors are updated every N-th frame; the instance ID spreads them across frames
+    const int lod_interval = this->CalcFlexbodyUpdateInterval();
+    const bool lod_update = ((m_flexbody_lod_counter++ + m_actor->ar_instance_id) % lod_interval) == 0;
+    const float still_epsilon = App::flexbody_still_epsilon->getFloat();
 
     for (FlexBody* fb: m_flexbodies)
     {
@@ -3185,15 +3273,20 @@ void RoR::GfxActor::UpdateFlexbodies()
         const bool visible = (fb->fb_camera_mode_active == CAMERA_MODE_ALWAYS_VISIBLE || fb->fb_camera_mode_active == m_simbuf.simbuf_cur_cinecam);
         fb->setVisible(visible);
 
-        // Update visible on background thread
-        if (fb->isVisible())
+        // Update visible on background thread, unless the nodes didn't move
+        if (fb->isVisible() && fb->hasMovedSinceLastCompute(still_epsilon))
         {
+            if (!lod_update)
+            {
+                fb->followFlexitCenter();
+                continue;
+            }
+
             auto func = std::function<void()>([fb]()
                 {
                     fb->computeFlexbody();
                 });
-            auto task_handle = App::GetThreadPool()->RunTask(func);
-            m_flexbody_tasks.push_back(task_handle);
+            App::GetThreadPool()->RunTask(m_flexbody_tasks, func);
         }
     }
 }
@@ -3216,10 +3309,7 @@ void RoR::GfxActor::SetFlexbodyVisible(bool visible)
 
 void RoR::GfxActor::FinishFlexbodyTasks()
 {
-    for (auto& task: m_flexbody_tasks)
-    {
-        task->join();
-    }
+    App::GetThreadPool()->WaitForGroup(m_flexbody_tasks);
     for (FlexBody* fb: m_flexbodies)
     {
         if (fb->isVisible())
@@ -3348,9 +3438,9 @@ void RoR::GfxActor::SetCastShadows(bool value)
     }
 
     // Softbody beams
-    for (BeamGfx& rod: m_gfx_beams)
+    if (m_rod_batch)
     {
-        static_cast<Ogre::Entity*>(rod.rod_scenenode->getAttachedObject(0))->setCastShadows(value);
+        m_rod_batch->SetCastShadows(value);
     }
 
     // Flexbody meshes
@@ -3436,24 +3526,10 @@ void RoR::GfxActor::RemoveBeam(int beam_index)
     {
         if (itor->rod_beam_index == beam_index)
         {
-            // Destroy OGRE objects
-            if (itor->rod_scenenode)
-            {
-                if (itor->rod_scenenode->getAttachedObject(0))
-                {
-                    Ogre::Entity* ent = static_cast<Ogre::Entity*>(itor->rod_scenenode->getAttachedObject(0));
-                    if (ent)
-                    {
-                        ent->detachFromParent();
-                        App::GetGfxScene()->GetSceneManager()->destroyEntity(ent);
-                    }
-                }
-
-                App::GetGfxScene()->GetSceneManager()->destroySceneNode(itor->rod_scenenode);
-                itor->rod_scenenode = nullptr;
-            }
-
-            // Destroy the beam visuals
+            // Destroy the beam visuals; the batched mesh is re-created on next update
+            this->FinishRodUpdates();
+            delete m_rod_batch;
+            m_rod_batch = nullptr;
             m_gfx_beams.erase(itor);
             return;
         }
@@ -105,9 +105,9 @@ public:
 
     void                 UpdateVideoCameras(float dt);
     void                 UpdateParticles(float dt);
-    void                 UpdateRods();
+    void                 UpdateRods();                   //!< Push rod (visual beam) mesh task to threadpool
     void                 UpdateWheelVisuals();
-    void                 UpdateFlexbodies();
+    void                 UpdateFlexbodies();             //!< Push flexbody tasks to threadpool; skips still ones, throttles small/distant ones
     void                 UpdateDebugView();
     void                 UpdateCabMesh();
     void                 UpdateWingMeshes();
@@ -125,6 +125,8 @@ public:
     // SimBuffers
 
     void                 UpdateSimDataBuffer(); //!< Copies sim. data from `Actor` to `GfxActor` for later update
+    void                 WriteSimNodeSnapshot(); //!< Sim thread: fills the back node buffer right after physics step, `UpdateSimDataBuffer()` then only swaps.
+    void                 InvalidateSimNodeSnapshot() { m_simbuf_nodes_back_valid = false; } //!< Call when nodes are moved outside of the physics step.
     ActorSB&             GetSimDataBuffer() { return m_simbuf; }
     NodeSB*              GetSimNodeBuffer() { return m_simbuf.simbuf_nodes.data(); }
 
@@ -132,6 +134,7 @@ public:
 
     void                 FinishWheelUpdates();
     void                 FinishFlexbodyTasks();
+    void                 FinishRodUpdates();
 
     // Helpers
 
@@ -159,6 +162,8 @@ public:
 private:
 
     float UpdateSmoothShift(PropAnim& anim, float dt, float new_target_cstate); // Helper for `CalcPropAnimation()`
+    int   CalcFlexbodyUpdateInterval(); // Helper for `UpdateFlexbodies()`
+    void  GenerateRodVertices(); // Threaded task of `UpdateRods()`
 
     // Static info
     ActorPtr                    m_actor;
@@ -177,12 +182,15 @@ private:
     int                         m_prop_anim_prev_gear = 0;
 
     // Threaded tasks
-    std::vector<std::shared_ptr<Task>> m_flexwheel_tasks;
-    std::vector<std::shared_ptr<Task>> m_flexbody_tasks;
+    TaskGroup                          m_flexwheel_tasks;
+    TaskGroup                          m_flexbody_tasks;
+    unsigned int                       m_flexbody_lod_counter = 0;
+    std::shared_ptr<Task>              m_rods_task;
 
     // Elements
     std::vector<NodeGfx>        m_gfx_nodes;
     std::vector<BeamGfx>        m_gfx_beams;
+    RodBatch*                   m_rod_batch = nullptr; //!< Created on first `UpdateRods()`, re-created when beams are removed
     std::vector<AirbrakeGfx>    m_gfx_airbrakes;
     std::vector<Prop>           m_props;
     std::vector<FlexBody*>      m_flexbodies;
@@ -216,6 +224,8 @@ private:
     SurveyMapEntity             m_surveymap_entity;
 
     ActorSB                     m_simbuf;
+    std::vector<NodeSB>         m_simbuf_nodes_back;       //!< Written by sim thread, swapped with `m_simbuf.simbuf_nodes` at sync point.
+    bool                        m_simbuf_nodes_back_valid = false;
 };
 
 /// @} // addtogroup Gfx
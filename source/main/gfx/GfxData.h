@@ -262,8 +262,7 @@ struct BeamGfx
     BeamGfx();
     ~BeamGfx();
 
-    // We don't keep pointer to the Ogre::Entity - we rely on the SceneNode keeping it attached all the time.
-    Ogre::SceneNode* rod_scenenode       = nullptr;
+    std::string      rod_material_name;                      //!< Drawn by `GfxActor::m_rod_batch`
     uint16_t         rod_beam_index      = 0;
     float            rod_diameter        = 0.f;                    //!< meters
 
@@ -101,6 +101,7 @@ void GfxScene::UpdateScene(float dt)
     {
         gfx_actor->UpdateFlexbodies(); // Push flexbody tasks to threadpool
         gfx_actor->UpdateWheelVisuals(); // Push flexwheel tasks to threadpool
+        gfx_actor->UpdateRods(); // Push rod mesh task to threadpool
     }
 
     // Var
@@ -221,7 +222,6 @@ void GfxScene::UpdateScene(float dt)
         float dt_actor = (!gfx_actor->GetSimDataBuffer().simbuf_physics_paused) ? dt : 0.f;
         if (gfx_actor->IsActorLive())
         {
-            gfx_actor->UpdateRods();
             gfx_actor->UpdateCabMesh();
             gfx_actor->UpdateWingMeshes();
             gfx_actor->UpdateAirbrakes();
@@ -263,6 +263,7 @@ void GfxScene::UpdateScene(float dt)
     {
         gfx_actor->FinishWheelUpdates();
         gfx_actor->FinishFlexbodyTasks();
+        gfx_actor->FinishRodUpdates();
     }
 }
 
@@ -345,9 +346,9 @@ void GfxScene::ForceUpdateSingleGfxActor(RoR::GfxActor* gfx_actor)
     // Start threaded stuff
     gfx_actor->UpdateFlexbodies(); // Push flexbody tasks to threadpool
     gfx_actor->UpdateWheelVisuals(); // Push flexwheel tasks to threadpool
+    gfx_actor->UpdateRods(); // Push rod mesh task to threadpool
 
     // Do sync stuff
-    gfx_actor->UpdateRods();
     gfx_actor->UpdateCabMesh();
     gfx_actor->UpdateWingMeshes();
     gfx_actor->UpdateAirbrakes();
@@ -355,6 +356,7 @@ void GfxScene::ForceUpdateSingleGfxActor(RoR::GfxActor* gfx_actor)
     // Finish threaded stuff
     gfx_actor->FinishWheelUpdates();
     gfx_actor->FinishFlexbodyTasks();
+    gfx_actor->FinishRodUpdates();
 }
 
 void GfxScene::RegisterGfxCharacter(RoR::GfxCharacter* gfx_character)
@@ -0,0 +1,230 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "RodBatch.h"
+
+#include "GfxScene.h"
+
+#include <cmath>
+#include <limits>
+#include <map>
+
+using namespace Ogre;
+using namespace RoR;
+
+RodBatch::RodBatch(std::string const& name, std::string const& resource_group, std::vector<std::string> const& rod_materials, Ogre::SceneNode* parent_node)
+{
+    const size_t num_rods = rod_materials.size();
+
+    // Group the rods by material - one submesh each
+    std::map<std::string, std::vector<size_t>> material_groups;
+    for (size_t i = 0; i < num_rods; ++i)
+    {
+        material_groups[rod_materials[i]].push_back(i);
+    }
+
+    m_rod_slots.resize(num_rods);
+    size_t slot = 0;
+    for (auto& group: material_groups)
+    {
+        for (size_t rod_index: group.second)
+        {
+            m_rod_slots[rod_index] = slot++;
+        }
+    }
+
+    m_vertices.resize(num_rods * VERTS_PER_ROD);
+    for (size_t i = 0; i < num_rods; ++i)
+    {
+        this->HideRod(i); // Until the first update
+    }
+
+    m_mesh = MeshManager::getSingleton().createManual(name, resource_group);
+
+    // Vertices shared between submeshes, same format as FlexObj
+    m_mesh->sharedVertexData = new VertexData();
+    m_mesh->sharedVertexData->vertexCount = m_vertices.size();
+
+    VertexDeclaration* vertex_format = m_mesh->sharedVertexData->vertexDeclaration;
+    size_t offset = 0;
+    vertex_format->addElement(0, offset, VET_FLOAT3, VES_POSITION);
+    offset += VertexElement::getTypeSize(VET_FLOAT3);
+    vertex_format->addElement(0, offset, VET_FLOAT3, VES_NORMAL);
+    offset += VertexElement::getTypeSize(VET_FLOAT3);
+    vertex_format->addElement(0, offset, VET_FLOAT2, VES_TEXTURE_COORDINATES, 0);
+    offset += VertexElement::getTypeSize(VET_FLOAT2);
+
+    m_hw_vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+        offset, m_mesh->sharedVertexData->vertexCount, HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
+    m_hw_vbuf->writeData(0, m_hw_vbuf->getSizeInBytes(), m_vertices.data(), true);
+    m_mesh->sharedVertexData->vertexBufferBinding->setBinding(0, m_hw_vbuf);
+
+    // Indices never change - hidden rods are collapsed to a point instead
+    const bool use_32bit_indices = m_vertices.size() > std::numeric_limits<uint16_t>::max();
+    std::vector<uint32_t> indices;
+    for (auto& group: material_groups)
+    {
+        indices.resize(group.second.size() * INDICES_PER_ROD);
+        for (size_t i = 0; i < group.second.size(); ++i)
+        {
+            const uint32_t first_vertex = static_cast<uint32_t>(m_rod_slots[group.second[i]] * VERTS_PER_ROD);
+            RodBatch::GenerateRodIndices(first_vertex, &indices[i * INDICES_PER_ROD]);
+        }
+
+        Ogre::SubMesh* submesh = m_mesh->createSubMesh();
+        submesh->setMaterialName(group.first);
+        submesh->useSharedVertices = true;
+
+        HardwareIndexBufferSharedPtr ibuf = HardwareBufferManager::getSingleton().createIndexBuffer(
+            (use_32bit_indices) ? HardwareIndexBuffer::IT_32BIT : HardwareIndexBuffer::IT_16BIT,
+            indices.size(),
+            HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+        if (use_32bit_indices)
+        {
+            ibuf->writeData(0, ibuf->getSizeInBytes(), indices.data(), true);
+        }
+        else
+        {
+            std::vector<uint16_t> indices16(indices.begin(), indices.end());
+            ibuf->writeData(0, ibuf->getSizeInBytes(), indices16.data(), true);
+        }
+        submesh->indexData->indexBuffer = ibuf;
+        submesh->indexData->indexCount = indices.size();
+        submesh->indexData->indexStart = 0;
+    }
+
+    m_mesh->_setBounds(AxisAlignedBox(-1, -1, -1, 1, 1, 1), true);
+    m_mesh->load();
+
+    m_entity = App::GetGfxScene()->GetSceneManager()->createEntity(name, m_mesh->getName(), resource_group);
+    m_scenenode = parent_node->createChildSceneNode();
+    m_scenenode->attachObject(m_entity);
+}
+
+RodBatch::~RodBatch()
+{
+    if (m_scenenode)
+    {
+        m_scenenode->detachAllObjects();
+        App::GetGfxScene()->GetSceneManager()->destroySceneNode(m_scenenode);
+    }
+    if (m_entity)
+    {
+        App::GetGfxScene()->GetSceneManager()->destroyEntity(m_entity);
+    }
+    if (m_mesh)
+    {
+        Ogre::MeshManager::getSingleton().remove(m_mesh->getHandle());
+        m_mesh.reset();
+    }
+}
+
+void RodBatch::BeginUpdate(Ogre::Vector3 const& origin)
+{
+    m_origin = origin;
+    m_bounds.setNull();
+}
+
+void RodBatch::SetRod(size_t rod_index, Ogre::Vector3 const& pos1, Ogre::Vector3 const& pos2, float diameter)
+{
+    const Ogre::Vector3 rel1 = pos1 - m_origin;
+    const Ogre::Vector3 rel2 = pos2 - m_origin;
+    RodBatch::GenerateRodVertices(rel1, rel2, diameter, &m_vertices[m_rod_slots[rod_index] * VERTS_PER_ROD]);
+
+    const Ogre::Vector3 radius(diameter * 0.5f);
+    m_bounds.merge(AxisAlignedBox(rel1 - radius, rel1 + radius));
+    m_bounds.merge(AxisAlignedBox(rel2 - radius, rel2 + radius));
+}
+
+void RodBatch::HideRod(size_t rod_index)
+{
+    RodVertex* out = &m_vertices[m_rod_slots[rod_index] * VERTS_PER_ROD];
+    for (int i = 0; i < VERTS_PER_ROD; ++i)
+    {
+        out[i].position = Ogre::Vector3::ZERO;
+        out[i].normal = Ogre::Vector3::UNIT_Y;
+        out[i].texcoord = Ogre::Vector2::ZERO;
+    }
+}
+
+void RodBatch::UploadVertices()
+{
+    m_entity->setVisible(!m_bounds.isNull());
+    if (m_bounds.isNull())
+    {
+        return; // Nothing to draw
+    }
+
+    m_hw_vbuf->writeData(0, m_hw_vbuf->getSizeInBytes(), m_vertices.data(), true);
+    m_mesh->_setBounds(m_bounds, false);
+    m_scenenode->setPosition(m_origin); // Also makes the node update its bounds
+}
+
+void RodBatch::SetCastShadows(bool value)
+{
+    m_entity->setCastShadows(value);
+}
+
+void RodBatch::GenerateRodVertices(Ogre::Vector3 const& pos1, Ogre::Vector3 const& pos2, float diameter, RodVertex* out)
+{
+    static const float TWO_PI = 2.f * Ogre::Math::PI;
+
+    Ogre::Vector3 axis = pos2 - pos1;
+    const float length = axis.length();
+    if (length < std::numeric_limits<float>::epsilon())
+    {
+        axis = Ogre::Vector3::UNIT_Y;
+    }
+    else
+    {
+        axis /= length;
+    }
+    const Ogre::Vector3 side1 = axis.perpendicular();
+    const Ogre::Vector3 side2 = axis.crossProduct(side1);
+    const float radius = diameter * 0.5f;
+
+    for (int i = 0; i <= NUM_SIDES; ++i)
+    {
+        const float u = static_cast<float>(i) / NUM_SIDES;
+        const Ogre::Vector3 normal = side1 * std::cos(u * TWO_PI) + side2 * std::sin(u * TWO_PI);
+
+        out[i * 2].position = pos1 + normal * radius;
+        out[i * 2].normal = normal;
+        out[i * 2].texcoord = Ogre::Vector2(u, 0.f);
+
+        out[i * 2 + 1].position = pos2 + normal * radius;
+        out[i * 2 + 1].normal = normal;
+        out[i * 2 + 1].texcoord = Ogre::Vector2(u, 1.f);
+    }
+}
+
+void RodBatch::GenerateRodIndices(uint32_t first_vertex, uint32_t* out)
+{
+    // Vertex pairs (ring 1, ring 2) go around the axis counter-clockwise, so these faces point outwards.
+    for (uint32_t i = 0; i < NUM_SIDES; ++i)
+    {
+        const uint32_t a = first_vertex + i * 2;     // ring 1
+        const uint32_t b = first_vertex + i * 2 + 1; // ring 2
+        const uint32_t c = a + 2;                    // ring 1, next side
+        const uint32_t d = b + 2;                    // ring 2, next side
+
+        *out++ = a; *out++ = c; *out++ = b;
+        *out++ = b; *out++ = c; *out++ = d;
+    }
+}
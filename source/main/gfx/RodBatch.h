@@ -0,0 +1,82 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "Application.h"
+
+#include <Ogre.h>
+#include <string>
+#include <vector>
+
+namespace RoR {
+
+/// @addtogroup Gfx
+/// @{
+
+/// All visual beams ("rods") of an actor in a single dynamic mesh, one submesh per material.
+/// Replaces a SceneNode+Entity per beam; the vertices are generated on a worker thread
+/// (`SetRod()`/`HideRod()` only write to a staging buffer) and uploaded by `UploadVertices()` on main thread.
+class RodBatch
+{
+public:
+    static const int NUM_SIDES = 6;                                //!< Cylinder sides
+    static const int VERTS_PER_ROD = (NUM_SIDES + 1) * 2;          //!< 2 rings, the texture seam is duplicated
+    static const int INDICES_PER_ROD = NUM_SIDES * 6;
+
+    struct RodVertex
+    {
+        Ogre::Vector3 position;
+        Ogre::Vector3 normal;
+        Ogre::Vector2 texcoord;
+    };
+
+    /// @param rod_materials Material name for each rod; rods are addressed by index into this list.
+    RodBatch(std::string const& name, std::string const& resource_group, std::vector<std::string> const& rod_materials, Ogre::SceneNode* parent_node);
+    ~RodBatch();
+
+    // Vertex generation - thread safe with respect to OGRE, only touches the staging buffer.
+    void        BeginUpdate(Ogre::Vector3 const& origin);
+    void        SetRod(size_t rod_index, Ogre::Vector3 const& pos1, Ogre::Vector3 const& pos2, float diameter);
+    void        HideRod(size_t rod_index);
+
+    /// Main thread only.
+    void        UploadVertices();
+    void        SetCastShadows(bool value);
+
+    /// CPU-side mesh generation, no OGRE rendering objects involved.
+    /// Positions are written as-is, so pass them relative to a nearby origin for precision.
+    static void GenerateRodVertices(Ogre::Vector3 const& pos1, Ogre::Vector3 const& pos2, float diameter, RodVertex* out);
+    static void GenerateRodIndices(uint32_t first_vertex, uint32_t* out);
+
+private:
+    Ogre::MeshPtr               m_mesh;
+    Ogre::Entity*               m_entity = nullptr;
+    Ogre::SceneNode*            m_scenenode = nullptr;
+    Ogre::HardwareVertexBufferSharedPtr m_hw_vbuf;
+
+    std::vector<size_t>         m_rod_slots;    //!< Rod index -> position in vertex buffer (in rods), rods are grouped by material
+    std::vector<RodVertex>      m_vertices;     //!< Staging buffer
+    Ogre::Vector3               m_origin = Ogre::Vector3::ZERO;
+    Ogre::AxisAlignedBox        m_bounds;       //!< Of the visible rods, relative to `m_origin`
+};
+
+/// @} // addtogroup Gfx
+
+} // namespace RoR
@@ -49,30 +49,23 @@ static const int           DEFAULT_INTERNAL_CAM_PITCH = -15;
 static const float         TRANS_SPEED = 50.f;
 static const float         ROTATE_SPEED = 100.f;
 
-bool intersectsTerrain(Vector3 a, Vector3 b) // internal helper
-{
-    b.y = std::max(b.y, App::GetGameContext()->GetTerrain()->getHeightAt(b.x, b.z) + 1.0f);
-
-    int steps = std::max(3.0f, a.distance(b) * 2.0f);
-    for (int i = 1; i < steps; i++)
-    {
-        Vector3 pos = a + (b - a) * (float)i / steps;
-        float h = App::GetGameContext()->GetTerrain()->getHeightAt(pos.x, pos.z);
-        if (h > pos.y)
-        {
-            return true;
-        }
-    }
-    return App::GetGameContext()->GetTerrain()->GetCollisions()->intersectsTris(Ray(a, b - a)).first;
-}
-
 bool intersectsTerrain(Vector3 a, Vector3 start, Vector3 end, float interval) // internal helper
 {
     int steps = std::max(3.0f, start.distance(end) * (6.0f / interval));
+    std::vector<Ray> rays;
+    rays.reserve(steps + 1);
     for (int i = 0; i <= steps; i++)
     {
         Vector3 b = start + (end - start) * (float)i / steps;
-        if (intersectsTerrain(a, b))
+        b.y = std::max(b.y, App::GetGameContext()->GetTerrain()->getHeightAt(b.x, b.z) + 1.0f);
+        rays.push_back(Ray(a, b - a));
+    }
+
+    std::vector<Collisions::RaycastResult> results;
+    App::GetGameContext()->GetTerrain()->GetCollisions()->intersectsBatch(rays, Collisions::RAYCAST_TRIS | Collisions::RAYCAST_TERRAIN, results);
+    for (Collisions::RaycastResult const& result : results)
+    {
+        if (result.first)
         {
             return true;
         }
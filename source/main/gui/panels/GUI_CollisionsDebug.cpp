@@ -191,14 +191,14 @@ void CollisionsDebug::Draw()
 void CollisionsDebug::AddCollisionMeshDebugMesh(collision_mesh_t const& coll_mesh)
 {
     // Gather data
-    const CollisionTriVec& ctris = App::GetGameContext()->GetTerrain()->GetCollisions()->getCollisionTriangles();
+    const CollisionTriColdVec& ctris = App::GetGameContext()->GetTerrain()->GetCollisions()->getCollisionTriangles();
 
     // Create mesh
     Ogre::ManualObject* debugmo = App::GetGfxScene()->GetSceneManager()->createManualObject();
     debugmo->begin("tracks/debug/collision/triangle", RenderOperation::OT_TRIANGLE_LIST);
     for (int i = 0; i < coll_mesh.collision_tri_count; i++)
     {
-        collision_tri_t const& ctri = ctris[i + coll_mesh.collision_tri_start];
+        collision_tri_cold_t const& ctri = ctris[i + coll_mesh.collision_tri_start];
         // The collision triangle vertices are in world coords, we want local coords.
         debugmo->position(ctri.a - coll_mesh.position);
         debugmo->position(ctri.b - coll_mesh.position);
@@ -48,6 +48,7 @@
 #include "Console.h"
 #include "GfxActor.h"
 #include "InputEngine.h"
+#include "InputReplay.h"
 #include "Language.h"
 #include "MeshObject.h"
 #include "MovableText.h"
@@ -318,6 +319,9 @@ void Actor::scaleTruck(float value)
         return;
     if (value < 0)
         return;
+    m_gfx_actor->InvalidateSimNodeSnapshot();
+    if (m_input_replay)
+        m_input_replay->Interrupt();
 
     ar_scale *= value;
     // scale beams
@@ -885,6 +889,17 @@ void Actor::DetermineLinkedActors()
             }
         }
     }
+
+    ar_linked_actor_flags.assign(ar_linked_actor_flags.size(), false);
+    for (ActorPtr& actor : ar_linked_actors)
+    {
+        const size_t id = static_cast<size_t>(actor->ar_instance_id);
+        if (id >= ar_linked_actor_flags.size())
+        {
+            ar_linked_actor_flags.resize(id + 1, false);
+        }
+        ar_linked_actor_flags[id] = true;
+    }
 }
 
 int Actor::getWheelNodeCount() const
@@ -1250,6 +1265,10 @@ void Actor::UpdatePhysicsOrigin()
 
 void Actor::ResetAngle(float rot)
 {
+    m_gfx_actor->InvalidateSimNodeSnapshot();
+    if (m_input_replay)
+        m_input_replay->Interrupt();
+
     // Set origin of rotation to camera node
     Vector3 origin = ar_nodes[ar_main_camera_node_pos].AbsPosition;
 
@@ -1280,6 +1299,10 @@ void Actor::updateInitPosition()
 
 void Actor::resetPosition(float px, float pz, bool setInitPosition, float miny)
 {
+    m_gfx_actor->InvalidateSimNodeSnapshot();
+    if (m_input_replay)
+        m_input_replay->Interrupt();
+
     // horizontal displacement
     Vector3 offset = Vector3(px, ar_nodes[0].AbsPosition.y, pz) - ar_nodes[0].AbsPosition;
     for (int i = 0; i < ar_num_nodes; i++)
@@ -1338,6 +1361,10 @@ void Actor::resetPosition(float px, float pz, bool setInitPosition, float miny)
 
 void Actor::resetPosition(Ogre::Vector3 translation, bool setInitPosition)
 {
+    m_gfx_actor->InvalidateSimNodeSnapshot();
+    if (m_input_replay)
+        m_input_replay->Interrupt();
+
     // total displacement
     if (translation != Vector3::ZERO)
     {
@@ -1646,6 +1673,10 @@ void Actor::SyncReset(bool reset_position)
 {
     TRIGGER_EVENT_ASYNC(SE_TRUCK_RESET, ar_instance_id);
 
+    m_gfx_actor->InvalidateSimNodeSnapshot(); // Also covers `softRespawn()`
+    if (m_input_replay)
+        m_input_replay->Interrupt();
+
     m_reset_timer.reset();
 
     m_camera_local_gforces_cur = Vector3::ZERO;
@@ -232,6 +232,7 @@ public:
     std::vector<std::string> getManagedMaterialNames();
     // not exported to scripting:
     Replay*           getReplay();
+    InputReplayPtr    getInputReplay() { return m_input_replay; }
     TyrePressure&     getTyrePressure() { return m_tyre_pressure; }
     EnginePtr      getEngine() { return ar_engine; }
     //! @}
@@ -411,6 +412,7 @@ public:
     float             ar_brake_force = 0.f;              //!< Physics attr; filled at spawn
     
     Ogre::Vector3     ar_origin = Ogre::Vector3::ZERO;                   //!< Physics state; base position for softbody nodes
+    int               ar_sim_rng_state = 1;                              //!< Physics state; per-actor generator for physics noise (turbulence...), see `frand()`. Must be odd.
     int               ar_num_cameras = 0;
     Ogre::Quaternion  ar_main_camera_dir_corr = Ogre::Quaternion::IDENTITY;              //!< Sim attr;
     NodeNum_t         ar_main_camera_node_pos            = 0;    //!< Sim attr; ar_camera_node_pos[0]  >= 0 ? ar_camera_node_pos[0]  : 0
@@ -492,6 +494,7 @@ public:
     // Gameplay state
     ActorState        ar_state = ActorState::LOCAL_SIMULATED;
     ActorPtrVec       ar_linked_actors;                 //!< BEWARE: Includes indirect links, see `DetermineLinkedActors()`; Other actors linked using 'hooks/ties/ropes/slidenodes'; use `MSG_SIM_ACTOR_LINKING_REQUESTED`
+    std::vector<bool> ar_linked_actor_flags;            //!< Same content as `ar_linked_actors`, indexed by `ActorInstanceID_t`; for per-step lookups.
     bool              m_ongoing_reset = false;          //!< Hack to prevent position/rotation creep during interactive truck reset (aka LiveRepair).
     bool              ar_physics_paused = false;        //!< Actor physics individually paused by user.
     bool              ar_muted_by_peeropt = false;      //!< Muted by user in multiplayer (see `RoRnet::PEEROPT_MUTE_ACTORS`).
@@ -542,6 +545,7 @@ private:
     void              CalcBeams(bool trigger_hooks);       
     void              CalcBeamsInterActor();               
     void              CalcBuoyance(bool doUpdate);         
+    void              CalcBuoyanceParallel(bool doUpdate); //!< Splits buoycabs across ThreadPool workers, see `sim_buoyancy_parallel_threshold`
     void              CalcCommands(bool doUpdate);         
     void              CalcCabCollisions();                 
     void              CalcDifferentials();                 
@@ -602,6 +606,7 @@ private:
     Ogre::Vector3     m_avg_node_velocity = Ogre::Vector3::ZERO;          //!< average node velocity (compared to the previous frame step)
     float             m_stabilizer_shock_sleep = 0.f;     //!< Sim state
     Replay*           m_replay_handler = nullptr;
+    InputReplayPtr    m_input_replay;                       //!< Deterministic replay, recording or playback
     NodeNum_t         m_mouse_grab_node = NODENUM_INVALID;  //!< Sim state; node currently being dragged by user
     Ogre::Vector3     m_mouse_grab_pos = Ogre::Vector3::ZERO;
     float             m_mouse_grab_move_force = 0.f;
@@ -38,6 +38,7 @@
 #include "ScriptEngine.h"
 #include "SoundScriptManager.h"
 #include "Terrain.h"
+#include "ThreadPool.h"
 #include "GfxWater.h"
 
 using namespace Ogre;
@@ -183,22 +184,36 @@ void Actor::CalcBuoyance(bool doUpdate)
             m_buoyance->buoy_projected_nodes[i].Forces   = Ogre::Vector3::ZERO;
         }
 
-        // Update node forces.
-        for (int i = 0; i < ar_num_buoycabs; i++)
+        const int parallel_threshold = App::sim_buoyancy_parallel_threshold->getInt();
+        // Not in deterministic mode - the order of summing up the per-worker forces varies.
+        if (parallel_threshold > 0 && ar_num_buoycabs >= parallel_threshold && App::GetThreadPool()->GetNumWorkers() > 0 &&
+            !App::sim_deterministic->getBool())
         {
-            int tmpv = ar_buoycabs[i] * 3;
-
-            BuoyCachedNode& bcn_a = m_buoyance->buoy_cached_nodes[ar_cabs_buoy_cache_ids[tmpv]];
-            BuoyCachedNode& bcn_b = m_buoyance->buoy_cached_nodes[ar_cabs_buoy_cache_ids[tmpv+1]];
-            BuoyCachedNode& bcn_c = m_buoyance->buoy_cached_nodes[ar_cabs_buoy_cache_ids[tmpv+2]];
-            m_buoyance->update = doUpdate;
-            m_buoyance->computeNodeForce(&bcn_a, &bcn_b, &bcn_c, ar_buoycab_types[i], /* timeshift: */ 0.f);
+            this->CalcBuoyanceParallel(doUpdate);
+        }
+        else
+        {
+            // Wave heights at nodes are shared by all triangles.
+            m_buoyance->computeWaveHeights(m_buoyance->buoy_cached_nodes, 0, m_buoyance->buoy_cached_nodes.size());
+            m_buoyance->computeWaveHeights(m_buoyance->buoy_projected_nodes, 0, m_buoyance->buoy_projected_nodes.size());
 
-            BuoyCachedNode& bpn_a = m_buoyance->buoy_projected_nodes[ar_cabs_buoy_cache_ids[tmpv]];
-            BuoyCachedNode& bpn_b = m_buoyance->buoy_projected_nodes[ar_cabs_buoy_cache_ids[tmpv+1]];
-            BuoyCachedNode& bpn_c = m_buoyance->buoy_projected_nodes[ar_cabs_buoy_cache_ids[tmpv+2]];
-            m_buoyance->update = false;
-            m_buoyance->computeNodeForce(&bpn_a, &bpn_b, &bpn_c, ar_buoycab_types[i], timeshift_sec);
+            // Update node forces.
+            for (int i = 0; i < ar_num_buoycabs; i++)
+            {
+                int tmpv = ar_buoycabs[i] * 3;
+
+                BuoyCachedNode& bcn_a = m_buoyance->buoy_cached_nodes[ar_cabs_buoy_cache_ids[tmpv]];
+                BuoyCachedNode& bcn_b = m_buoyance->buoy_cached_nodes[ar_cabs_buoy_cache_ids[tmpv+1]];
+                BuoyCachedNode& bcn_c = m_buoyance->buoy_cached_nodes[ar_cabs_buoy_cache_ids[tmpv+2]];
+                m_buoyance->update = doUpdate;
+                m_buoyance->computeNodeForce(&bcn_a, &bcn_b, &bcn_c, ar_buoycab_types[i], /* timeshift: */ 0.f);
+
+                BuoyCachedNode& bpn_a = m_buoyance->buoy_projected_nodes[ar_cabs_buoy_cache_ids[tmpv]];
+                BuoyCachedNode& bpn_b = m_buoyance->buoy_projected_nodes[ar_cabs_buoy_cache_ids[tmpv+1]];
+                BuoyCachedNode& bpn_c = m_buoyance->buoy_projected_nodes[ar_cabs_buoy_cache_ids[tmpv+2]];
+                m_buoyance->update = false;
+                m_buoyance->computeNodeForce(&bpn_a, &bpn_b, &bpn_c, ar_buoycab_types[i], timeshift_sec);
+            }
         }
 
         // Apply forces to nodes.
@@ -228,6 +243,61 @@ void Actor::CalcBuoyance(bool doUpdate)
     m_buoyance->buoy_total_steps++;
 }
 
+const size_t BUOYANCY_PARALLEL_NODE_CHUNK = 256; // nodes per chunk when computing wave heights
+const size_t BUOYANCY_PARALLEL_CAB_CHUNK = 128; // buoycabs per chunk
+
+void Actor::CalcBuoyanceParallel(bool doUpdate)
+{
+    // NOTE: We're already running on a ThreadPool worker (see `ActorManager::UpdatePhysicsSimulation()`),
+    //       `ThreadPool::ParallelFor()` is safe to use from there - the calling thread helps out and never waits for queued tasks.
+    ThreadPool* thread_pool = App::GetThreadPool();
+    const size_t max_participants = thread_pool->GetNumWorkers() + 1;
+    const size_t num_buoy_nodes = m_buoyance->buoy_cached_nodes.size();
+
+    // Evaluate waves once per node - shared by all triangles and workers.
+    thread_pool->ParallelFor(num_buoy_nodes, BUOYANCY_PARALLEL_NODE_CHUNK, max_participants,
+        [this](size_t begin, size_t end, size_t /*participant*/)
+        {
+            m_buoyance->computeWaveHeights(m_buoyance->buoy_cached_nodes, begin, end);
+            m_buoyance->computeWaveHeights(m_buoyance->buoy_projected_nodes, begin, end);
+        });
+
+    // Prepare per-worker force accumulators.
+    if (m_buoyance->buoy_work_contexts.size() < max_participants)
+    {
+        m_buoyance->buoy_work_contexts.resize(max_participants);
+    }
+    for (BuoyWorkContext& ctx: m_buoyance->buoy_work_contexts)
+    {
+        ctx.deferred = true;
+        ctx.forces_cached.assign(num_buoy_nodes, Vec3());
+        ctx.forces_projected.assign(num_buoy_nodes, Vec3());
+        ctx.debug_subcabs.clear();
+        ctx.splashes.clear();
+    }
+
+    const size_t num_participants = thread_pool->ParallelFor(static_cast<size_t>(ar_num_buoycabs), BUOYANCY_PARALLEL_CAB_CHUNK, max_participants,
+        [this, doUpdate](size_t begin, size_t end, size_t participant)
+        {
+            BuoyWorkContext& ctx = m_buoyance->buoy_work_contexts[participant];
+            for (size_t i = begin; i < end; i++)
+            {
+                int tmpv = ar_buoycabs[i] * 3;
+                const BuoyCachedNodeID_t id_a = ar_cabs_buoy_cache_ids[tmpv];
+                const BuoyCachedNodeID_t id_b = ar_cabs_buoy_cache_ids[tmpv+1];
+                const BuoyCachedNodeID_t id_c = ar_cabs_buoy_cache_ids[tmpv+2];
+
+                ctx.update = doUpdate;
+                m_buoyance->computeNodeForce(m_buoyance->buoy_cached_nodes, id_a, id_b, id_c, ar_buoycab_types[i], ctx.forces_cached, ctx);
+
+                ctx.update = false;
+                m_buoyance->computeNodeForce(m_buoyance->buoy_projected_nodes, id_a, id_b, id_c, ar_buoycab_types[i], ctx.forces_projected, ctx);
+            }
+        });
+
+    m_buoyance->reduceWorkContexts(num_participants);
+}
+
 void Actor::CalcDifferentials()
 {
     if (ar_engine && m_num_proped_wheels > 0)
@@ -1668,7 +1738,7 @@ void Actor::CalcNodes()
             Vector3 drag = -defdragxspeed * ar_nodes[i].Velocity;
             // plus: turbulences
             Real maxtur = defdragxspeed * approx_speed * 0.005f;
-            drag += maxtur * Vector3(frand_11(), frand_11(), frand_11());
+            drag += maxtur * Vector3(frand_11(ar_sim_rng_state), frand_11(ar_sim_rng_state), frand_11(ar_sim_rng_state));
             ar_nodes[i].Forces += drag;
         }
 
@@ -42,11 +42,13 @@
 #include "Console.h"
 #include "GUI_TopMenubar.h"
 #include "InputEngine.h"
+#include "InputReplay.h"
 #include "Language.h"
 #include "MovableText.h"
 #include "Network.h"
 #include "PointColDetector.h"
 #include "Replay.h"
+#include "RigDef_DocumentCache.h"
 #include "RigDef_Validator.h"
 #include "RigDef_Serializer.h"
 #include "ActorSpawner.h"
@@ -99,6 +101,7 @@ ActorPtr ActorManager::CreateNewActor(ActorSpawnRequest rq, RigDef::DocumentPtr
     spawner.ConfigureSections(actor->m_section_config, def);
     spawner.ConfigureAddonParts(actor->m_working_tuneup_def);
     spawner.ConfigureAssetPacks(actor, def);
+    spawner.ConfigureSpawnTemplate(this->FetchSpawnTemplate(actor, def));
     spawner.ProcessNewActor(actor, rq, def);
 
     if (App::diag_actor_dump->getBool())
@@ -269,6 +272,7 @@ ActorPtr ActorManager::CreateNewActor(ActorSpawnRequest rq, RigDef::DocumentPtr
         actor->GetGfxActor()->UpdateRods(); // beam visuals
         actor->GetGfxActor()->FinishWheelUpdates(); // Sync tasks from threadpool
         actor->GetGfxActor()->FinishFlexbodyTasks(); // Sync tasks from threadpool
+        actor->GetGfxActor()->FinishRodUpdates(); // Sync tasks from threadpool
     }
 
     App::GetGfxScene()->RegisterGfxActor(actor->GetGfxActor());
@@ -323,6 +327,16 @@ ActorPtr ActorManager::CreateNewActor(ActorSpawnRequest rq, RigDef::DocumentPtr
         actor->m_replay_handler = new Replay(actor, App::sim_replay_length->getInt());
     }
 
+    actor->ar_sim_rng_state = actor->ar_instance_id * 2 + 1;
+    if (rq.asr_input_replay)
+    {
+        actor->m_input_replay = rq.asr_input_replay; // Playback; overwrites the initial state on first frame.
+    }
+    else if (App::sim_deterministic->getBool() && rq.asr_origin != ActorSpawnRequest::Origin::NETWORK)
+    {
+        actor->m_input_replay = std::make_shared<InputReplay>(); // Recording
+    }
+
     //cache buoyancy nodes (must be done when position is final)
     if (actor->m_buoyance)
     {
@@ -888,6 +902,35 @@ void ActorManager::CleanUpSimulation() // Called after simulation finishes
     m_last_simulation_speed = 0.1f;
     m_simulation_paused = false;
     m_simulation_speed = 1.f;
+    m_spawn_templates.clear();
+}
+
+ActorSpawnTemplatePtr ActorManager::FetchSpawnTemplate(ActorPtr const& actor, RigDef::DocumentPtr def)
+{
+    // Everything which changes the spawned geometry must be part of the key.
+    std::string key = (def->hash.empty()) ? actor->ar_filename : def->hash;
+    key += "|" + actor->m_section_config;
+    if (actor->m_working_tuneup_def)
+    {
+        Str<TUNEUP_BUF_SIZE> tuneup_buf; // `Ogre::MemoryDataStream` doesn't zero-out the buffer it creates; we must supply our own zeroed memory.
+        Ogre::DataStreamPtr datastream(new Ogre::MemoryDataStream(tuneup_buf.GetBuffer(), tuneup_buf.GetCapacity()));
+        TuneupUtil::ExportTuneup(datastream, actor->m_working_tuneup_def);
+        key += "|" + datastream->getAsString();
+    }
+
+    ActorSpawnTemplatePtr& spawn_template = m_spawn_templates[key];
+    if (!spawn_template)
+    {
+        spawn_template = std::make_shared<ActorSpawnTemplate>();
+        spawn_template->key = key;
+    }
+    else
+    {
+        LOG(fmt::format("[RoR] Spawning '{}' from template (use #{}, {} flexbodies)",
+            actor->ar_filename, spawn_template->num_uses + 1, spawn_template->flexbodies.size()));
+    }
+    spawn_template->num_uses++;
+    return spawn_template;
 }
 
 void ActorManager::DeleteActorInternal(ActorPtr actor)
@@ -1052,9 +1095,19 @@ void ActorManager::UpdateActors(ActorPtr player_actor)
     }
 
     m_dt_remainder = dt - (m_physics_steps * PHYSICS_DT);
-    dt = PHYSICS_DT * m_physics_steps;
 
-    this->SyncWithSimThread();
+    // Deterministic replay: reproduce the time steps of the recording, regardless of framerate.
+    for (ActorPtr& actor: m_actors)
+    {
+        if (actor->m_input_replay && actor->m_input_replay->IsPlaying())
+        {
+            m_physics_steps = actor->m_input_replay->PeekNumPhysicsSteps();
+            m_dt_remainder = 0.f;
+            break;
+        }
+    }
+
+    dt = PHYSICS_DT * m_physics_steps;
 
     this->UpdateSleepingState(player_actor, dt);
 
@@ -1139,6 +1192,15 @@ void ActorManager::UpdateActors(ActorPtr player_actor)
         }
     }
 
+    // All controls are set now - record them or override them from replay.
+    for (ActorPtr& actor: m_actors)
+    {
+        if (actor->m_input_replay)
+        {
+            actor->m_input_replay->UpdateFrame(actor, m_physics_steps);
+        }
+    }
+
     auto func = std::function<void()>([this]()
         {
             this->UpdatePhysicsSimulation();
@@ -1219,7 +1281,18 @@ void ActorManager::UpdatePhysicsSimulation()
                     tasks.push_back(func);
                 }
             }
-            App::GetThreadPool()->Parallelize(tasks);
+            if (App::sim_deterministic->getBool())
+            {
+                // The tasks also add forces to the other actor's nodes; keep the order fixed.
+                for (auto& task: tasks)
+                {
+                    task();
+                }
+            }
+            else
+            {
+                App::GetThreadPool()->Parallelize(tasks);
+            }
         }
 
         // Apply FreeForces - intentionally as a separate pass over all actors
@@ -1239,6 +1312,7 @@ void ActorManager::UpdatePhysicsSimulation()
             actor->m_avg_node_velocity /= (m_physics_steps * PHYSICS_DT);
             actor->m_avg_node_position_prev = actor->m_avg_node_position;
             actor->ar_top_speed = std::max(actor->ar_top_speed, actor->ar_nodes[0].Velocity.length());
+            actor->GetGfxActor()->WriteSimNodeSnapshot();
         }
     }
 }
@@ -1246,7 +1320,12 @@ void ActorManager::UpdatePhysicsSimulation()
 void ActorManager::SyncWithSimThread()
 {
     if (m_sim_task)
+    {
+        // Instead of just blocking, help the sim thread with its per-actor work (see `UpdatePhysicsSimulation()`).
+        std::shared_ptr<Task> sim_task = m_sim_task;
+        App::GetThreadPool()->HelpUntil([sim_task]{ return sim_task->IsFinished(); });
         m_sim_task->join();
+    }
 }
 
 void HandleErrorLoadingFile(std::string type, std::string filename, std::string exception_msg)
@@ -1289,6 +1368,18 @@ RigDef::DocumentPtr ActorManager::FetchActorDef(RoR::ActorSpawnRequest& rq)
             return nullptr;
         }
 
+        // Re-use the parsed+validated document from a previous session, if the file didn't change
+        const std::string file_hash = Sha1Hash(stream->getAsString());
+        const std::string cache_filename = RigDef::DocumentCache::MakeFilename(file_hash);
+        RigDef::DocumentPtr cached_def;
+        if (RigDef::DocumentCache::LoadFile(cache_filename, file_hash, cached_def) == RigDef::DocumentCache::RESULT_CODE_OK)
+        {
+            RoR::LogFormat("[RoR] Loaded truckfile '%s' from cache", rq.asr_cache_entry->fname.c_str());
+            rq.asr_cache_entry->actor_def = cached_def;
+            return cached_def;
+        }
+        stream->seek(0);
+
         RoR::LogFormat("[RoR] Parsing truckfile '%s'", rq.asr_cache_entry->fname.c_str());
         RigDef::Parser parser;
         parser.Prepare();
@@ -1319,7 +1410,13 @@ RigDef::DocumentPtr ActorManager::FetchActorDef(RoR::ActorSpawnRequest& rq)
 
         validator.Validate(); // Sends messages to console
 
-        def->hash = Sha1Hash(stream->getAsString());
+        def->hash = file_hash;
+
+        RigDef::DocumentCache::ResultCode result = RigDef::DocumentCache::SaveFile(cache_filename, def);
+        if (result != RigDef::DocumentCache::RESULT_CODE_OK)
+        {
+            LOG(fmt::format("[RoR] Failed to write truckfile cache '{}' (code {})", cache_filename, (int)result));
+        }
 
         rq.asr_cache_entry->actor_def = def;
         return def;
@@ -137,6 +137,7 @@ private:
     void           ForwardCommands(ActorPtr source_actor); //!< Fowards things to trailers
     void           UpdateTruckFeatures(ActorPtr vehicle, float dt);
     void           CalcFreeForces();                             //!< Apply FreeForces - intentionally as a separate pass over all actors
+    ActorSpawnTemplatePtr FetchSpawnTemplate(ActorPtr const& actor, RigDef::DocumentPtr def); //!< Creates empty template on first use.
 
     // Networking
     std::map<int, std::set<int>> m_stream_mismatches; //!< Networking: A set of streams without a corresponding actor in the actor-array for each stream source
@@ -156,6 +157,7 @@ private:
     float               m_total_sim_time         = 0.f;
     FreeForceVec_t      m_free_forces;                    //!< Global forces added ad-hoc by scripts
     FreeForceID_t       m_free_force_next_id     = 0;     //!< Unique ID for each FreeForce
+    std::map<std::string, ActorSpawnTemplatePtr> m_spawn_templates; //!< Keyed by truckfile hash + section config + tuneup; cleared with the terrain
 
     // Utils
     std::unique_ptr<ThreadPool> m_sim_thread_pool;
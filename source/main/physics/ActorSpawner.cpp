@@ -389,7 +389,7 @@ void ActorSpawner::InitializeRig()
 
     m_actor->m_definition = m_file;
 
-    m_flex_factory = RoR::FlexFactory(this);
+    m_flex_factory = RoR::FlexFactory(this, m_spawn_template);
 
     m_flex_factory.CheckAndLoadFlexbodyCache();
 
@@ -2996,7 +2996,7 @@ void ActorSpawner::ProcessTie(RigDef::Tie & def)
 
     if (BITMASK_IS_0(def.options, RigDef::Tie::OPTION_i_INVISIBLE))
     {
-        this->CreateBeamVisuals(beam, beam_index, false, def.beam_defaults);
+        this->CreateBeamVisuals(beam, beam_index, def.beam_defaults);
     }
     else
     {
@@ -3036,7 +3036,7 @@ void ActorSpawner::ProcessRope(RigDef::Rope & def)
     beam.L = root_node.AbsPosition.distance(end_node.AbsPosition);
     beam.refL = beam.L;
 
-    this->CreateBeamVisuals(beam, beam_index, true, def.beam_defaults, "tracks/beam");
+    this->CreateBeamVisuals(beam, beam_index, def.beam_defaults, "tracks/beam");
 
     /* Register rope */
     rope_t rope;
@@ -3449,7 +3449,7 @@ void ActorSpawner::ProcessTrigger(RigDef::Trigger & def)
 
     if (!invisible)
     {
-        this->CreateBeamVisuals(beam, beam_index, true, def.beam_defaults);
+        this->CreateBeamVisuals(beam, beam_index, def.beam_defaults);
     }
     else
     {
@@ -3748,7 +3748,7 @@ void ActorSpawner::ProcessCommand(RigDef::Command2 & def)
 
     if (! def.option_i_invisible)
     {
-        this->CreateBeamVisuals(beam, beam_index, true, def.beam_defaults);
+        this->CreateBeamVisuals(beam, beam_index, def.beam_defaults);
     }
     else
     {
@@ -3908,7 +3908,7 @@ void ActorSpawner::ProcessAnimator(RigDef::Animator & def)
 
     if (BITMASK_IS_0(def.flags, RigDef::Animator::OPTION_INVISIBLE))
     {
-        this->CreateBeamVisuals(beam, beam_index, true, def.beam_defaults);
+        this->CreateBeamVisuals(beam, beam_index, def.beam_defaults);
     }
     else
     {
@@ -4043,7 +4043,7 @@ void ActorSpawner::ProcessHydro(RigDef::Hydro & def)
 
     if (!invisible)
     {
-        this->CreateBeamVisuals(beam, beam_index, true, def.beam_defaults);
+        this->CreateBeamVisuals(beam, beam_index, def.beam_defaults);
     }
     else
     {
@@ -4118,7 +4118,7 @@ void ActorSpawner::ProcessShock3(RigDef::Shock3 & def)
 
     if (BITMASK_IS_0(def.options, RigDef::Shock3::OPTION_i_INVISIBLE))
     {
-        this->CreateBeamVisuals(beam, beam_index, true, def.beam_defaults);
+        this->CreateBeamVisuals(beam, beam_index, def.beam_defaults);
     }
     else
     {
@@ -4207,7 +4207,7 @@ void ActorSpawner::ProcessShock2(RigDef::Shock2 & def)
 
     if (BITMASK_IS_0(def.options, RigDef::Shock2::OPTION_i_INVISIBLE))
     {
-        this->CreateBeamVisuals(beam, beam_index, true, def.beam_defaults);
+        this->CreateBeamVisuals(beam, beam_index, def.beam_defaults);
     }
     else
     {
@@ -4284,7 +4284,7 @@ void ActorSpawner::ProcessShock(RigDef::Shock & def)
 
     if (BITMASK_IS_0(def.options, RigDef::Shock::OPTION_i_INVISIBLE))
     {
-        this->CreateBeamVisuals(beam, beam_index, true, def.beam_defaults);
+        this->CreateBeamVisuals(beam, beam_index, def.beam_defaults);
     }
     else
     {
@@ -5664,7 +5664,7 @@ void ActorSpawner::ProcessBeam(RigDef::Beam & def)
 
     if (BITMASK_IS_0(def.options, RigDef::Beam::OPTION_i_INVISIBLE))
     {
-        this->CreateBeamVisuals(beam, beam_index, true, def.defaults);
+        this->CreateBeamVisuals(beam, beam_index, def.defaults);
     }
     else
     {
@@ -5798,7 +5798,7 @@ void ActorSpawner::SetBeamDeformationThreshold(beam_t & beam, std::shared_ptr<Ri
     beam.maxnegstress       = -(deformation_threshold);
 }
 
-void ActorSpawner::CreateBeamVisuals(beam_t & beam, int beam_index, bool visible, std::shared_ptr<RigDef::BeamDefaults> const& beam_defaults, std::string material_override)
+void ActorSpawner::CreateBeamVisuals(beam_t & beam, int beam_index, std::shared_ptr<RigDef::BeamDefaults> const& beam_defaults, std::string material_override)
 {
     std::string material_name = material_override;
     if (material_name.empty())
@@ -5828,31 +5828,18 @@ void ActorSpawner::CreateBeamVisuals(beam_t & beam, int beam_index, bool visible
         m_actor->m_gfx_actor->m_gfx_beams_parent_scenenode = m_actor_grouping_scenenode->createChildSceneNode(this->ComposeName("beams"));
     }
 
-    try
-    {
-        Ogre::Entity* entity = App::GetGfxScene()->GetSceneManager()->createEntity(this->ComposeName("beam", beam_index), "beam.mesh");
-        entity->setMaterialName(material_name);
-
-        BeamGfx beamx;
-        beamx.rod_diameter = beam_defaults->visual_beam_diameter;
-        beam.default_beam_diameter = beam_defaults->visual_beam_diameter; // Hack for ActorExport.cpp
-        beamx.rod_beam_index = static_cast<uint16_t>(beam_index);
-        beamx.rod_node1 = beam.p1->pos;
-        beamx.rod_node2 = beam.p2->pos;
-        beamx.rod_target_actor = m_actor;
-        beamx.rod_is_visible = false;
-
-        beamx.rod_scenenode = m_actor->m_gfx_actor->m_gfx_beams_parent_scenenode->createChildSceneNode(this->ComposeName("beam", beam_index));
-        beamx.rod_scenenode->attachObject(entity);
-        beamx.rod_scenenode->setVisible(visible, /*cascade:*/ false);
-        beamx.rod_scenenode->setScale(beam_defaults->visual_beam_diameter, -1, beam_defaults->visual_beam_diameter);
+    // The OGRE objects are created by `GfxActor::UpdateRods()`, all beams in one mesh.
+    BeamGfx beamx;
+    beamx.rod_diameter = beam_defaults->visual_beam_diameter;
+    beam.default_beam_diameter = beam_defaults->visual_beam_diameter; // Hack for ActorExport.cpp
+    beamx.rod_beam_index = static_cast<uint16_t>(beam_index);
+    beamx.rod_node1 = beam.p1->pos;
+    beamx.rod_node2 = beam.p2->pos;
+    beamx.rod_target_actor = m_actor;
+    beamx.rod_is_visible = false;
+    beamx.rod_material_name = material_name;
 
-        m_actor->m_gfx_actor->m_gfx_beams.push_back(beamx);
-    }
-    catch (Ogre::Exception& e)
-    {
-        this->AddMessage(Message::TYPE_WARNING, fmt::format("Could not create beam visuals: {}", e.getFullDescription()));
-    }
+    m_actor->m_gfx_actor->m_gfx_beams.push_back(beamx);
 }
 
 void ActorSpawner::CalculateBeamLength(beam_t & beam)
@@ -6101,7 +6088,7 @@ void ActorSpawner::ProcessNode(RigDef::Node & def)
         beam.L                 = HOOK_RANGE_DEFAULT;
         beam.refL              = HOOK_RANGE_DEFAULT;
         SetBeamDeformationThreshold(beam, def.beam_defaults);
-        CreateBeamVisuals(beam, beam_index, false, def.beam_defaults);
+        CreateBeamVisuals(beam, beam_index, def.beam_defaults);
             
         // Logic cloned from SerializedRig.cpp, section BTS_NODES
         hook_t hook;
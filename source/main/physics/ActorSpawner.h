@@ -41,6 +41,17 @@ namespace RoR {
 /// @addtogroup Physics
 /// @{
 
+/// Results of spawning an actor which don't depend on the spawn position and can be reused by later spawns of the same
+/// truckfile + sectionconfig + tuneup, see `ActorManager::FetchSpawnTemplate()`. Everything else is rebuilt for each instance,
+/// since the actor structures point to per-instance memory and the processing creates per-instance visuals and sounds.
+/// Flexbody vertex bindings dominate the spawn time of detailed vehicles (every vertex searches for 3 nearest forset nodes).
+struct ActorSpawnTemplate
+{
+    std::string                                     key;
+    std::map<FlexbodyID_t, FlexBodyTemplateData>    flexbodies; //!< Filled by the first spawn which created the flexbody.
+    size_t                                          num_uses = 0;
+};
+
 /// Processes a RigDef::Document (parsed from 'truck' file format) into a simulated gameplay object (Actor).
 ///
 /// HISTORY:
@@ -97,6 +108,7 @@ public:
     void                           ConfigureSections(Ogre::String const & sectionconfig, RigDef::DocumentPtr def);
     void                           ConfigureAddonParts(TuneupDefPtr& tuneup_def);
     void                           ConfigureAssetPacks(ActorPtr actor, RigDef::DocumentPtr def);
+    void                           ConfigureSpawnTemplate(ActorSpawnTemplatePtr spawn_template) { m_spawn_template = spawn_template; }
     void                           ProcessNewActor(ActorPtr actor, ActorSpawnRequest rq, RigDef::DocumentPtr def);
     static void                    SetupDefaultSoundSources(ActorPtr const& actor);
     /// @}
@@ -370,7 +382,7 @@ private:
 
     /// @name Visual setup
     /// @{
-    void                          CreateBeamVisuals(beam_t& beam, int beam_index, bool visible, std::shared_ptr<RigDef::BeamDefaults> const& beam_defaults, std::string material_override="");
+    void                          CreateBeamVisuals(beam_t & beam, int beam_index, std::shared_ptr<RigDef::BeamDefaults> const& beam_defaults, std::string material_override="");
     void                          CreateWheelSkidmarks(WheelID_t wheel_index);
     void                          FinalizeGfxSetup();
     Ogre::MaterialPtr             FindOrCreateCustomizedMaterial(const std::string& mat_lookup_name, const std::string& mat_lookup_rg);
@@ -482,6 +494,7 @@ private:
     /// @name Visuals
     /// @{
     RoR::FlexFactory                          m_flex_factory;
+    ActorSpawnTemplatePtr                     m_spawn_template; //!< Optional, see `ConfigureSpawnTemplate()`
     std::map<std::string, CustomMaterial>     m_material_substitutions; //!< Maps original material names (shared) to their actor-specific substitutes; There's 1 substitute per 1 material, regardless of user count.
     std::map<std::string, Ogre::MaterialPtr>  m_managed_materials;
     Ogre::MaterialPtr                         m_managedmat_placeholder_template; //!< An 'error marker' material (bright magenta) to generate managedmaterial placeholders from.
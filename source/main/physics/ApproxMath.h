@@ -27,41 +27,29 @@
 
 static int mirand = 1;
 
-// Returns a random number in the range [0, 1]
-inline float frand()
+// Advances the generator state (must be odd) and returns a random number in the range [2, 4]
+inline float frand_step(int& state)
 {
     unsigned int a;
 
-    mirand *= 16807;
+    state = static_cast<int>(static_cast<unsigned int>(state) * 16807u);
 
-    a = (mirand&0x007fffff) | 0x40000000;
+    a = (state&0x007fffff) | 0x40000000;
 
-    return( *((float*)&a) - 2.0f )*0.5f;
+    return *((float*)&a);
 }
 
-// Returns a random number in the range [0, 2]
-inline float frand_02()
-{
-    unsigned int a;
-
-    mirand *= 16807;
+// Returns a random number in the range [0, 1]; the stateful variant is for physics, see `Actor::ar_sim_rng_state`
+inline float frand(int& state) { return (frand_step(state) - 2.0f)*0.5f; }
+inline float frand()           { return frand(mirand); }
 
-    a = (mirand&0x007fffff) | 0x40000000;
-
-    return( *((float*)&a) - 2.0f );
-}
+// Returns a random number in the range [0, 2]
+inline float frand_02(int& state) { return frand_step(state) - 2.0f; }
+inline float frand_02()           { return frand_02(mirand); }
 
 // Returns a random number in the range [-1, 1]
-inline float frand_11()
-{
-    unsigned int a;
-
-    mirand *= 16807;
-
-    a = (mirand&0x007fffff) | 0x40000000;
-
-    return( *((float*)&a) - 3.0f );
-}
+inline float frand_11(int& state) { return frand_step(state) - 3.0f; }
+inline float frand_11()           { return frand_11(mirand); }
 
 // Calculates approximate e^x.
 // Use it in code not requiring precision
@@ -30,9 +30,11 @@
 #include "Console.h"
 #include "Engine.h"
 #include "GameContext.h"
+#include "GfxActor.h"
 #include "GUIManager.h"
 #include "GUI_MessageBox.h"
 #include "InputEngine.h"
+#include "InputReplay.h"
 #include "Language.h"
 #include "PlatformUtils.h"
 #include "ScrewProp.h"
@@ -943,6 +945,9 @@ void ActorManager::RestoreSavedState(ActorPtr actor, rapidjson::Value const& j_e
         actor->ar_nodes[i].Velocity         = Vector3(data[3].GetFloat(), data[4].GetFloat(), data[5].GetFloat());
         actor->ar_initial_node_positions[i] = Vector3(data[6].GetFloat(), data[7].GetFloat(), data[8].GetFloat());
     }
+    actor->GetGfxActor()->InvalidateSimNodeSnapshot();
+    if (actor->getInputReplay())
+        actor->getInputReplay()->Interrupt();
 
     std::vector<ActorPtr> actors = this->GetLocalActors();
 
@@ -852,6 +852,7 @@ struct ActorSpawnRequest
     bool                asr_terrn_machine = false;   //!< This is a fixed machinery
     std::shared_ptr<rapidjson::Document>
                         asr_saved_state;             //!< Pushes msg MODIFY_ACTOR (type RESTORE_SAVED) after spawn.
+    InputReplayPtr      asr_input_replay;            //!< Plays back a deterministic replay, see `InputReplay`.
 };
 
 struct ActorModifyRequest
@@ -0,0 +1,242 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "CollisionMeshCache.h"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace RoR;
+
+const char* CollisionMeshCache::SIGNATURE = "RoR/CollMeshes";
+
+CollisionMeshCache::CollisionMeshCache(std::string const& filename, std::string const& terrain_key)
+    : m_filename(filename)
+    , m_terrain_key(terrain_key)
+{}
+
+std::string CollisionMeshCache::MakeMeshKey(std::string const& meshname, std::string const& source_stamp, Ogre::Vector3 const& pos, Ogre::Quaternion const& q, Ogre::Vector3 const& scale)
+{
+    // Exact binary match of the placement - the triangles are baked in world space.
+    const float placement[] = { pos.x, pos.y, pos.z, q.w, q.x, q.y, q.z, scale.x, scale.y, scale.z };
+    std::string key = meshname;
+    key.push_back('\0');
+    key += source_stamp;
+    key.push_back('\0');
+    key.append(reinterpret_cast<const char*>(placement), sizeof(placement));
+    return key;
+}
+
+std::string CollisionMeshCache::MakeResourceStamp(std::string const& filename, std::string const& group)
+{
+    try
+    {
+        const std::string group_name = (group.empty())
+            ? Ogre::ResourceGroupManager::getSingleton().findGroupContainingResource(filename)
+            : group;
+        Ogre::FileInfoListPtr file_infos = Ogre::ResourceGroupManager::getSingleton().findResourceFileInfo(group_name, filename);
+        const size_t size = (!file_infos->empty()) ? file_infos->front().uncompressedSize : 0;
+        const std::time_t mtime = Ogre::ResourceGroupManager::getSingleton().resourceModifiedTime(group_name, filename);
+        return fmt::format("{}|{}|{}", filename, size, (int64_t)mtime);
+    }
+    catch (...)
+    {
+        return filename + "|?"; // Not found; loading it will report the error
+    }
+}
+
+std::string const& CollisionMeshCache::GetResourceStamp(std::string const& filename)
+{
+    auto found = m_resource_stamps.find(filename);
+    if (found == m_resource_stamps.end())
+    {
+        found = m_resource_stamps.insert(std::make_pair(filename, CollisionMeshCache::MakeResourceStamp(filename))).first;
+    }
+    return found->second;
+}
+
+CollisionMeshCache::ResultCode CollisionMeshCache::LoadFile()
+{
+    this->Close();
+    if (!m_file.Open(m_filename))
+    {
+        return RESULT_CODE_ERR_FOPEN_FAILED;
+    }
+
+    const char* data = m_file.GetData();
+    const size_t size = m_file.GetSize();
+
+    FileHeader header;
+    if (size < sizeof(FileHeader))
+    {
+        this->Close();
+        return RESULT_CODE_ERR_FILE_TRUNCATED;
+    }
+    std::memcpy(&header, data, sizeof(FileHeader));
+    if (std::strncmp(header.signature, SIGNATURE, sizeof(header.signature)) != 0)
+    {
+        this->Close();
+        return RESULT_CODE_ERR_SIGNATURE_MISMATCH;
+    }
+    if (header.file_format_version != FILE_FORMAT_VERSION)
+    {
+        this->Close();
+        return RESULT_CODE_ERR_VERSION_MISMATCH;
+    }
+
+    size_t pos = sizeof(FileHeader);
+    if (pos + PaddedLength(header.terrain_key_len) > size)
+    {
+        this->Close();
+        return RESULT_CODE_ERR_FILE_TRUNCATED;
+    }
+    if (m_terrain_key != std::string(data + pos, header.terrain_key_len))
+    {
+        this->Close();
+        return RESULT_CODE_ERR_TERRAIN_KEY_MISMATCH;
+    }
+    pos += PaddedLength(header.terrain_key_len);
+
+    for (uint32_t i = 0; i < header.num_records; ++i)
+    {
+        RecordHeader rh;
+        if (pos + sizeof(RecordHeader) > size)
+        {
+            this->Close();
+            return RESULT_CODE_ERR_FILE_TRUNCATED;
+        }
+        std::memcpy(&rh, data + pos, sizeof(RecordHeader));
+        pos += sizeof(RecordHeader);
+
+        const size_t hot_bytes = rh.num_tris * sizeof(collision_tri_hot_t);
+        const size_t vert_bytes = rh.num_tris * 3 * sizeof(Ogre::Vector3);
+        if (pos + PaddedLength(rh.key_len) + hot_bytes + vert_bytes > size)
+        {
+            this->Close();
+            return RESULT_CODE_ERR_FILE_TRUNCATED;
+        }
+
+        std::string key(data + pos, rh.key_len);
+        pos += PaddedLength(rh.key_len);
+
+        CachedCollisionMesh rec;
+        rec.tris_hot = data + pos;
+        pos += hot_bytes;
+        rec.tris_verts = data + pos;
+        pos += vert_bytes;
+        rec.num_tris = rh.num_tris;
+        rec.num_verts = rh.num_verts;
+        rec.num_indices = rh.num_indices;
+        rec.bounding_box = Ogre::AxisAlignedBox(
+            rh.bounds_min[0], rh.bounds_min[1], rh.bounds_min[2],
+            rh.bounds_max[0], rh.bounds_max[1], rh.bounds_max[2]);
+        m_records.insert(std::make_pair(key, rec));
+    }
+
+    return RESULT_CODE_OK;
+}
+
+bool CollisionMeshCache::FindMesh(std::string const& key, CachedCollisionMesh& out) const
+{
+    auto itor = m_records.find(key);
+    if (itor == m_records.end())
+    {
+        return false;
+    }
+    out = itor->second;
+    return true;
+}
+
+void CollisionMeshCache::AddItemToSave(std::string const& key, int mesh_index, bool cache_miss)
+{
+    ItemToSave item;
+    item.key = key;
+    item.mesh_index = mesh_index;
+    m_items_to_save.push_back(item);
+    if (cache_miss)
+    {
+        m_num_misses++;
+    }
+}
+
+CollisionMeshCache::ResultCode CollisionMeshCache::SaveFile(CollisionTriHotVec const& tris_hot, CollisionTriColdVec const& tris_cold, CollisionMeshVec const& meshes)
+{
+    this->Close(); // The mapping must be released before the file can be overwritten.
+
+    FILE* file = fopen(m_filename.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return RESULT_CODE_ERR_FOPEN_FAILED;
+    }
+
+    const char padding[4] = {};
+    bool ok = true;
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(FileHeader));
+    std::strncpy(header.signature, SIGNATURE, sizeof(header.signature));
+    header.file_format_version = FILE_FORMAT_VERSION;
+    header.num_records = static_cast<uint32_t>(m_items_to_save.size());
+    header.terrain_key_len = static_cast<uint32_t>(m_terrain_key.size());
+    ok = ok && fwrite(&header, sizeof(FileHeader), 1, file) == 1;
+    ok = ok && fwrite(m_terrain_key.data(), 1, m_terrain_key.size(), file) == m_terrain_key.size();
+    ok = ok && fwrite(padding, 1, PaddedLength(m_terrain_key.size()) - m_terrain_key.size(), file) == PaddedLength(m_terrain_key.size()) - m_terrain_key.size();
+
+    std::vector<Ogre::Vector3> verts;
+    for (ItemToSave const& item: m_items_to_save)
+    {
+        collision_mesh_t const& mesh = meshes[item.mesh_index];
+
+        RecordHeader rh;
+        rh.key_len = static_cast<uint32_t>(item.key.size());
+        rh.num_tris = static_cast<uint32_t>(mesh.collision_tri_count);
+        rh.num_verts = static_cast<uint32_t>(mesh.num_verts);
+        rh.num_indices = static_cast<uint32_t>(mesh.num_indices);
+        for (int i = 0; i < 3; ++i)
+        {
+            rh.bounds_min[i] = mesh.bounding_box.getMinimum()[i];
+            rh.bounds_max[i] = mesh.bounding_box.getMaximum()[i];
+        }
+        ok = ok && fwrite(&rh, sizeof(RecordHeader), 1, file) == 1;
+        ok = ok && fwrite(item.key.data(), 1, item.key.size(), file) == item.key.size();
+        ok = ok && fwrite(padding, 1, PaddedLength(item.key.size()) - item.key.size(), file) == PaddedLength(item.key.size()) - item.key.size();
+
+        if (mesh.collision_tri_count > 0)
+        {
+            ok = ok && fwrite(&tris_hot[mesh.collision_tri_start], sizeof(collision_tri_hot_t), mesh.collision_tri_count, file) == (size_t)mesh.collision_tri_count;
+
+            verts.clear();
+            for (int i = mesh.collision_tri_start; i < mesh.collision_tri_start + mesh.collision_tri_count; ++i)
+            {
+                verts.push_back(tris_cold[i].a);
+                verts.push_back(tris_cold[i].b);
+                verts.push_back(tris_cold[i].c);
+            }
+            ok = ok && fwrite(verts.data(), sizeof(Ogre::Vector3), verts.size(), file) == verts.size();
+        }
+    }
+
+    fclose(file);
+    if (!ok)
+    {
+        std::remove(m_filename.c_str()); // Don't leave a half-written file behind.
+        return RESULT_CODE_FWRITE_OUTPUT_INCOMPLETE;
+    }
+    return RESULT_CODE_OK;
+}
@@ -0,0 +1,131 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "Collisions.h"
+#include "PlatformUtils.h"
+
+#include <Ogre.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace RoR {
+
+/// @addtogroup Physics
+/// @{
+
+/// @addtogroup Collisions
+/// @{
+
+/// A cached mesh, pointing into the mapped file; valid until `CollisionMeshCache::Close()`.
+struct CachedCollisionMesh
+{
+    const char*          tris_hot = nullptr;  //!< `num_tris` x `collision_tri_hot_t`, possibly unaligned
+    const char*          tris_verts = nullptr;//!< `num_tris` x 3 x `Ogre::Vector3` (the cold vertices)
+    size_t               num_tris = 0;
+    size_t               num_verts = 0;
+    size_t               num_indices = 0;
+    Ogre::AxisAlignedBox bounding_box;
+};
+
+/// Persists collision triangles generated from terrain object meshes (see `Collisions::addCollisionMesh()`),
+/// so that re-loading a terrain skips reading the mesh buffers and building the triangle-space matrices.
+/// One file per terrain, memory-mapped when loading. A record is looked up by mesh name + placement + the size/mtime
+/// of the ODef and mesh files it was built from, so editing either rebuilds just that record;
+/// the whole file is discarded when the terrain (its .terrn2 or .tobj files, or the game) changes.
+class CollisionMeshCache
+{
+public:
+    enum ResultCode
+    {
+        RESULT_CODE_OK,
+        RESULT_CODE_ERR_FOPEN_FAILED,
+        RESULT_CODE_ERR_SIGNATURE_MISMATCH,
+        RESULT_CODE_ERR_VERSION_MISMATCH,
+        RESULT_CODE_ERR_TERRAIN_KEY_MISMATCH,
+        RESULT_CODE_ERR_FILE_TRUNCATED,
+        RESULT_CODE_FWRITE_OUTPUT_INCOMPLETE
+    };
+
+    static const char*        SIGNATURE;
+    static const unsigned int FILE_FORMAT_VERSION = 1;
+
+    /// @param terrain_key Identifies the terrain build; a file with a different key is ignored and later overwritten.
+    CollisionMeshCache(std::string const& filename, std::string const& terrain_key);
+
+    /// @param source_stamp Identifies the contents of the files the mesh was built from, see `GetResourceStamp()`.
+    static std::string MakeMeshKey(std::string const& meshname, std::string const& source_stamp, Ogre::Vector3 const& pos, Ogre::Quaternion const& q, Ogre::Vector3 const& scale);
+    /// Size and modification time of a resource; for ZIP bundles, the mtime is that of the archive. Empty group = search all.
+    static std::string MakeResourceStamp(std::string const& filename, std::string const& group = "");
+
+    std::string const& GetResourceStamp(std::string const& filename); //!< Memoized `MakeResourceStamp()`; many objects share an ODef/mesh.
+
+    ResultCode  LoadFile();
+    ResultCode  SaveFile(CollisionTriHotVec const& tris_hot, CollisionTriColdVec const& tris_cold, CollisionMeshVec const& meshes);
+    void        Close()                                     { m_records.clear(); m_file.Close(); }
+
+    bool        FindMesh(std::string const& key, CachedCollisionMesh& out) const;
+    void        AddItemToSave(std::string const& key, int mesh_index, bool cache_miss);
+    bool        IsModified() const                          { return m_num_misses > 0; }
+    size_t      GetNumHits() const                          { return m_items_to_save.size() - m_num_misses; }
+    size_t      GetNumMisses() const                        { return m_num_misses; }
+    std::string const& GetFilename() const                  { return m_filename; }
+
+private:
+    struct FileHeader
+    {
+        char     signature[16];
+        uint32_t file_format_version;
+        uint32_t num_records;
+        uint32_t terrain_key_len; //!< Followed by the key, padded to 4 bytes
+    };
+
+    struct RecordHeader
+    {
+        uint32_t key_len;         //!< Followed by the key, padded to 4 bytes, then the triangle arrays
+        uint32_t num_tris;
+        uint32_t num_verts;
+        uint32_t num_indices;
+        float    bounds_min[3];
+        float    bounds_max[3];
+    };
+
+    struct ItemToSave
+    {
+        std::string key;
+        int         mesh_index;
+    };
+
+    static size_t PaddedLength(size_t len)                  { return (len + 3) & ~size_t(3); }
+
+    std::string                                          m_filename;
+    std::string                                          m_terrain_key;
+    MappedFile                                           m_file;
+    std::unordered_map<std::string, CachedCollisionMesh> m_records;
+    std::vector<ItemToSave>                              m_items_to_save;
+    std::unordered_map<std::string, std::string>         m_resource_stamps;
+    size_t                                               m_num_misses = 0;
+};
+
+/// @} // addtogroup Collisions
+/// @} // addtogroup Physics
+
+} // namespace RoR
@@ -25,6 +25,7 @@
 #include "ApproxMath.h"
 #include "Actor.h"
 #include "ActorManager.h"
+#include "CollisionMeshCache.h"
 #include "ErrorUtils.h"
 #include "GameContext.h"
 #include "GfxScene.h"
@@ -34,6 +35,11 @@
 #include "PlatformUtils.h"
 #include "ScriptEngine.h"
 #include "Terrain.h"
+#include "TerrainGeometryManager.h"
+#include "ThreadPool.h"
+
+#include <cmath>
+#include <cstring>
 
 using namespace RoR;
 
@@ -355,19 +361,20 @@ void Collisions::removeCollisionBox(int number)
 
 void Collisions::removeCollisionTri(int number)
 {
-    if (number > -1 && number < m_collision_tris.size())
+    if (number > -1 && number < m_collision_tris_hot.size())
     {
-        m_collision_tris[number].enabled = false;
+        m_collision_tris_hot[number].enabled = false;
         // Is it worth to update the hashmap? ~ ulteq 01/19
     }
 }
 
 ground_model_t *Collisions::getGroundModelByString(const String name)
 {
-    if (!ground_models.size() || ground_models.find(name) == ground_models.end())
+    auto itor = ground_models.find(name);
+    if (itor == ground_models.end())
         return 0;
 
-    return &ground_models[name];
+    return &itor->second;
 }
 
 unsigned int Collisions::hashfunc(unsigned int cellid)
@@ -556,12 +563,9 @@ int Collisions::addCollisionBox(bool rotating, bool virt, Vector3 pos, Ogre::Vec
 
 int Collisions::addCollisionTri(Vector3 p1, Vector3 p2, Vector3 p3, ground_model_t* gm)
 {
-    int new_tri_index = (int)m_collision_tris.size();
-    collision_tri_t new_tri;
+    int new_tri_index = (int)m_collision_tris_hot.size();
+    collision_tri_hot_t new_tri;
     new_tri.a=p1;
-    new_tri.b=p2;
-    new_tri.c=p3;
-    new_tri.gm=gm;
     new_tri.enabled=true;
     // compute transformations
     // base construction
@@ -570,21 +574,39 @@ int Collisions::addCollisionTri(Vector3 p1, Vector3 p2, Vector3 p3, ground_model
     Vector3 bz=bx.crossProduct(by);
     bz.normalise();
     // coordinates change matrix
-    new_tri.reverse.SetColumn(0, bx);
-    new_tri.reverse.SetColumn(1, by);
-    new_tri.reverse.SetColumn(2, bz);
-    new_tri.forward=new_tri.reverse.Inverse();
+    Matrix3 reverse;
+    reverse.SetColumn(0, bx);
+    reverse.SetColumn(1, by);
+    reverse.SetColumn(2, bz);
+    new_tri.forward=reverse.Inverse();
 
     // compute tri AAB
-    new_tri.aab.merge(p1);
-    new_tri.aab.merge(p2);
-    new_tri.aab.merge(p3);
-    new_tri.aab.setMinimum(new_tri.aab.getMinimum() - 0.1f);
-    new_tri.aab.setMaximum(new_tri.aab.getMaximum() + 0.1f);
-    
+    AxisAlignedBox aab;
+    aab.merge(p1);
+    aab.merge(p2);
+    aab.merge(p3);
+    new_tri.aab_min = aab.getMinimum() - 0.1f;
+    new_tri.aab_max = aab.getMaximum() + 0.1f;
+
+    collision_tri_cold_t new_tri_cold;
+    new_tri_cold.a=p1;
+    new_tri_cold.b=p2;
+    new_tri_cold.c=p3;
+    new_tri_cold.gm=gm;
+
+    m_collision_tris_hot.push_back(new_tri);
+    m_collision_tris_cold.push_back(new_tri_cold);
+    this->registerCollisionTri(new_tri_index);
+    return new_tri_index;
+}
+
+void Collisions::registerCollisionTri(int tri_index)
+{
+    collision_tri_hot_t const& tri = m_collision_tris_hot[tri_index];
+
     // register this collision tri in the index
-    Ogre::Vector3 ilo(new_tri.aab.getMinimum() / Ogre::Real(CELL_SIZE));
-    Ogre::Vector3 ihi(new_tri.aab.getMaximum() / Ogre::Real(CELL_SIZE));
+    Ogre::Vector3 ilo(tri.aab_min / Ogre::Real(CELL_SIZE));
+    Ogre::Vector3 ihi(tri.aab_max / Ogre::Real(CELL_SIZE));
     
     // clamp between 0 and MAXIMUM_CELL;
     ilo.makeCeil(Ogre::Vector3(0.0f));
@@ -596,13 +618,11 @@ int Collisions::addCollisionTri(Vector3 p1, Vector3 p2, Vector3 p3, ground_model
     {
         for (int j = ilo.z; j<=ihi.z; j++)
         {
-            hash_add(i, j, new_tri_index + hash_coll_element_t::ELEMENT_TRI_BASE_INDEX, new_tri.aab.getMaximum().y);
+            hash_add(i, j, tri_index + hash_coll_element_t::ELEMENT_TRI_BASE_INDEX, tri.aab_max.y);
         }
     }
 
-    m_collision_aab.merge(new_tri.aab);
-    m_collision_tris.push_back(new_tri);
-    return new_tri_index;
+    m_collision_aab.merge(AxisAlignedBox(tri.aab_min, tri.aab_max));
 }
 
 void Collisions::envokeScriptCallback(collision_box_t *cbox, node_t *node)
@@ -631,74 +651,172 @@ void Collisions::envokeScriptCallback(collision_box_t *cbox, node_t *node)
 #endif //USE_ANGELSCRIPT
 }
 
-std::pair<bool, Ogre::Real> Collisions::intersectsTris(Ogre::Ray ray)
+template <typename VisitorT>
+void Collisions::forEachHashOnRay(Ogre::Ray const& ray, VisitorT visitor)
 {
-    int steps = ray.getDirection().length() / (float)CELL_SIZE;
+    const Vector3 origin = ray.getOrigin();
+    const Vector3 dir = ray.getDirection();
+    const float infinity = std::numeric_limits<float>::max();
 
-    int lhash = -1;
+    // NaN would never satisfy the exit condition below
+    if (!std::isfinite(origin.x) || !std::isfinite(origin.y) || !std::isfinite(origin.z)
+        || !std::isfinite(dir.x) || !std::isfinite(dir.y) || !std::isfinite(dir.z))
+        return;
 
-    for (int i = 0; i <= steps; i++)
+    // Each step crosses one cell border (+1 for rounding at the end of the ray); cells outside the grid
+    // are clamped to its edge, so there's no point walking further than the grid dimension.
+    const Vector3 end = ray.getPoint(1.0f);
+    const float span = std::abs(std::floor(end.x / (float)CELL_SIZE) - std::floor(origin.x / (float)CELL_SIZE))
+                     + std::abs(std::floor(end.z / (float)CELL_SIZE) - std::floor(origin.z / (float)CELL_SIZE));
+    const int max_steps = (int)std::min(span + 1.0f, 2.0f * (MAXIMUM_CELL + 1));
+
+    int cell_x = (int)std::floor(origin.x / (float)CELL_SIZE);
+    int cell_z = (int)std::floor(origin.z / (float)CELL_SIZE);
+    const int step_x = (dir.x >= 0.0f) ? 1 : -1;
+    const int step_z = (dir.z >= 0.0f) ? 1 : -1;
+
+    // ray parameter at which the next cell border is crossed, and the distance between the borders
+    const float t_delta_x = (dir.x != 0.0f) ? (float)CELL_SIZE / std::abs(dir.x) : infinity;
+    const float t_delta_z = (dir.z != 0.0f) ? (float)CELL_SIZE / std::abs(dir.z) : infinity;
+    float t_next_x = (dir.x != 0.0f) ? (((cell_x + (step_x > 0 ? 1 : 0)) * (float)CELL_SIZE) - origin.x) / dir.x : infinity;
+    float t_next_z = (dir.z != 0.0f) ? (((cell_z + (step_z > 0 ? 1 : 0)) * (float)CELL_SIZE) - origin.z) / dir.z : infinity;
+
+    float t_enter = 0.0f;
+    int lhash = -1;
+    for (int step = 0; step <= max_steps; step++)
     {
-        Vector3 pos = ray.getPoint((float)i / (float)steps);
+        const float t_exit = std::min(std::min(t_next_x, t_next_z), 1.0f);
+
+        // same clamping as when registering elements
+        const int hash = hash_find(Ogre::Math::Clamp(cell_x, 0, (int)MAXIMUM_CELL), Ogre::Math::Clamp(cell_z, 0, (int)MAXIMUM_CELL));
+        if (hash != lhash)
+        {
+            lhash = hash;
+            const float y_min = origin.y + dir.y * ((dir.y < 0.0f) ? t_exit : t_enter);
+            if (y_min <= hashtable_height[hash] && visitor(hash, t_exit))
+                return;
+        }
 
-        // find the correct cell
-        int refx = (int)(pos.x / (float)CELL_SIZE);
-        int refz = (int)(pos.z / (float)CELL_SIZE);
-        int hash = hash_find(refx, refz);
+        if (t_exit >= 1.0f)
+            return;
 
-        if (hash == lhash)
-            continue;
+        if (t_next_x < t_next_z)
+        {
+            cell_x += step_x;
+            t_enter = t_next_x;
+            t_next_x += t_delta_x;
+        }
+        else
+        {
+            cell_z += step_z;
+            t_enter = t_next_z;
+            t_next_z += t_delta_z;
+        }
+    }
+}
 
-        lhash = hash;
+std::pair<bool, Ogre::Real> Collisions::intersectsTris(Ogre::Ray ray)
+{
+    // Triangles span multiple cells, so a hit found in a cell may lie further along the ray;
+    // keep the nearest one and stop once the walk has passed it.
+    float nearest = std::numeric_limits<float>::max();
 
-        size_t num_elements = hashtable[hash].size();
-        for (size_t k = 0; k < num_elements; k++)
+    this->forEachHashOnRay(ray, [&](int hash, float t_exit) -> bool
+    {
+        for (hash_coll_element_t const& element : hashtable[hash])
         {
-            if (hashtable[hash][k].IsCollisionTri())
+            if (element.IsCollisionTri())
             {
-                const int ctri_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
-                collision_tri_t *ctri = &m_collision_tris[ctri_index];
-
-                if (!ctri->enabled)
+                const int ctri_index = element.element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
+                if (!m_collision_tris_hot[ctri_index].enabled)
                     continue;
 
-                auto result = Ogre::Math::intersects(ray, ctri->a, ctri->b, ctri->c);
+                const collision_tri_cold_t& ctri = m_collision_tris_cold[ctri_index];
+                auto result = Ogre::Math::intersects(ray, ctri.a, ctri.b, ctri.c);
                 if (result.first && result.second < 1.0f)
                 {
-                    return result;
+                    nearest = std::min(nearest, result.second);
                 }
             }
         }
-    }
+        return nearest <= t_exit;
+    });
 
+    if (nearest < 1.0f)
+        return std::make_pair(true, nearest);
     return std::make_pair(false, 0.0f);
 }
 
-std::pair<bool, Ogre::Real> Collisions::intersectsTerrain(Ogre::Ray ray)
+std::pair<bool, Ogre::Real> Collisions::intersectsBoxes(Ogre::Ray ray, float skip_margin)
 {
-    const Ogre::Real raydir_length = ray.getDirection().length();
-    const Ogre::Real step_size     = Ogre::Real(0.1);
-
-    /*
-     * Normalise ray's direction vector, follow it and take sample points after each step_size.
-     * Check for an intersection at each sample point.
-     */
-    ray.setDirection(ray.getDirection().normalisedCopy());
+    const Vector3 end = ray.getPoint(1.0f);
+    float nearest = std::numeric_limits<float>::max();
 
-    for (Ogre::Real distance = Ogre::Real(0); distance <= raydir_length; distance += step_size)
+    this->forEachHashOnRay(ray, [&](int hash, float t_exit) -> bool
     {
-        Ogre::Vector3 position       = ray.getPoint(distance);
-        Ogre::Real    terrain_height = App::GetGameContext()->GetTerrain()->getHeightAt(position.x, position.z);
-
-        if (terrain_height > position.y)
+        for (hash_coll_element_t const& element : hashtable[hash])
         {
-            Ogre::Real distance_in_raydir_units = distance / raydir_length;
+            if (!element.IsCollisionBox())
+                continue;
 
-            return std::make_pair(true, distance_in_raydir_units);
+            const collision_box_t& cbox = m_collision_boxes[element.element_index];
+            if (!cbox.enabled || cbox.virt)
+                continue;
+
+            const AxisAlignedBox cbox_aab(cbox.lo, cbox.hi);
+            if (skip_margin >= 0.0f && (cbox_aab.contains(end) || cbox_aab.distance(end) < skip_margin))
+                continue;
+
+            auto result = ray.intersects(cbox_aab);
+            if (result.first && result.second <= 1.0f)
+            {
+                nearest = std::min(nearest, result.second);
+            }
         }
-    }
+        return nearest <= t_exit;
+    });
 
-    return std::make_pair(false, Ogre::Real(0));
+    if (nearest <= 1.0f)
+        return std::make_pair(true, nearest);
+    return std::make_pair(false, 0.0f);
+}
+
+std::pair<bool, Ogre::Real> Collisions::intersectsTerrain(Ogre::Ray ray)
+{
+    return App::GetGameContext()->GetTerrain()->getGeometryManager()->intersectsRay(ray);
+}
+
+void Collisions::intersectsBatch(std::vector<Ogre::Ray> const& rays, int targets, std::vector<RaycastResult>& out_results)
+{
+    out_results.resize(rays.size());
+
+    const size_t chunk_size = 16;
+    App::GetThreadPool()->ParallelFor(rays.size(), chunk_size, App::GetThreadPool()->GetNumWorkers() + 1,
+        [&](size_t begin, size_t end, size_t /*participant*/)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            RaycastResult result(false, 0.0f);
+            RaycastResult candidate(false, 0.0f);
+            if (BITMASK_IS_1(targets, RAYCAST_TRIS))
+            {
+                result = this->intersectsTris(rays[i]);
+            }
+            if (BITMASK_IS_1(targets, RAYCAST_BOXES))
+            {
+                candidate = this->intersectsBoxes(rays[i]);
+                if (candidate.first && (!result.first || candidate.second < result.second))
+                    result = candidate;
+            }
+            if (BITMASK_IS_1(targets, RAYCAST_TERRAIN))
+            {
+                candidate = this->intersectsTerrain(rays[i]);
+                if (candidate.first && (!result.first || candidate.second < result.second))
+                    result = candidate;
+            }
+            out_results[i] = result;
+        }
+    });
 }
 
 float Collisions::getSurfaceHeight(float x, float z)
@@ -770,19 +888,20 @@ float Collisions::getSurfaceHeightBelow(float x, float z, float height)
         else // The element is a triangle
         {
             const int ctri_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
-            collision_tri_t *ctri = &m_collision_tris[ctri_index];
+            const collision_tri_hot_t& ctri = m_collision_tris_hot[ctri_index];
 
-            if (!ctri->enabled)
+            if (!ctri.enabled)
                 continue;
 
-            auto lo = ctri->aab.getMinimum();
-            auto hi = ctri->aab.getMaximum();
+            const Vector3& lo = ctri.aab_min;
+            const Vector3& hi = ctri.aab_max;
             if (surface_height >= hi.y)
                 continue;
             if (x < lo.x || z < lo.z || x > hi.x || z > hi.z)
                 continue;
 
-            auto result = Ogre::Math::intersects(ray, ctri->a, ctri->b, ctri->c);
+            const collision_tri_cold_t& ctri_cold = m_collision_tris_cold[ctri_index];
+            auto result = Ogre::Math::intersects(ray, ctri_cold.a, ctri_cold.b, ctri_cold.c);
             if (result.first)
             {
                 if (origin.y - result.second < height)
@@ -806,7 +925,7 @@ bool Collisions::collisionCorrect(Vector3 *refpos, bool envokeScriptCallbacks)
     if (refpos->y > hashtable_height[hash])
         return false;
 
-    collision_tri_t *minctri = 0;
+    int minctri = -1;
     float minctridist = 100.0f;
     Vector3 minctripoint;
 
@@ -899,20 +1018,20 @@ bool Collisions::collisionCorrect(Vector3 *refpos, bool envokeScriptCallbacks)
         else // The element is a triangle
         {
             const int ctri_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
-            collision_tri_t *ctri = &m_collision_tris[ctri_index];
-            if (!ctri->enabled)
+            const collision_tri_hot_t& ctri = m_collision_tris_hot[ctri_index];
+            if (!ctri.enabled)
                 continue;
-            if (!ctri->aab.contains(*refpos))
+            if (!ctri.AabContains(*refpos))
                 continue;
             // check if this tri is minimal
             // transform
-            Vector3 point = ctri->forward * (*refpos-ctri->a);
+            Vector3 point = ctri.ToTriangleSpace(*refpos);
             // test if within tri collision volume (potential cause of bug!)
             if (point.x >= 0 && point.y >= 0 && (point.x + point.y) <= 1.0 && point.z < 0 && point.z > -0.1)
             {
                 if (-point.z < minctridist)
                 {
-                    minctri = ctri;
+                    minctri = ctri_index;
                     minctridist = -point.z;
                     minctripoint = point;
                 }
@@ -924,14 +1043,12 @@ bool Collisions::collisionCorrect(Vector3 *refpos, bool envokeScriptCallbacks)
         clearEventCache();
 
     // process minctri collision
-    if (minctri)
+    if (minctri != -1)
     {
         // we have a contact
         contacted = true;
-        // correct point
-        minctripoint.z = 0;
-        // reverse transform
-        *refpos = (minctri->reverse * minctripoint) + minctri->a;
+        // correct point (project onto the triangle plane) and reverse transform
+        *refpos = m_collision_tris_cold[minctri].FromTriangleSpace(minctripoint.x, minctripoint.y);
     }
     return contacted;
 }
@@ -967,7 +1084,7 @@ bool Collisions::nodeCollision(node_t *node, float dt)
     if (node->AbsPosition.y > hashtable_height[hash])
         return false;
 
-    collision_tri_t *minctri = 0;
+    int minctri = -1;
     float minctridist = 100.0;
     Vector3 minctripoint;
 
@@ -1080,22 +1197,20 @@ bool Collisions::nodeCollision(node_t *node, float dt)
         {
             // tri collision
             const int ctri_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
-            collision_tri_t *ctri = &m_collision_tris[ctri_index];
-            if (!ctri->enabled)
+            const collision_tri_hot_t& ctri = m_collision_tris_hot[ctri_index];
+            if (!ctri.enabled)
                 continue;
-            if (node->AbsPosition.y > ctri->aab.getMaximum().y || node->AbsPosition.y < ctri->aab.getMinimum().y ||
-                node->AbsPosition.x > ctri->aab.getMaximum().x || node->AbsPosition.x < ctri->aab.getMinimum().x ||
-                node->AbsPosition.z > ctri->aab.getMaximum().z || node->AbsPosition.z < ctri->aab.getMinimum().z)
+            if (!ctri.AabContains(node->AbsPosition))
                 continue;
             // check if this tri is minimal
             // transform
-            Vector3 point = ctri->forward * (node->AbsPosition - ctri->a);
+            Vector3 point = ctri.ToTriangleSpace(node->AbsPosition);
             // test if within tri collision volume (potential cause of bug!)
             if (point.x >= 0 && point.y >= 0 && (point.x + point.y) <= 1.0 && point.z < 0 && point.z > -0.1)
             {
                 if (-point.z < minctridist)
                 {
-                    minctri = ctri;
+                    minctri = ctri_index;
                     minctridist = -point.z;
                     minctripoint = point;
                 }
@@ -1104,15 +1219,15 @@ bool Collisions::nodeCollision(node_t *node, float dt)
     }
 
     // process minctri collision
-    if (minctri)
+    if (minctri != -1)
     {
         // we have a contact
         contacted=true;
         // we need the normal
-        // resume repere for the normal
-        Vector3 normal = minctri->reverse * Vector3::UNIT_Z;
-        node->Forces += primitiveCollision(node, node->Velocity, node->mass, normal, dt, minctri->gm);
-        node->nd_last_collision_gm = minctri->gm;
+        const collision_tri_cold_t& ctri_cold = m_collision_tris_cold[minctri];
+        Vector3 normal = ctri_cold.GetNormal();
+        node->Forces += primitiveCollision(node, node->Velocity, node->mass, normal, dt, ctri_cold.gm);
+        node->nd_last_collision_gm = ctri_cold.gm;
     }
 
     return contacted;
@@ -1244,13 +1359,13 @@ bool Collisions::isInside(Ogre::Vector3 pos, collision_box_t *cbox, float border
 
 bool Collisions::groundCollision(node_t *node, float dt)
 {
-    Real v = App::GetGameContext()->GetTerrain()->getHeightAt(node->AbsPosition.x, node->AbsPosition.z);
+    Ogre::Vector3 normal;
+    Real v = App::GetGameContext()->GetTerrain()->GetHeightAndNormalAt(node->AbsPosition.x, node->AbsPosition.z, normal);
     if (v > node->AbsPosition.y)
     {
         ground_model_t* ogm = landuse ? landuse->getGroundModelAt(node->AbsPosition.x, node->AbsPosition.z) : nullptr;
         // when landuse fails or we don't have it, use the default value
         if (!ogm) ogm = defaultgroundgm;
-        Ogre::Vector3 normal = App::GetGameContext()->GetTerrain()->GetNormalAt(node->AbsPosition.x, v, node->AbsPosition.z);
         node->Forces += primitiveCollision(node, node->Velocity, node->mass, normal, dt, ogm, v - node->AbsPosition.y);
         node->nd_last_collision_gm = ogm;
         return true;
@@ -1438,16 +1553,31 @@ void Collisions::createCollisionDebugVisualization(Ogre::SceneNode* root_node, O
     }
 }
 
-void Collisions::addCollisionMesh(Ogre::String const& srcname, Ogre::String const& meshname, Ogre::Vector3 const& pos, Ogre::Quaternion const& q, Ogre::Vector3 const& scale, ground_model_t *gm, std::vector<int> *collTris)
+void Collisions::addCollisionMesh(Ogre::String const& srcname, Ogre::String const& meshname, Ogre::Vector3 const& pos, Ogre::Quaternion const& q, Ogre::Vector3 const& scale, ground_model_t *gm, std::vector<int> *collTris, Ogre::String const& cache_source_file)
 {
-    Entity *ent = App::GetGfxScene()->GetSceneManager()->createEntity(meshname);
-    ent->setMaterialName("tracks/debug/collision/mesh");
-
     if (!gm)
     {
         gm = getGroundModelByString("concrete");
     }
 
+    std::string cache_key;
+    if (!cache_source_file.empty() && m_mesh_cache)
+    {
+        // Editing the defining file or the mesh makes the key differ, so the entry is rebuilt rather than reused.
+        const std::string source_stamp = m_mesh_cache->GetResourceStamp(cache_source_file) + "|" + m_mesh_cache->GetResourceStamp(meshname);
+        cache_key = CollisionMeshCache::MakeMeshKey(meshname, source_stamp, pos, q, scale);
+        CachedCollisionMesh cached;
+        if (m_mesh_cache->FindMesh(cache_key, cached))
+        {
+            this->addCachedCollisionMesh(srcname, meshname, pos, q, scale, gm, collTris, cached);
+            m_mesh_cache->AddItemToSave(cache_key, (int)m_collision_meshes.size() - 1, /*cache_miss:*/false);
+            return;
+        }
+    }
+
+    Entity *ent = App::GetGfxScene()->GetSceneManager()->createEntity(meshname);
+    ent->setMaterialName("tracks/debug/collision/mesh");
+
     // Analyze the mesh
     size_t vertex_count,index_count;
     Vector3* vertices;
@@ -1456,7 +1586,7 @@ void Collisions::addCollisionMesh(Ogre::String const& srcname, Ogre::String cons
     getMeshInformation(ent->getMesh().get(),vertex_count,vertices,index_count,indices, pos, q, scale);
 
     // Generate collision triangles
-    int collision_tri_start = (int)m_collision_tris.size();
+    int collision_tri_start = (int)m_collision_tris_hot.size();
     for (int i=0; i<(int)index_count/3; i++)
     {
         int triID = addCollisionTri(vertices[indices[i*3]], vertices[indices[i*3+1]], vertices[indices[i*3+2]], gm);
@@ -1475,16 +1605,77 @@ void Collisions::addCollisionMesh(Ogre::String const& srcname, Ogre::String cons
     rec.num_verts = vertex_count;
     rec.num_indices = index_count;
     rec.collision_tri_start = collision_tri_start;
-    rec.collision_tri_count = (int)m_collision_tris.size() - collision_tri_start;
+    rec.collision_tri_count = (int)m_collision_tris_hot.size() - collision_tri_start;
     rec.bounding_box = ent->getMesh()->getBounds();
     m_collision_meshes.push_back(rec);
 
+    if (!cache_key.empty())
+    {
+        m_mesh_cache->AddItemToSave(cache_key, (int)m_collision_meshes.size() - 1, /*cache_miss:*/true);
+    }
+
     // Clean up
     delete[] vertices;
     delete[] indices;
     App::GetGfxScene()->GetSceneManager()->destroyEntity(ent);
 }
 
+void Collisions::addCachedCollisionMesh(Ogre::String const& srcname, Ogre::String const& meshname, Ogre::Vector3 const& pos, Ogre::Quaternion const& q, Ogre::Vector3 const& scale, ground_model_t* gm, std::vector<int>* collTris, CachedCollisionMesh const& cached)
+{
+    // The triangles are stored pre-transformed, only the hashtable (which depends on load order) is rebuilt.
+    const int collision_tri_start = (int)m_collision_tris_hot.size();
+    m_collision_tris_hot.resize(collision_tri_start + cached.num_tris);
+    m_collision_tris_cold.resize(collision_tri_start + cached.num_tris);
+    if (cached.num_tris > 0)
+    {
+        std::memcpy(&m_collision_tris_hot[collision_tri_start], cached.tris_hot, cached.num_tris * sizeof(collision_tri_hot_t));
+    }
+
+    for (int i = 0; i < (int)cached.num_tris; i++)
+    {
+        collision_tri_cold_t& tri_cold = m_collision_tris_cold[collision_tri_start + i];
+        const char* tri_verts = cached.tris_verts + (i * 3 * sizeof(Vector3));
+        std::memcpy(&tri_cold.a, tri_verts,                       sizeof(Vector3));
+        std::memcpy(&tri_cold.b, tri_verts + sizeof(Vector3),     sizeof(Vector3));
+        std::memcpy(&tri_cold.c, tri_verts + 2 * sizeof(Vector3), sizeof(Vector3));
+        tri_cold.gm = gm;
+        m_collision_tris_hot[collision_tri_start + i].enabled = true;
+
+        this->registerCollisionTri(collision_tri_start + i);
+        if (collTris)
+            collTris->push_back(collision_tri_start + i);
+    }
+
+    // Submit the mesh record
+    collision_mesh_t rec;
+    rec.mesh_name = meshname;
+    rec.source_name = srcname;
+    rec.position = pos;
+    rec.orientation = q;
+    rec.scale = scale;
+    rec.ground_model = gm;
+    rec.num_verts = (int)cached.num_verts;
+    rec.num_indices = (int)cached.num_indices;
+    rec.collision_tri_start = collision_tri_start;
+    rec.collision_tri_count = (int)cached.num_tris;
+    rec.bounding_box = cached.bounding_box;
+    m_collision_meshes.push_back(rec);
+}
+
+void Collisions::setupCollisionMeshCache(std::string const& filename, std::string const& terrain_key)
+{
+    m_mesh_cache = std::unique_ptr<CollisionMeshCache>(new CollisionMeshCache(filename, terrain_key));
+    CollisionMeshCache::ResultCode result = m_mesh_cache->LoadFile();
+    if (result == CollisionMeshCache::RESULT_CODE_OK)
+    {
+        LOG("[RoR|Collisions] Loaded collision mesh cache: " + filename);
+    }
+    else if (result != CollisionMeshCache::RESULT_CODE_ERR_FOPEN_FAILED)
+    {
+        LOG(fmt::format("[RoR|Collisions] Collision mesh cache '{}' is outdated or invalid (code {}), it will be rebuilt", filename, (int)result));
+    }
+}
+
 void Collisions::registerCollisionMesh(Ogre::String const& srcname, Ogre::String const& meshname, Ogre::Vector3 const& pos, AxisAlignedBox bounding_box, ground_model_t* gm, int ctri_start, int ctri_count)
 {
     // Submit the mesh record
@@ -1617,4 +1808,19 @@ void Collisions::getMeshInformation(Mesh* mesh,size_t &vertex_count,Ogre::Vector
 
 void Collisions::finishLoadingTerrain()
 {
+    if (m_mesh_cache)
+    {
+        // Objects spawned later (i.e. by scripts during simulation) are not cached.
+        LOG(fmt::format("[RoR|Collisions] Collision mesh cache: {} hits, {} misses",
+            m_mesh_cache->GetNumHits(), m_mesh_cache->GetNumMisses()));
+        if (m_mesh_cache->IsModified())
+        {
+            CollisionMeshCache::ResultCode result = m_mesh_cache->SaveFile(m_collision_tris_hot, m_collision_tris_cold, m_collision_meshes);
+            if (result != CollisionMeshCache::RESULT_CODE_OK)
+            {
+                LOG(fmt::format("[RoR|Collisions] Failed to write collision mesh cache '{}' (code {})", m_mesh_cache->GetFilename(), (int)result));
+            }
+        }
+        m_mesh_cache.reset();
+    }
 }
@@ -25,6 +25,7 @@
 #include "Application.h"
 #include "SimData.h" // for collision_box_t
 
+#include <memory>
 #include <mutex>
 #include <Ogre.h>
 #include <string>
@@ -47,18 +48,40 @@ struct eventsource_t //!< Scripting
     bool              es_enabled;
 };
 
-struct collision_tri_t
+/// Hot part of a static collision triangle: only what the per-node intersection test reads.
+/// Kept in a separate array from `collision_tri_cold_t` so the hot loop in `Collisions::nodeCollision()` streams ~half the memory.
+struct collision_tri_hot_t
+{
+    Ogre::Vector3 a;         //!< First vertex; origin of the triangle space
+    Ogre::Matrix3 forward;   //!< World -> triangle space (X/Y = barycentric coords along edges AB/AC, Z = distance along unit normal)
+    Ogre::Vector3 aab_min;   //!< Bounding box, padded by 0.1m
+    Ogre::Vector3 aab_max;
+    bool enabled;
+
+    bool AabContains(Ogre::Vector3 const& pos) const
+    {
+        return pos.x >= aab_min.x && pos.y >= aab_min.y && pos.z >= aab_min.z &&
+               pos.x <= aab_max.x && pos.y <= aab_max.y && pos.z <= aab_max.z;
+    }
+
+    Ogre::Vector3 ToTriangleSpace(Ogre::Vector3 const& pos) const { return forward * (pos - a); }
+};
+typedef std::vector<collision_tri_hot_t> CollisionTriHotVec;
+
+/// Cold part of a static collision triangle: only needed on contact, for raycasts and for diagnostics.
+struct collision_tri_cold_t
 {
     Ogre::Vector3 a;
     Ogre::Vector3 b;
     Ogre::Vector3 c;
-    Ogre::AxisAlignedBox aab;
-    Ogre::Matrix3 forward;
-    Ogre::Matrix3 reverse;
     ground_model_t* gm;
-    bool enabled;
+
+    Ogre::Vector3 GetNormal() const { return (b - a).crossProduct(c - a).normalisedCopy(); }
+
+    /// Triangle space -> world, for a point on the triangle plane.
+    Ogre::Vector3 FromTriangleSpace(float u, float v) const { return a + (b - a) * u + (c - a) * v; }
 };
-typedef std::vector<collision_tri_t> CollisionTriVec;
+typedef std::vector<collision_tri_cold_t> CollisionTriColdVec;
 
 /// Records which collision triangles belong to which mesh.
 struct collision_mesh_t
@@ -77,12 +100,26 @@ struct collision_mesh_t
 };
 typedef std::vector<collision_mesh_t> CollisionMeshVec;
 
+class CollisionMeshCache;
+struct CachedCollisionMesh;
+
 class Collisions
 {
 public:
 
     typedef std::vector<collision_box_t> CollisionBoxVec;
 
+    /// Targets of `intersectsBatch()`
+    enum RaycastTargets
+    {
+        RAYCAST_TRIS    = BITMASK(1),
+        RAYCAST_BOXES   = BITMASK(2),
+        RAYCAST_TERRAIN = BITMASK(3),
+        RAYCAST_ALL     = RAYCAST_TRIS | RAYCAST_BOXES | RAYCAST_TERRAIN
+    };
+
+    typedef std::pair<bool, Ogre::Real> RaycastResult;
+
     enum SurfaceType
     {
         FX_NONE,
@@ -113,7 +150,7 @@ private:
         unsigned int cell_id;
 
         /// Values below ELEMENT_TRI_BASE_INDEX are collision box indices (Collisions::m_collision_boxes),
-        ///    values above are collision tri indices (Collisions::m_collision_tris).
+        ///    values above are collision tri indices (Collisions::m_collision_tris_hot + m_collision_tris_cold).
         int element_index;
     };
 
@@ -132,12 +169,15 @@ private:
     CollisionBoxVec m_collision_boxes; // Formerly MAX_COLLISION_BOXES = 5000
     std::vector<collision_box_t*> m_last_called_cboxes; // Only used for character, actors have their own cache `Actor::m_active_eventboxes`
 
-    // collision tris pool
-    CollisionTriVec m_collision_tris; // Formerly MAX_COLLISION_TRIS = 100000
+    // collision tris pool, split into hot/cold arrays with identical indexing
+    CollisionTriHotVec m_collision_tris_hot; // Formerly MAX_COLLISION_TRIS = 100000
+    CollisionTriColdVec m_collision_tris_cold;
     CollisionMeshVec m_collision_meshes; // For diagnostics/editing only.
 
     Ogre::AxisAlignedBox m_collision_aab; // Tight bounding box around all collision meshes
 
+    std::unique_ptr<CollisionMeshCache> m_mesh_cache; // Only exists while loading terrain, see `setupCollisionMeshCache()`
+
     // collision hashtable
     std::array<float, HASH_SIZE> hashtable_height;
     std::vector<hash_coll_element_t> hashtable[HASH_SIZE];
@@ -158,7 +198,12 @@ private:
     const Ogre::Vector3 m_terrain_size;
 
     void hash_add(int cell_x, int cell_z, int value, float h);
+    void registerCollisionTri(int tri_index); //!< Adds an already stored tri to the hashtable and `m_collision_aab`
+    void addCachedCollisionMesh(Ogre::String const& srcname, Ogre::String const& meshname, Ogre::Vector3 const& pos, Ogre::Quaternion const& q, Ogre::Vector3 const& scale, ground_model_t* gm, std::vector<int>* collTris, CachedCollisionMesh const& cached);
     int hash_find(int cell_x, int cell_z); /// Returns index to 'hashtable'
+    /// Walks the cells crossed by the ray (exact 2D DDA on the X/Z grid) in order, up to the length of the direction vector.
+    /// Calls `visitor(hash, t_exit)` for each 'hashtable' entry which the ray doesn't pass above; stops when it returns true.
+    template <typename VisitorT> void forEachHashOnRay(Ogre::Ray const& ray, VisitorT visitor);
     unsigned int hashfunc(unsigned int cellid);
     void parseGroundConfig(Ogre::ConfigFile* cfg, Ogre::String groundModel = "");
 
@@ -178,8 +223,26 @@ public:
     collision_box_t* getBox(const Ogre::String& inst, const Ogre::String& box);
     const int GetCellSize() const { return CELL_SIZE; }
 
+    /**
+     * Checks whether a Ray intersects a collision triangle. Intersection tests are only performed for the length of the direction vector of the ray.
+     * @return Pair of whether an intersection was found and the distance to the nearest intersection, in the ray's direction vector's unit.
+     */
     std::pair<bool, Ogre::Real> intersectsTris(Ogre::Ray ray);
 
+    /**
+     * Checks whether a Ray intersects a solid (non-virtual) collision box, looked up in the collision hashtable. Intersection tests are only performed for the length of the direction vector of the ray.
+     * @param skip_margin Boxes closer than this to the end of the ray are skipped (i.e. boxes enclosing a sound source); negative = skip none.
+     * @return Pair of whether an intersection was found and the distance to the nearest intersection, in the ray's direction vector's unit.
+     */
+    std::pair<bool, Ogre::Real> intersectsBoxes(Ogre::Ray ray, float skip_margin = -1.f);
+
+    /**
+     * Casts many rays at once, spread over the thread pool. Each ray behaves like in the single-ray functions above.
+     * @param targets Combination of `RaycastTargets`; the nearest intersection among them is reported.
+     * @param out_results Resized to match `rays`.
+     */
+    void intersectsBatch(std::vector<Ogre::Ray> const& rays, int targets, std::vector<RaycastResult>& out_results);
+
     /**
      * Checks whether a Ray intersects the terrain. Intersection tests are only performed for the length of the direction vector of the ray.
      * @param ray The ray that is checked for an intersection with the terrain.
@@ -200,7 +263,8 @@ public:
     void finishLoadingTerrain();
 
     int addCollisionBox(bool rotating, bool virt, Ogre::Vector3 pos, Ogre::Vector3 rot, Ogre::Vector3 l, Ogre::Vector3 h, Ogre::Vector3 sr, const Ogre::String& eventname, const Ogre::String& instancename, const Ogre::String& reverb_preset_name, bool forcecam, Ogre::Vector3 campos, Ogre::Vector3 sc = Ogre::Vector3::UNIT_SCALE, Ogre::Vector3 dr = Ogre::Vector3::ZERO, CollisionEventFilter event_filter = EVENT_ALL, int scripthandler = -1);
-    void addCollisionMesh(Ogre::String const& srcname, Ogre::String const& meshname, Ogre::Vector3 const& pos, Ogre::Quaternion const& q, Ogre::Vector3 const& scale, ground_model_t* gm = 0, std::vector<int>* collTris = 0); //!< generate collision tris from existing mesh resource
+    void addCollisionMesh(Ogre::String const& srcname, Ogre::String const& meshname, Ogre::Vector3 const& pos, Ogre::Quaternion const& q, Ogre::Vector3 const& scale, ground_model_t* gm = 0, std::vector<int>* collTris = 0, Ogre::String const& cache_source_file = ""); //!< generate collision tris from existing mesh resource; `cache_source_file` = file which defines the mesh (i.e. ODef), enables the cache.
+    void setupCollisionMeshCache(std::string const& filename, std::string const& terrain_key); //!< Enables persisted tris for `addCollisionMesh()` with `cache_source_file` until `finishLoadingTerrain()`
     void registerCollisionMesh(Ogre::String const& srcname, Ogre::String const& meshname, Ogre::Vector3 const& pos, Ogre::AxisAlignedBox bounding_box, ground_model_t* gm, int ctri_start, int ctri_count); //!< Mark already generated collision tris as belonging to (virtual) mesh.
     int addCollisionTri(Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, ground_model_t* gm);
     void createCollisionDebugVisualization(Ogre::SceneNode* root_node, Ogre::AxisAlignedBox const& area_limit, std::vector<Ogre::SceneNode*>& out_nodes);
@@ -225,7 +289,7 @@ public:
     eventsource_t & getEventSource(int pos) { ROR_ASSERT(pos < free_eventsource); return eventsources[pos]; }
     CollisionBoxVec const& getCollisionBoxes() const { return m_collision_boxes; }
     CollisionMeshVec const& getCollisionMeshes() const { return m_collision_meshes; }
-    CollisionTriVec const& getCollisionTriangles() const { return m_collision_tris; }
+    CollisionTriColdVec const& getCollisionTriangles() const { return m_collision_tris_cold; }
 };
 
 Ogre::Vector3 primitiveCollision(node_t* node, Ogre::Vector3 velocity, float mass, Ogre::Vector3 normal, float dt, ground_model_t* gm, float penetration = 0);
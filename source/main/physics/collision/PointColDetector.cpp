@@ -33,8 +33,8 @@ void PointColDetector::UpdateIntraPoint(bool contactables)
 
     if (contacters_size != m_object_list_size)
     {
-        m_collision_partners.clear();
-        m_collision_partners.push_back(m_actor->ar_instance_id);
+        m_collision_partners.assign(1, m_actor->ar_instance_id);
+        m_collision_partners_linked.assign(1, false);
         m_object_list_size = contacters_size;
         update_structures_for_contacters(contactables);
     }
@@ -51,14 +51,17 @@ void PointColDetector::UpdateIntraPoint(bool contactables)
 void PointColDetector::UpdateInterPoint(bool ignorestate)
 {
     int contacters_size = 0;
-    std::vector<ActorInstanceID_t> collision_partners;
+    m_partner_candidates.clear();
+    m_partner_candidates_linked.clear();
     for (ActorPtr& actor : App::GetGameContext()->GetActorManager()->GetActors())
     {
         if (actor != m_actor && (ignorestate || actor->ar_update_physics) &&
                 m_actor->ar_bounding_box.intersects(actor->ar_bounding_box))
         {
-            collision_partners.push_back(actor->ar_instance_id);
-            bool is_linked = std::find(m_actor->ar_linked_actors.begin(), m_actor->ar_linked_actors.end(), actor) != m_actor->ar_linked_actors.end();
+            const size_t id = static_cast<size_t>(actor->ar_instance_id);
+            const bool is_linked = id < m_actor->ar_linked_actor_flags.size() && m_actor->ar_linked_actor_flags[id];
+            m_partner_candidates.push_back(actor->ar_instance_id);
+            m_partner_candidates_linked.push_back(is_linked);
             contacters_size += is_linked ? actor->ar_num_contacters : actor->ar_num_contactable_nodes;
             if (m_actor->ar_nodes[0].Velocity.squaredDistance(actor->ar_nodes[0].Velocity) > 16)
             {
@@ -78,9 +81,12 @@ void PointColDetector::UpdateInterPoint(bool ignorestate)
 
     m_actor->ar_collision_relevant = (contacters_size > 0);
 
-    if (collision_partners != m_collision_partners || contacters_size != m_object_list_size)
+    // Usually the partners don't change between updates - then only the cached positions are refreshed.
+    if (m_partner_candidates != m_collision_partners || m_partner_candidates_linked != m_collision_partners_linked
+        || contacters_size != m_object_list_size)
     {
-        m_collision_partners = collision_partners;
+        std::swap(m_collision_partners, m_partner_candidates);
+        std::swap(m_collision_partners_linked, m_partner_candidates_linked);
         m_object_list_size = contacters_size;
         update_structures_for_contacters(false);
     }
@@ -98,15 +104,16 @@ void PointColDetector::update_structures_for_contacters(bool ignoreinternal)
 {
     m_ref_list.resize(m_object_list_size);
     hit_pointid_list.resize(m_object_list_size);
+    m_point_positions.resize(m_object_list_size);
 
     // Insert all contacters into the list of points to consider when building the kdtree
     int refi = 0;
-    for (ActorInstanceID_t actorid : m_collision_partners)
+    for (size_t p = 0; p < m_collision_partners.size(); p++)
     {
+        const ActorInstanceID_t actorid = m_collision_partners[p];
         const ActorPtr& actor = App::GetGameContext()->GetActorManager()->GetActorById(actorid);
 
-        bool is_linked = std::find(m_actor->ar_linked_actors.begin(), m_actor->ar_linked_actors.end(), actor) != m_actor->ar_linked_actors.end();
-        bool internal_collision = !ignoreinternal && ((actorid == m_actor->ar_instance_id) || is_linked);
+        bool internal_collision = !ignoreinternal && ((actorid == m_actor->ar_instance_id) || m_collision_partners_linked[p]);
         for (int i = 0; i < actor->ar_num_nodes; i++)
         {
             if (actor->ar_nodes[i].nd_contacter || (!internal_collision && actor->ar_nodes[i].nd_contactable))
@@ -115,6 +122,7 @@ void PointColDetector::update_structures_for_contacters(bool ignoreinternal)
                 hit_pointid_list[refi].nodenum = static_cast<NodeNum_t>(i);
                 m_ref_list[refi].pidrefid = refi;
                 m_ref_list[refi].setPoint(actor->ar_nodes[i].AbsPosition);
+                m_point_positions[refi] = &actor->ar_nodes[i].AbsPosition;
                 refi++;
             }
         }
@@ -342,17 +350,11 @@ void PointColDetector::partintwo(const int start, const int median, const int en
 void PointColDetector::refresh_node_positions()
 {
     // Because the reflist contains cached node positions, we must update it on each tick.
-    // To avoid repeated lookup in actormanager, we loop actors first.
+    // The node pointers stay valid as long as the partners do - any change rebuilds them, see `update_structures_for_contacters()`.
     // ----------------------------------------------------------------------------------
 
-    for (ActorPtr& actor: App::GetGameContext()->GetActorManager()->GetActors())
+    for (refelem_t& refelem: m_ref_list)
     {
-        for (refelem_t& refelem: m_ref_list)
-        {
-            if (hit_pointid_list[refelem.pidrefid].actorid == actor->ar_instance_id)
-            {
-                refelem.setPoint(actor->ar_nodes[hit_pointid_list[refelem.pidrefid].nodenum].AbsPosition);
-            }
-        }
+        refelem.setPoint(*m_point_positions[refelem.pidrefid]);
     }
 }
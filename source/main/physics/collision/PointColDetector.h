@@ -70,7 +70,11 @@ private:
 
     ActorPtr                 m_actor;
     std::vector<ActorInstanceID_t>    m_collision_partners; //!< IntraPoint: always just owning actor; InterPoint: all colliding actors
+    std::vector<bool>      m_collision_partners_linked; //!< Same offsets as `m_collision_partners`; linked actors only collide with contacters
+    std::vector<ActorInstanceID_t>    m_partner_candidates; //!< InterPoint: scratch buffer, reused every update to avoid allocations
+    std::vector<bool>      m_partner_candidates_linked;
     std::vector<refelem_t> m_ref_list;
+    std::vector<const Ogre::Vector3*> m_point_positions; //!< Node AbsPosition per point, indexed by `PointidID_t`; valid until partners change
     
     std::vector<kdnode_t>  m_kdtree;
     Ogre::Vector3          m_bbmin = Ogre::Vector3::ZERO;
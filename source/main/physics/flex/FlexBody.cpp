@@ -31,10 +31,95 @@
 #include "RigDef_File.h"
 
 #include <Ogre.h>
+#include <algorithm>
+#include <cfloat>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define FLEXBODY_USE_SSE
+#   include <emmintrin.h>
+#endif
 
 using namespace Ogre;
 using namespace RoR;
 
+namespace {
+
+/// Deforms one locator group: `pos = diffX*c.x + diffY*c.y + nCross*c.z + origin`, normals likewise (then normalised).
+/// Results are scattered to the (original) vertex order, which the vertex buffers need.
+#ifdef FLEXBODY_USE_SSE
+void ComputeLocatorGroup(
+    Vector3 const& diffX, Vector3 const& diffY, Vector3 const& nCross, Vector3 const& origin,
+    const float* cx, const float* cy, const float* cz,
+    const float* snx, const float* sny, const float* snz,
+    const uint32_t* vert_index, uint32_t count, Vector3* dst_pos, Vector3* dst_normals)
+{
+    const __m128 dx_x = _mm_set1_ps(diffX.x),  dx_y = _mm_set1_ps(diffX.y),  dx_z = _mm_set1_ps(diffX.z);
+    const __m128 dy_x = _mm_set1_ps(diffY.x),  dy_y = _mm_set1_ps(diffY.y),  dy_z = _mm_set1_ps(diffY.z);
+    const __m128 nc_x = _mm_set1_ps(nCross.x), nc_y = _mm_set1_ps(nCross.y), nc_z = _mm_set1_ps(nCross.z);
+    const __m128 or_x = _mm_set1_ps(origin.x), or_y = _mm_set1_ps(origin.y), or_z = _mm_set1_ps(origin.z);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 three_halves = _mm_set1_ps(1.5f);
+    const __m128 min_len2 = _mm_set1_ps(FLT_MIN);
+
+    // The SoA block is padded, so 4 lanes can always be loaded; only the valid lanes are stored.
+    for (uint32_t i = 0; i < count; i += 4)
+    {
+        __m128 c_x = _mm_loadu_ps(cx + i), c_y = _mm_loadu_ps(cy + i), c_z = _mm_loadu_ps(cz + i);
+        __m128 p_x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx_x, c_x), _mm_mul_ps(dy_x, c_y)), _mm_add_ps(_mm_mul_ps(nc_x, c_z), or_x));
+        __m128 p_y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx_y, c_x), _mm_mul_ps(dy_y, c_y)), _mm_add_ps(_mm_mul_ps(nc_y, c_z), or_y));
+        __m128 p_z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx_z, c_x), _mm_mul_ps(dy_z, c_y)), _mm_add_ps(_mm_mul_ps(nc_z, c_z), or_z));
+
+        __m128 s_x = _mm_loadu_ps(snx + i), s_y = _mm_loadu_ps(sny + i), s_z = _mm_loadu_ps(snz + i);
+        __m128 n_x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx_x, s_x), _mm_mul_ps(dy_x, s_y)), _mm_mul_ps(nc_x, s_z));
+        __m128 n_y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx_y, s_x), _mm_mul_ps(dy_y, s_y)), _mm_mul_ps(nc_y, s_z));
+        __m128 n_z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx_z, s_x), _mm_mul_ps(dy_z, s_y)), _mm_mul_ps(nc_z, s_z));
+
+        // Approximate rsqrt (`_mm_rsqrt_ps`) + one Newton-Raphson step; more precise than `fast_normalise()`,
+        // which refines a coarser initial guess with the same single step.
+        __m128 len2 = _mm_max_ps(min_len2, _mm_add_ps(_mm_add_ps(_mm_mul_ps(n_x, n_x), _mm_mul_ps(n_y, n_y)), _mm_mul_ps(n_z, n_z)));
+        __m128 inv = _mm_rsqrt_ps(len2);
+        inv = _mm_mul_ps(inv, _mm_sub_ps(three_halves, _mm_mul_ps(_mm_mul_ps(half, len2), _mm_mul_ps(inv, inv))));
+        n_x = _mm_mul_ps(n_x, inv);
+        n_y = _mm_mul_ps(n_y, inv);
+        n_z = _mm_mul_ps(n_z, inv);
+
+        // Transpose to one vertex per register
+        __m128 p_w = _mm_setzero_ps();
+        __m128 n_w = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(p_x, p_y, p_z, p_w);
+        _MM_TRANSPOSE4_PS(n_x, n_y, n_z, n_w);
+        float pos[4][4];
+        float nrm[4][4];
+        _mm_storeu_ps(pos[0], p_x); _mm_storeu_ps(pos[1], p_y); _mm_storeu_ps(pos[2], p_z); _mm_storeu_ps(pos[3], p_w);
+        _mm_storeu_ps(nrm[0], n_x); _mm_storeu_ps(nrm[1], n_y); _mm_storeu_ps(nrm[2], n_z); _mm_storeu_ps(nrm[3], n_w);
+
+        const uint32_t num_lanes = std::min(4u, count - i);
+        for (uint32_t lane = 0; lane < num_lanes; ++lane)
+        {
+            const uint32_t vert = vert_index[i + lane];
+            dst_pos[vert] = Vector3(pos[lane][0], pos[lane][1], pos[lane][2]);
+            dst_normals[vert] = Vector3(nrm[lane][0], nrm[lane][1], nrm[lane][2]);
+        }
+    }
+}
+#else // FLEXBODY_USE_SSE
+void ComputeLocatorGroup(
+    Vector3 const& diffX, Vector3 const& diffY, Vector3 const& nCross, Vector3 const& origin,
+    const float* cx, const float* cy, const float* cz,
+    const float* snx, const float* sny, const float* snz,
+    const uint32_t* vert_index, uint32_t count, Vector3* dst_pos, Vector3* dst_normals)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const uint32_t vert = vert_index[i];
+        dst_pos[vert] = diffX * cx[i] + diffY * cy[i] + nCross * cz[i] + origin;
+        dst_normals[vert] = fast_normalise(diffX * snx[i] + diffY * sny[i] + nCross * snz[i]);
+    }
+}
+#endif // FLEXBODY_USE_SSE
+
+} // namespace
+
 FlexBody::FlexBody(
     RoR::FlexBodyCacheData* preloaded_from_cache,
     RoR::GfxActor* gfx_actor,
@@ -534,6 +619,8 @@ FlexBody::FlexBody(
     {
         this->defragmentFlexbodyMesh();
     }
+
+    this->buildLocatorGroups(); // Must be done after defragmentation, which reorders locators
 }
 
 FlexBody::FlexBody(PlaceholderType p_type, FlexbodyID_t id, const std::string& orig_meshname)
@@ -617,45 +704,159 @@ void FlexBody::setFlexbodyCastShadow(bool val)
         m_scene_entity->setCastShadows(val);
 }
 
-void FlexBody::computeFlexbody()
+Ogre::Vector3 FlexBody::calcFlexitCenter(RoR::NodeSB* nodes) const
 {
-    if (m_has_texture_blend) updateBlend();
-
-    RoR::NodeSB* nodes = m_gfx_actor->GetSimNodeBuffer();
-
-    // compute the local center
     if (m_node_center >= 0)
     {
         Vector3 diffX = nodes[m_node_x].AbsPosition - nodes[m_node_center].AbsPosition;
         Vector3 diffY = nodes[m_node_y].AbsPosition - nodes[m_node_center].AbsPosition;
         Ogre::Vector3 flexit_normal = fast_normalise(diffY.crossProduct(diffX));
 
-        m_flexit_center = nodes[m_node_center].AbsPosition + m_center_offset.x * diffX + m_center_offset.y * diffY;
-        m_flexit_center += m_center_offset.z * flexit_normal;
+        Ogre::Vector3 center = nodes[m_node_center].AbsPosition + m_center_offset.x * diffX + m_center_offset.y * diffY;
+        center += m_center_offset.z * flexit_normal;
+        return center;
     }
     else
     {
-        m_flexit_center = nodes[0].AbsPosition;
+        return nodes[0].AbsPosition;
     }
+}
 
-    for (int i=0; i<(int)m_vertex_count; i++)
+bool FlexBody::hasMovedSinceLastCompute(float epsilon) const
+{
+    if (m_deform_node_positions.empty())
     {
-        Vector3 diffX = nodes[m_locators[i].nx].AbsPosition - nodes[m_locators[i].ref].AbsPosition;
-        Vector3 diffY = nodes[m_locators[i].ny].AbsPosition - nodes[m_locators[i].ref].AbsPosition;
-        Vector3 nCross = fast_normalise(diffX.crossProduct(diffY)); //nCross.normalise();
+        return true; // Never computed
+    }
 
-        m_dst_pos[i].x = diffX.x * m_locators[i].coords.x + diffY.x * m_locators[i].coords.y + nCross.x * m_locators[i].coords.z;
-        m_dst_pos[i].y = diffX.y * m_locators[i].coords.x + diffY.y * m_locators[i].coords.y + nCross.y * m_locators[i].coords.z;
-        m_dst_pos[i].z = diffX.z * m_locators[i].coords.x + diffY.z * m_locators[i].coords.y + nCross.z * m_locators[i].coords.z;
+    RoR::NodeSB* nodes = m_gfx_actor->GetSimNodeBuffer();
+    const float epsilon_sq = epsilon * epsilon;
+    for (size_t i = 0; i < m_deform_nodes.size(); i++)
+    {
+        if (nodes[m_deform_nodes[i]].AbsPosition.squaredDistance(m_deform_node_positions[i]) > epsilon_sq)
+        {
+            return true;
+        }
+    }
+    return false;
+}
 
-        m_dst_pos[i] += nodes[m_locators[i].ref].AbsPosition - m_flexit_center;
+void FlexBody::followFlexitCenter()
+{
+    if (!m_scene_node) // Disabled via addonpart/tuneup
+        return;
+
+    // Vertices are relative to the center from last `computeFlexbody()`
+    m_scene_node->setPosition(this->calcFlexitCenter(m_gfx_actor->GetSimNodeBuffer()));
+}
+
+void FlexBody::computeFlexbody()
+{
+    if (m_has_texture_blend) updateBlend();
 
-        m_dst_normals[i].x = diffX.x * m_src_normals[i].x + diffY.x * m_src_normals[i].y + nCross.x * m_src_normals[i].z;
-        m_dst_normals[i].y = diffX.y * m_src_normals[i].x + diffY.y * m_src_normals[i].y + nCross.y * m_src_normals[i].z;
-        m_dst_normals[i].z = diffX.z * m_src_normals[i].x + diffY.z * m_src_normals[i].y + nCross.z * m_src_normals[i].z;
+    RoR::NodeSB* nodes = m_gfx_actor->GetSimNodeBuffer();
+
+    // compute the local center
+    m_flexit_center = this->calcFlexitCenter(nodes);
 
-        m_dst_normals[i] = fast_normalise(m_dst_normals[i]);
+    // Remember node positions for `hasMovedSinceLastCompute()`
+    m_deform_node_positions.resize(m_deform_nodes.size());
+    for (size_t i = 0; i < m_deform_nodes.size(); i++)
+    {
+        m_deform_node_positions[i] = nodes[m_deform_nodes[i]].AbsPosition;
+    }
+
+    for (LocatorGroup const& group: m_locator_groups)
+    {
+        const Vector3 ref_pos = nodes[group.ref].AbsPosition;
+        const Vector3 diffX = nodes[group.nx].AbsPosition - ref_pos;
+        const Vector3 diffY = nodes[group.ny].AbsPosition - ref_pos;
+        const Vector3 nCross = fast_normalise(diffX.crossProduct(diffY));
+        const uint32_t s = group.soa_start;
+
+        ComputeLocatorGroup(diffX, diffY, nCross, ref_pos - m_flexit_center,
+            &m_soa_coords[0][s], &m_soa_coords[1][s], &m_soa_coords[2][s],
+            &m_soa_normals[0][s], &m_soa_normals[1][s], &m_soa_normals[2][s],
+            &m_soa_vert_index[s], group.count, m_dst_pos, m_dst_normals);
+    }
+
+    m_vertices_changed = true;
+}
+
+void FlexBody::buildLocatorGroups()
+{
+    // Sort vertices by their locator nodes, stable to keep memory order within a group
+    std::vector<uint32_t> order(m_vertex_count);
+    for (uint32_t i = 0; i < (uint32_t)m_vertex_count; i++)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+        {
+            Locator_t const& la = m_locators[a];
+            Locator_t const& lb = m_locators[b];
+            if (la.ref != lb.ref) { return la.ref < lb.ref; }
+            if (la.nx != lb.nx)   { return la.nx < lb.nx; }
+            return la.ny < lb.ny;
+        });
+
+    m_locator_groups.clear();
+    for (uint32_t vert: order)
+    {
+        Locator_t const& loc = m_locators[vert];
+        if (m_locator_groups.empty() || m_locator_groups.back().ref != loc.ref
+            || m_locator_groups.back().nx != loc.nx || m_locator_groups.back().ny != loc.ny)
+        {
+            LocatorGroup group;
+            group.ref = loc.ref;
+            group.nx = loc.nx;
+            group.ny = loc.ny;
+            group.soa_start = (m_locator_groups.empty()) ? 0
+                : m_locator_groups.back().soa_start + ((m_locator_groups.back().count + 3) & ~3u);
+            m_locator_groups.push_back(group);
+        }
+        m_locator_groups.back().count++;
+    }
+
+    const size_t soa_size = (m_locator_groups.empty()) ? 0
+        : m_locator_groups.back().soa_start + ((m_locator_groups.back().count + 3) & ~3u);
+    for (int i = 0; i < 3; i++)
+    {
+        m_soa_coords[i].assign(soa_size, 0.f);
+        m_soa_normals[i].assign(soa_size, 0.f);
+    }
+    m_soa_vert_index.assign(soa_size, 0);
+
+    size_t pos = 0;
+    for (LocatorGroup const& group: m_locator_groups)
+    {
+        for (uint32_t i = 0; i < group.count; i++)
+        {
+            const uint32_t vert = order[pos++];
+            const uint32_t s = group.soa_start + i;
+            for (int axis = 0; axis < 3; axis++)
+            {
+                m_soa_coords[axis][s] = m_locators[vert].coords[axis];
+                m_soa_normals[axis][s] = m_src_normals[vert][axis];
+            }
+            m_soa_vert_index[s] = vert;
+        }
     }
+
+    // Nodes which affect the deformation, for `hasMovedSinceLastCompute()`
+    m_deform_nodes.clear();
+    m_deform_nodes.push_back(m_node_center);
+    m_deform_nodes.push_back(m_node_x);
+    m_deform_nodes.push_back(m_node_y);
+    for (LocatorGroup const& group: m_locator_groups)
+    {
+        m_deform_nodes.push_back(group.ref);
+        m_deform_nodes.push_back(group.nx);
+        m_deform_nodes.push_back(group.ny);
+    }
+    std::sort(m_deform_nodes.begin(), m_deform_nodes.end());
+    m_deform_nodes.erase(std::unique(m_deform_nodes.begin(), m_deform_nodes.end()), m_deform_nodes.end());
+    m_deform_node_positions.clear();
 }
 
 void FlexBody::updateFlexbodyVertexBuffers()
@@ -663,6 +864,17 @@ void FlexBody::updateFlexbodyVertexBuffers()
     if (!m_scene_node) // Disabled via addonpart/tuneup
         return;
 
+    if (m_blend_changed)
+    {
+        writeBlend();
+        m_blend_changed = false;
+    }
+
+    // Skip the upload if `computeFlexbody()` didn't run (no movement or LOD)
+    if (!m_vertices_changed)
+        return;
+    m_vertices_changed = false;
+
     Vector3 *ppt = m_dst_pos;
     Vector3 *npt = m_dst_normals;
     if (m_uses_shared_vertex_data)
@@ -680,12 +892,6 @@ void FlexBody::updateFlexbodyVertexBuffers()
         npt += m_submesh_vbufs_vertex_counts[i];
     }
 
-    if (m_blend_changed)
-    {
-        writeBlend();
-        m_blend_changed = false;
-    }
-
     m_scene_node->setPosition(m_flexit_center);
 }
 
@@ -83,7 +83,9 @@ public:
     void writeBlend();
 
     void computeFlexbody(); //!< Updates mesh deformation; works on CPU using local copy of vertex data.
-    void updateFlexbodyVertexBuffers();
+    void updateFlexbodyVertexBuffers(); //!< Uploads only if `computeFlexbody()` ran since last upload.
+    bool hasMovedSinceLastCompute(float epsilon) const; //!< Did any node affecting the mesh move further than `epsilon` since last `computeFlexbody()`?
+    void followFlexitCenter(); //!< Cheap substitute for a skipped `computeFlexbody()`: moves the mesh along, doesn't deform it.
 
     bool isVisible() const;
     void setVisible(bool visible);
@@ -109,7 +111,19 @@ public:
 
 private:
 
+    /// Vertices sharing the same ref/nx/ny nodes; the node basis is computed once per group.
+    struct LocatorGroup
+    {
+        NodeNum_t ref = NODENUM_INVALID;
+        NodeNum_t nx = NODENUM_INVALID;
+        NodeNum_t ny = NODENUM_INVALID;
+        uint32_t  soa_start = 0; //!< Offset into the `m_soa_*` arrays, multiple of 4
+        uint32_t  count = 0;     //!< Number of vertices; the SoA block is padded to a multiple of 4
+    };
+
     void defragmentFlexbodyMesh();
+    void buildLocatorGroups(); //!< Fills `m_locator_groups` and `m_soa_*` from `m_locators` and `m_src_normals`
+    Ogre::Vector3 calcFlexitCenter(RoR::NodeSB* nodes) const;
 
     RoR::GfxActor*    m_gfx_actor = nullptr;
     size_t            m_vertex_count = 0;
@@ -123,6 +137,17 @@ private:
     Ogre::ARGB*       m_src_colors = nullptr;
     Locator_t*        m_locators = nullptr; //!< 1 loc per vertex
 
+    // Deformation input for `computeFlexbody()`, SoA sorted by locator nodes
+    std::vector<LocatorGroup> m_locator_groups;
+    std::vector<float>        m_soa_coords[3];     //!< Locator coords x/y/z
+    std::vector<float>        m_soa_normals[3];    //!< Source normals x/y/z
+    std::vector<uint32_t>     m_soa_vert_index;    //!< Destination vertex
+
+    // Change detection, see `hasMovedSinceLastCompute()`
+    std::vector<NodeNum_t>     m_deform_nodes;          //!< Unique nodes read by `computeFlexbody()`
+    std::vector<Ogre::Vector3> m_deform_node_positions; //!< Their positions at last `computeFlexbody()`
+    bool                       m_vertices_changed = false;
+
     NodeNum_t         m_node_center = NODENUM_INVALID;
     NodeNum_t         m_node_x = NODENUM_INVALID;
     NodeNum_t         m_node_y = NODENUM_INVALID;
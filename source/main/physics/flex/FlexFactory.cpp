@@ -37,6 +37,7 @@
 #include <OgreMeshManager.h>
 #include <OgreSceneManager.h>
 #include <MeshLodGenerator/OgreMeshLodGenerator.h>
+#include <algorithm>
 
 //#define FLEXFACTORY_DEBUG_LOGGING
 
@@ -52,11 +53,13 @@ using namespace RoR;
 // Static
 const char * FlexBodyFileIO::SIGNATURE = "RoR FlexBody";
 
-FlexFactory::FlexFactory(ActorSpawner* rig_spawner):
+FlexFactory::FlexFactory(ActorSpawner* rig_spawner, ActorSpawnTemplatePtr spawn_template):
     m_rig_spawner(rig_spawner),
+    m_spawn_template(spawn_template),
     m_is_flexbody_cache_loaded(false),
     m_is_flexbody_cache_enabled(App::gfx_flexbody_cache->getBool()),
-    m_flexbody_cache_next_index(0)
+    m_flexbody_cache_next_index(0),
+    m_spawn_template_hits(0)
 {
 }
 
@@ -81,12 +84,19 @@ FlexBody* FlexFactory::CreateFlexBody(
 
     FLEX_DEBUG_LOG(__FUNCTION__);
     FlexBodyCacheData* from_cache = nullptr;
+    FlexBodyCacheData from_template;
     if (m_is_flexbody_cache_loaded)
     {
         FLEX_DEBUG_LOG(__FUNCTION__ " >> Get entry from cache ");
         from_cache = m_flexbody_cache.GetLoadedItem(m_flexbody_cache_next_index);
         m_flexbody_cache_next_index++;
     }
+    else if (this->LoadFromSpawnTemplate(flexbody_id, mesh, from_template))
+    {
+        FLEX_DEBUG_LOG(__FUNCTION__ " >> Get entry from spawn template ");
+        from_cache = &from_template; // Buffers are handed over to the new flexbody.
+        m_spawn_template_hits++;
+    }
 
     Ogre::Quaternion rot=Ogre::Quaternion(Ogre::Degree(rotation.z), Ogre::Vector3::UNIT_Z);
     rot=rot*Ogre::Quaternion(Ogre::Degree(rotation.y), Ogre::Vector3::UNIT_Y);
@@ -108,8 +118,12 @@ FlexBody* FlexFactory::CreateFlexBody(
     {
         m_flexbody_cache.AddItemToSave(new_flexbody);
     }
-    new_flexbody->m_id = flexbody_id;
+    new_flexbody->m_id = flexbody_id; // Must be set before `SaveToSpawnTemplate()`, it's the template key.
     new_flexbody->m_orig_mesh_name = common_mesh->getName();
+    if (from_cache == nullptr)
+    {
+        this->SaveToSpawnTemplate(new_flexbody);
+    }
     return new_flexbody;
 }
 
@@ -210,6 +224,12 @@ void FlexBodyFileIO::WriteFlexbodyHeader(FlexBody* flexbody)
 {
     FLEX_DEBUG_LOG(__FUNCTION__);
     FlexBodyRecordHeader header;
+    FlexFactory::FillRecordHeader(flexbody, header);
+    this->WriteToFile((void*)&header, sizeof(FlexBodyRecordHeader));
+}
+
+void FlexFactory::FillRecordHeader(FlexBody* flexbody, FlexBodyRecordHeader& header)
+{
     header.vertex_count            = static_cast<int>(flexbody->m_vertex_count);
     header.node_center             = flexbody->m_node_center            ;
     header.node_x                  = flexbody->m_node_x                 ;
@@ -222,8 +242,6 @@ void FlexBodyFileIO::WriteFlexbodyHeader(FlexBody* flexbody)
     if (flexbody->m_uses_shared_vertex_data) BITMASK_SET_1(header.flags, FlexBodyRecordHeader::USES_SHARED_VERTEX_DATA);
     if (flexbody->m_has_texture            ) BITMASK_SET_1(header.flags, FlexBodyRecordHeader::HAS_TEXTURE);
     if (flexbody->m_has_texture_blend      ) BITMASK_SET_1(header.flags, FlexBodyRecordHeader::HAS_TEXTURE_BLEND);
-
-    this->WriteToFile((void*)&header, sizeof(FlexBodyRecordHeader));
 }
 
 void FlexBodyFileIO::ReadFlexbodyHeader(FlexBodyCacheData* data)
@@ -424,5 +442,81 @@ void FlexFactory::SaveFlexbodiesToCache()
         FLEX_DEBUG_LOG(__FUNCTION__ " >> Saving flexbodies");
         m_flexbody_cache.SaveFile();
     }
+    if (m_spawn_template_hits > 0)
+    {
+        LOG(fmt::format("FlexFactory: {} flexbodies reused vertex bindings from the spawn template", m_spawn_template_hits));
+    }
+}
+
+bool FlexFactory::LoadFromSpawnTemplate(FlexbodyID_t flexbody_id, Ogre::MeshPtr& mesh, FlexBodyCacheData& out_data)
+{
+    // Defragmentation reorders the locators, the template holds them in the reordered state.
+    if (!m_spawn_template || App::flexbody_defrag_enabled->getBool())
+    {
+        return false;
+    }
+
+    auto found = m_spawn_template->flexbodies.find(flexbody_id);
+    if (found == m_spawn_template->flexbodies.end())
+    {
+        return false;
+    }
+    FlexBodyTemplateData const& data = found->second;
+
+    // The template is keyed by the truckfile, but the mesh file may have changed since - verify the layout.
+    int vertex_count = 0;
+    int num_submesh_vbufs = 0;
+    if (mesh->sharedVertexData)
+    {
+        vertex_count += static_cast<int>(mesh->sharedVertexData->vertexCount);
+    }
+    for (unsigned short i = 0; i < mesh->getNumSubMeshes(); i++)
+    {
+        if (!mesh->getSubMesh(i)->useSharedVertices)
+        {
+            vertex_count += static_cast<int>(mesh->getSubMesh(i)->vertexData->vertexCount);
+            num_submesh_vbufs++;
+        }
+    }
+    if (data.header.vertex_count != vertex_count || data.header.num_submesh_vbufs != num_submesh_vbufs
+        || BITMASK_IS_1(data.header.flags, FlexBodyRecordHeader::USES_SHARED_VERTEX_DATA) != (mesh->sharedVertexData != nullptr))
+    {
+        m_spawn_template->flexbodies.erase(found);
+        return false;
+    }
+
+    // Copy the buffers; allocate them the same way `FlexBody` does, it takes ownership.
+    out_data.header = data.header;
+    out_data.locators = new Locator_t[vertex_count];
+    std::copy(data.locators.begin(), data.locators.end(), out_data.locators);
+    out_data.src_normals = (Ogre::Vector3*)malloc(sizeof(Ogre::Vector3) * vertex_count);
+    std::copy(data.src_normals.begin(), data.src_normals.end(), out_data.src_normals);
+    out_data.dst_pos = (Ogre::Vector3*)malloc(sizeof(Ogre::Vector3) * vertex_count);
+    std::copy(data.dst_pos.begin(), data.dst_pos.end(), out_data.dst_pos);
+    if (BITMASK_IS_1(data.header.flags, FlexBodyRecordHeader::HAS_TEXTURE_BLEND))
+    {
+        out_data.src_colors = (Ogre::ARGB*)malloc(sizeof(Ogre::ARGB) * vertex_count);
+        std::copy(data.src_colors.begin(), data.src_colors.end(), out_data.src_colors);
+    }
+    return true;
+}
+
+void FlexFactory::SaveToSpawnTemplate(FlexBody* flexbody)
+{
+    if (!m_spawn_template || App::flexbody_defrag_enabled->getBool())
+    {
+        return;
+    }
+
+    FlexBodyTemplateData& data = m_spawn_template->flexbodies[flexbody->m_id];
+    FlexFactory::FillRecordHeader(flexbody, data.header);
+    data.locators.assign(flexbody->m_locators, flexbody->m_locators + flexbody->m_vertex_count);
+    data.dst_pos.assign(flexbody->m_dst_pos, flexbody->m_dst_pos + flexbody->m_vertex_count);
+    data.src_normals.assign(flexbody->m_src_normals, flexbody->m_src_normals + flexbody->m_vertex_count);
+    data.src_colors.clear();
+    if (flexbody->m_has_texture_blend)
+    {
+        data.src_colors.assign(flexbody->m_src_colors, flexbody->m_src_colors + flexbody->m_vertex_count);
+    }
 }
 
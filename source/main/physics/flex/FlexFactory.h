@@ -82,6 +82,17 @@ struct FlexBodyCacheData
     Locator_t*        locators; //!< 1 loc per vertex
 };
 
+/// In-memory counterpart of `FlexBodyCacheData`, kept by `ActorSpawnTemplate`.
+/// Owns the buffers - each flexbody spawned from it gets its own copy.
+struct FlexBodyTemplateData
+{
+    FlexBodyRecordHeader        header;
+    std::vector<Locator_t>      locators;
+    std::vector<Ogre::Vector3>  dst_pos;    //!< Recomputed on first update; kept so the buffer is never uninitialized
+    std::vector<Ogre::Vector3>  src_normals;
+    std::vector<Ogre::ARGB>     src_colors; //!< Only filled if flag HAS_TEXTURE_BLEND == true
+};
+
 /// Enables saving and loading flexbodies from/to binary file.
 ///
 /// FILE STRUCTURE:
@@ -165,7 +176,7 @@ class FlexFactory
 public:
     FlexFactory() {}
 
-    FlexFactory(ActorSpawner* spawner);
+    FlexFactory(ActorSpawner* spawner, ActorSpawnTemplatePtr spawn_template = nullptr);
 
     FlexBody* CreateFlexBody(
         FlexbodyID_t flexbody_id,
@@ -195,14 +206,21 @@ public:
     void  CheckAndLoadFlexbodyCache();
     void  SaveFlexbodiesToCache();
 
+    static void FillRecordHeader(FlexBody* flexbody, FlexBodyRecordHeader& header);
+
 private:
 
+    bool  LoadFromSpawnTemplate(FlexbodyID_t flexbody_id, Ogre::MeshPtr& mesh, FlexBodyCacheData& out_data);
+    void  SaveToSpawnTemplate(FlexBody* flexbody);
+
     ActorSpawner*             m_rig_spawner;
+    ActorSpawnTemplatePtr     m_spawn_template; //!< Optional; reused flexbody vertex bindings, see `ActorSpawnTemplate`.
 
     FlexBodyFileIO          m_flexbody_cache;
     bool                    m_is_flexbody_cache_enabled;
     bool                    m_is_flexbody_cache_loaded;
     unsigned int            m_flexbody_cache_next_index;
+    unsigned int            m_spawn_template_hits; //!< Logged by `SaveFlexbodiesToCache()`
 };
 
 /// @} // addtogroup Flex
@@ -67,7 +67,7 @@ inline float Buoyance::computeVolume(Vec3 o, Vec3 a, Vec3 b, Vec3 c)
 }
 
 //compute pressure and drag force on a submerged triangle
-Vec3 Buoyance::computePressureForceSub(Vec3 a, Vec3 b, Vec3 c, Vec3 vel, int type)
+Vec3 Buoyance::computePressureForceSub(Vec3 a, Vec3 b, Vec3 c, Vec3 vel, int type, BuoyWorkContext& ctx)
 {
     //compute normal vector
     Vec3 normal = (b - a).crossProduct(c - a);
@@ -111,7 +111,7 @@ Vec3 Buoyance::computePressureForceSub(Vec3 a, Vec3 b, Vec3 c, Vec3 vel, int typ
             drg = (-500.0 * surf * vell * vell * cosaoa) * normal;
             if (normal.dotProduct(vel / vell) < 0)
                 drg = -drg;
-            if (update && splashp)
+            if (ctx.update && splashp)
             {
                 float fxl = vell * cosaoa * surf;
                 if (fxl > 1.5) //if enough pushing drag
@@ -121,13 +121,13 @@ Vec3 Buoyance::computePressureForceSub(Vec3 a, Vec3 b, Vec3 c, Vec3 vel, int typ
                         fxdir.y = -fxdir.y;
 
                     if (App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(a) - a.y < 0.1)
-                        splashp->malloc(a, fxdir);
+                        this->emitSplash(a, fxdir, ctx);
 
                     else if (App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(b) - b.y < 0.1)
-                        splashp->malloc(b, fxdir);
+                        this->emitSplash(b, fxdir, ctx);
 
                     else if (App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(c) - c.y < 0.1)
-                        splashp->malloc(c, fxdir);
+                        this->emitSplash(c, fxdir, ctx);
                 }
             }
         }
@@ -135,15 +135,18 @@ Vec3 Buoyance::computePressureForceSub(Vec3 a, Vec3 b, Vec3 c, Vec3 vel, int typ
     //okay
     if (sink)
         return drg;
-    if (update && buoy_debug_view)
+    if (ctx.update && buoy_debug_view)
     {
-        buoy_debug_subcabs.emplace_back(a, b, c, normal, drg, vol);
+        if (ctx.deferred)
+            ctx.debug_subcabs.emplace_back(a, b, c, normal, drg, vol);
+        else
+            buoy_debug_subcabs.emplace_back(a, b, c, normal, drg, vol);
     }
     return vol * normal + drg;
 }
 
 //compute pressure and drag forces on a random triangle
-Vec3 Buoyance::computePressureForce(Vec3 a, Vec3 b, Vec3 c, Vec3 vel, int type)
+Vec3 Buoyance::computePressureForce(Vec3 a, Vec3 b, Vec3 c, Vec3 vel, int type, BuoyWorkContext& ctx)
 {
     float wha = App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight((a + b + c) / 3.0);
     //check if fully emerged
@@ -156,65 +159,144 @@ Vec3 Buoyance::computePressureForce(Vec3 a, Vec3 b, Vec3 c, Vec3 vel, int type)
         //one dip
         if (a.y < wha && b.y > wha && c.y > wha)
         {
-            return computePressureForceSub(a, a + (wha - a.y) / (b.y - a.y) * (b - a), a + (wha - a.y) / (c.y - a.y) * (c - a), vel, type);
+            return computePressureForceSub(a, a + (wha - a.y) / (b.y - a.y) * (b - a), a + (wha - a.y) / (c.y - a.y) * (c - a), vel, type, ctx);
         }
         if (b.y < wha && c.y > wha && a.y > wha)
         {
-            return computePressureForceSub(b, b + (wha - b.y) / (c.y - b.y) * (c - b), b + (wha - b.y) / (a.y - b.y) * (a - b), vel, type);
+            return computePressureForceSub(b, b + (wha - b.y) / (c.y - b.y) * (c - b), b + (wha - b.y) / (a.y - b.y) * (a - b), vel, type, ctx);
         }
         if (c.y < wha && a.y > wha && b.y > wha)
         {
-            return computePressureForceSub(c, c + (wha - c.y) / (a.y - c.y) * (a - c), c + (wha - c.y) / (b.y - c.y) * (b - c), vel, type);
+            return computePressureForceSub(c, c + (wha - c.y) / (a.y - c.y) * (a - c), c + (wha - c.y) / (b.y - c.y) * (b - c), vel, type, ctx);
         }
         //two dips
         if (a.y > wha && b.y < wha && c.y < wha)
         {
             Vec3 tb = a + (wha - a.y) / (b.y - a.y) * (b - a);
             Vec3 tc = a + (wha - a.y) / (c.y - a.y) * (c - a);
-            Vec3 f = computePressureForceSub(tb, b, tc, vel, type);
-            return f + computePressureForceSub(tc, b, c, vel, type);
+            Vec3 f = computePressureForceSub(tb, b, tc, vel, type, ctx);
+            return f + computePressureForceSub(tc, b, c, vel, type, ctx);
         }
         if (b.y > wha && c.y < wha && a.y < wha)
         {
             Vec3 tc = b + (wha - b.y) / (c.y - b.y) * (c - b);
             Vec3 ta = b + (wha - b.y) / (a.y - b.y) * (a - b);
-            Vec3 f = computePressureForceSub(tc, c, ta, vel, type);
-            return f + computePressureForceSub(ta, c, a, vel, type);
+            Vec3 f = computePressureForceSub(tc, c, ta, vel, type, ctx);
+            return f + computePressureForceSub(ta, c, a, vel, type, ctx);
         }
         if (c.y > wha && a.y < wha && b.y < wha)
         {
             Vec3 ta = c + (wha - c.y) / (a.y - c.y) * (a - c);
             Vec3 tb = c + (wha - c.y) / (b.y - c.y) * (b - c);
-            Vec3 f = computePressureForceSub(ta, a, tb, vel, type);
-            return f + computePressureForceSub(tb, a, b, vel, type);
+            Vec3 f = computePressureForceSub(ta, a, tb, vel, type, ctx);
+            return f + computePressureForceSub(tb, a, b, vel, type, ctx);
         }
         return Vec3();
     }
     else
     {
         //fully submerged case
-        return computePressureForceSub(a, b, c, vel, type);
+        return computePressureForceSub(a, b, c, vel, type, ctx);
     }
 }
 
-void Buoyance::computeNodeForce(BuoyCachedNode* a, BuoyCachedNode* b, BuoyCachedNode* c, int type, float timeshift)
+void Buoyance::emitSplash(Vec3 pos, Vec3 dir, BuoyWorkContext& ctx)
+{
+    if (ctx.deferred)
+        ctx.splashes.emplace_back(pos, dir);
+    else
+        splashp->malloc(pos, dir);
+}
+
+bool Buoyance::computeTriangleForces(const BuoyCachedNode& a, const BuoyCachedNode& b, const BuoyCachedNode& c, int type,
+                                     Vec3& out_fa, Vec3& out_fb, Vec3& out_fc, BuoyWorkContext& ctx)
 {
-    if (a->AbsPosition.y > App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(a->AbsPosition) &&
-        b->AbsPosition.y > App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(b->AbsPosition) &&
-        c->AbsPosition.y > App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(c->AbsPosition))
-        return;
+    if (a.AbsPosition.y > a.wave_height &&
+        b.AbsPosition.y > b.wave_height &&
+        c.AbsPosition.y > c.wave_height)
+        return false;
 
     //compute center
-    Vec3 m = (a->AbsPosition + b->AbsPosition + c->AbsPosition) / 3.0;
+    Vec3 m = (a.AbsPosition + b.AbsPosition + c.AbsPosition) / 3.0;
 
     //suboptimal
-    Vec3 mab = (a->AbsPosition + b->AbsPosition) / 2.0;
-    Vec3 mbc = (b->AbsPosition + c->AbsPosition) / 2.0;
-    Vec3 mca = (c->AbsPosition + a->AbsPosition) / 2.0;
-    Vec3 vel = (a->Velocity + b->Velocity + c->Velocity) / 3.0;
-
-    //apply forces
-    a->Forces += computePressureForce(a->AbsPosition, mab, m, vel, type) + computePressureForce(a->AbsPosition, m, mca, vel, type);
-    b->Forces += computePressureForce(b->AbsPosition, mbc, m, vel, type) + computePressureForce(b->AbsPosition, m, mab, vel, type);
-    c->Forces += computePressureForce(c->AbsPosition, mca, m, vel, type) + computePressureForce(c->AbsPosition, m, mbc, vel, type);
+    Vec3 mab = (a.AbsPosition + b.AbsPosition) / 2.0;
+    Vec3 mbc = (b.AbsPosition + c.AbsPosition) / 2.0;
+    Vec3 mca = (c.AbsPosition + a.AbsPosition) / 2.0;
+    Vec3 vel = (a.Velocity + b.Velocity + c.Velocity) / 3.0;
+
+    out_fa = computePressureForce(a.AbsPosition, mab, m, vel, type, ctx) + computePressureForce(a.AbsPosition, m, mca, vel, type, ctx);
+    out_fb = computePressureForce(b.AbsPosition, mbc, m, vel, type, ctx) + computePressureForce(b.AbsPosition, m, mab, vel, type, ctx);
+    out_fc = computePressureForce(c.AbsPosition, mca, m, vel, type, ctx) + computePressureForce(c.AbsPosition, m, mbc, vel, type, ctx);
+    return true;
+}
+
+void Buoyance::computeNodeForce(BuoyCachedNode* a, BuoyCachedNode* b, BuoyCachedNode* c, int type, float timeshift)
+{
+    m_serial_ctx.update = update;
+
+    Vec3 fa, fb, fc;
+    if (this->computeTriangleForces(*a, *b, *c, type, fa, fb, fc, m_serial_ctx))
+    {
+        //apply forces
+        a->Forces += fa;
+        b->Forces += fb;
+        c->Forces += fc;
+    }
+}
+
+void Buoyance::computeNodeForce(const std::vector<BuoyCachedNode>& nodes, BuoyCachedNodeID_t a, BuoyCachedNodeID_t b, BuoyCachedNodeID_t c,
+                                int type, std::vector<Vec3>& out_forces, BuoyWorkContext& ctx)
+{
+    Vec3 fa, fb, fc;
+    if (this->computeTriangleForces(nodes[a], nodes[b], nodes[c], type, fa, fb, fc, ctx))
+    {
+        out_forces[a] += fa;
+        out_forces[b] += fb;
+        out_forces[c] += fc;
+    }
+}
+
+void Buoyance::computeWaveHeights(std::vector<BuoyCachedNode>& nodes, size_t begin, size_t end)
+{
+    const size_t BATCH_SIZE = 64;
+    Vec3 positions[BATCH_SIZE];
+    float heights[BATCH_SIZE];
+
+    Wavefield* wavefield = App::GetGameContext()->GetTerrain()->getWater();
+    for (size_t batch_start = begin; batch_start < end; batch_start += BATCH_SIZE)
+    {
+        const size_t batch_len = std::min(BATCH_SIZE, end - batch_start);
+        for (size_t i = 0; i < batch_len; i++)
+        {
+            positions[i] = nodes[batch_start + i].AbsPosition;
+        }
+        wavefield->CalcWavesHeightBatch(positions, heights, batch_len);
+        for (size_t i = 0; i < batch_len; i++)
+        {
+            nodes[batch_start + i].wave_height = heights[i];
+        }
+    }
+}
+
+void Buoyance::reduceWorkContexts(size_t num_contexts)
+{
+    for (size_t c = 0; c < num_contexts; c++)
+    {
+        BuoyWorkContext& ctx = buoy_work_contexts[c];
+        for (size_t i = 0; i < buoy_cached_nodes.size(); i++)
+        {
+            buoy_cached_nodes[i].Forces += ctx.forces_cached[i];
+            buoy_projected_nodes[i].Forces += ctx.forces_projected[i];
+        }
+
+        if (splashp)
+        {
+            for (const BuoySplash& splash: ctx.splashes)
+            {
+                splashp->malloc(splash.pos, splash.dir);
+            }
+        }
+        buoy_debug_subcabs.insert(buoy_debug_subcabs.end(), ctx.debug_subcabs.begin(), ctx.debug_subcabs.end());
+    }
 }
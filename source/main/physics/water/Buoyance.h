@@ -38,6 +38,7 @@ struct BuoyCachedNode
     Vec3 Forces;
     // additional fields
     NodeNum_t nodenum = NODENUM_INVALID;
+    float wave_height = 0.f; //!< Water surface height at AbsPosition, see `Buoyance::computeWaveHeights()`
 };
 
 struct BuoyDebugSubCab //!< Submerged cab triangle
@@ -50,6 +51,25 @@ struct BuoyDebugSubCab //!< Submerged cab triangle
     float volume;
 };
 
+struct BuoySplash //!< Splash particle request, queued by the parallel pass and emitted afterwards.
+{
+    BuoySplash(Vec3 _pos, Vec3 _dir): pos(_pos), dir(_dir) {}
+    Vec3 pos;
+    Vec3 dir;
+};
+
+/// Per-thread state of the buoyancy computation.
+/// The parallel pass gives each participating thread its own context and reduces the results afterwards.
+struct BuoyWorkContext
+{
+    bool update = false;   //!< Update particles and debugview, if enabled.
+    bool deferred = false; //!< Queue splashes and debug subcabs instead of emitting them directly (not thread-safe).
+    std::vector<Vec3> forces_cached;    //!< Deferred only, indexed by BuoyCachedNodeID_t
+    std::vector<Vec3> forces_projected; //!< Deferred only, indexed by BuoyCachedNodeID_t
+    std::vector<BuoyDebugSubCab> debug_subcabs;
+    std::vector<BuoySplash> splashes;
+};
+
 class Buoyance
 {
 public:
@@ -57,8 +77,21 @@ public:
     Buoyance(DustPool* splash, DustPool* ripple);
     ~Buoyance();
 
+    /// Adds forces to the cached nodes directly; `BuoyCachedNode::wave_height` must be up to date.
     void computeNodeForce(BuoyCachedNode *a, BuoyCachedNode *b, BuoyCachedNode *c, int type, float timeshift);
 
+    /// Thread-safe variant for the parallel pass; adds forces to `out_forces` (indexed by BuoyCachedNodeID_t).
+    void computeNodeForce(const std::vector<BuoyCachedNode>& nodes, BuoyCachedNodeID_t a, BuoyCachedNodeID_t b, BuoyCachedNodeID_t c,
+                          int type, std::vector<Vec3>& out_forces, BuoyWorkContext& ctx);
+
+    /// Refreshes `BuoyCachedNode::wave_height` for nodes in range [begin, end) - evaluated once per node and shared by all its triangles.
+    void computeWaveHeights(std::vector<BuoyCachedNode>& nodes, size_t begin, size_t end);
+
+    /// Sums forces of worker contexts into the cached/projected nodes and emits queued splashes/debug subcabs.
+    void reduceWorkContexts(size_t num_contexts);
+
+    std::vector<BuoyWorkContext> buoy_work_contexts; //!< One per thread participating in the parallel pass.
+
     enum { BUOY_NORMAL, BUOY_DRAGONLY, BUOY_DRAGLESS };
 
     bool sink = false;
@@ -82,12 +115,19 @@ private:
     inline float computeVolume(Vec3 o, Vec3 a, Vec3 b, Vec3 c);
 
     //compute pressure and drag force on a submerged triangle
-    Vec3 computePressureForceSub(Vec3 a, Vec3 b, Vec3 c, Vec3 vel, int type);
+    Vec3 computePressureForceSub(Vec3 a, Vec3 b, Vec3 c, Vec3 vel, int type, BuoyWorkContext& ctx);
     
     //compute pressure and drag forces on a random triangle
-    Vec3 computePressureForce(Vec3 a, Vec3 b, Vec3 c, Vec3 vel, int type);
+    Vec3 computePressureForce(Vec3 a, Vec3 b, Vec3 c, Vec3 vel, int type, BuoyWorkContext& ctx);
+
+    //compute forces of all 6 sub-triangles, return false if the triangle is fully emerged
+    bool computeTriangleForces(const BuoyCachedNode& a, const BuoyCachedNode& b, const BuoyCachedNode& c, int type,
+                               Vec3& out_fa, Vec3& out_fb, Vec3& out_fc, BuoyWorkContext& ctx);
+
+    void emitSplash(Vec3 pos, Vec3 dir, BuoyWorkContext& ctx);
     
     DustPool *splashp, *ripplep;
+    BuoyWorkContext m_serial_ctx; //!< Used by the non-deferred `computeNodeForce()`
 };
 
 /// @} // addtogroup Physics
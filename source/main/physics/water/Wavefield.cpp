@@ -119,6 +119,39 @@ float Wavefield::CalcWavesHeight(Vec3 pos, float timeshift_sec)
     return result;
 }
 
+void Wavefield::CalcWavesHeightBatch(const Vec3* positions, float* out_heights, size_t count, float timeshift_sec)
+{
+    // no waves?
+    if (!RoR::App::gfx_water_waves->getBool() || RoR::App::mp_state->getEnum<MpState>() == RoR::MpState::CONNECTED)
+    {
+        std::fill(out_heights, out_heights + count, m_water_height);
+        return;
+    }
+
+    const float time_sec = m_sim_time_counter + timeshift_sec;
+
+    for (size_t n = 0; n < count; n++)
+    {
+        const Vec3& pos = positions[n];
+        if (pos.y > m_water_height + m_max_ampl)
+        {
+            out_heights[n] = m_water_height;
+            continue;
+        }
+
+        // Same as `CalcWavesHeight()`
+        const float waveheight = GetWaveHeight(pos);
+        float result = m_water_height;
+        for (size_t i = 0; i < m_wavetrain_defs.size(); i++)
+        {
+            const WaveTrain& wt = m_wavetrain_defs[i];
+            float amp = std::min(wt.amplitude * waveheight, wt.maxheight);
+            result += amp * sin(Ogre::Math::TWO_PI * ((time_sec * wt.wavespeed + wt.dir_sin * pos.x + wt.dir_cos * pos.z) / wt.wavelength));
+        }
+        out_heights[n] = result;
+    }
+}
+
 bool Wavefield::IsUnderWater(Vec3 pos)
 {
     float waterheight = m_water_height;
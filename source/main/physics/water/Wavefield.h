@@ -38,6 +38,7 @@ public:
     void  SetStaticWaterHeight(float value);
     void  SetWavesHeight(float);
     float CalcWavesHeight(Vec3 pos, float timeshift_sec = 0.f);
+    void  CalcWavesHeightBatch(const Vec3* positions, float* out_heights, size_t count, float timeshift_sec = 0.f); //!< Like `CalcWavesHeight()` but evaluates the global wave settings only once.
     Vec3  CalcWavesVelocity(Vec3 pos, float timeshift_sec = 0.f);
     void  FrameStepWaveField(float dt);
     bool  IsUnderWater(Vec3 pos);
@@ -0,0 +1,1555 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "RigDef_DocumentCache.h"
+
+#include "Application.h"
+#include "PlatformUtils.h"
+#include "RoRVersion.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fmt/format.h>
+#include <type_traits>
+#include <unordered_map>
+
+using namespace RigDef;
+
+const char* DocumentCache::SIGNATURE = "RoR/RigDefCache";
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Archives: the same `Visit()` functions both write and read the data,
+// so the field order can't get out of sync between saving and loading.
+
+class DocumentWriter
+{
+public:
+    static const bool IS_READING = false;
+
+    void Pod(void* ptr, size_t len)
+    {
+        const char* bytes = static_cast<const char*>(ptr);
+        m_data.insert(m_data.end(), bytes, bytes + len);
+    }
+
+    bool CanRead(size_t count) { return true; }
+    bool IsOk() const { return true; }
+
+    /// Shared objects (i.e. beam defaults) are written once, then referenced by a 1-based index.
+    uint32_t GetSharedId(const void* ptr, bool& is_new)
+    {
+        auto itor = m_shared_ids.find(ptr);
+        is_new = (itor == m_shared_ids.end());
+        if (is_new)
+        {
+            itor = m_shared_ids.insert(std::make_pair(ptr, static_cast<uint32_t>(m_shared_ids.size() + 1))).first;
+        }
+        return itor->second;
+    }
+
+    std::vector<char> const& GetData() const { return m_data; }
+
+private:
+    std::vector<char>                             m_data;
+    std::unordered_map<const void*, uint32_t>     m_shared_ids;
+};
+
+class DocumentReader
+{
+public:
+    static const bool IS_READING = true;
+
+    DocumentReader(const char* data, size_t size): m_data(data), m_size(size) {}
+
+    void Pod(void* ptr, size_t len)
+    {
+        if (!m_ok || m_pos + len > m_size)
+        {
+            m_ok = false;
+            std::memset(ptr, 0, len);
+            return;
+        }
+        std::memcpy(ptr, m_data + m_pos, len);
+        m_pos += len;
+    }
+
+    /// Sanity check of an element count, so that a damaged file can't make us allocate gigabytes.
+    bool CanRead(size_t count)
+    {
+        if (count > m_size - m_pos)
+        {
+            m_ok = false;
+        }
+        return m_ok;
+    }
+
+    void Fail() { m_ok = false; }
+    bool IsOk() const { return m_ok; }
+    bool IsFinished() const { return m_pos == m_size; }
+
+    std::vector<std::shared_ptr<void>> shared_objects;
+
+private:
+    const char* m_data;
+    size_t      m_size;
+    size_t      m_pos = 0;
+    bool        m_ok = true;
+};
+
+// ----------------------------------------------------------------------------
+// Generic types
+
+template<class A, class T>
+typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type
+Visit(A& ar, T& value)
+{
+    ar.Pod(&value, sizeof(T));
+}
+
+template<class A>
+void Visit(A& ar, std::string& str)
+{
+    uint32_t len = static_cast<uint32_t>(str.size());
+    Visit(ar, len);
+    if (A::IS_READING)
+    {
+        if (!ar.CanRead(len))
+            return;
+        str.resize(len);
+    }
+    if (len > 0)
+    {
+        ar.Pod(&str[0], len);
+    }
+}
+
+template<class A>
+void Visit(A& ar, Ogre::Vector3& v)
+{
+    Visit(ar, v.x);
+    Visit(ar, v.y);
+    Visit(ar, v.z);
+}
+
+template<class A>
+void Visit(A& ar, Ogre::ColourValue& c)
+{
+    Visit(ar, c.r);
+    Visit(ar, c.g);
+    Visit(ar, c.b);
+    Visit(ar, c.a);
+}
+
+template<class A, class T, size_t N>
+void Visit(A& ar, T (&arr)[N])
+{
+    for (size_t i = 0; i < N; ++i)
+    {
+        Visit(ar, arr[i]);
+    }
+}
+
+template<class A, class T>
+void Visit(A& ar, std::vector<T>& vec)
+{
+    uint32_t count = static_cast<uint32_t>(vec.size());
+    Visit(ar, count);
+    if (A::IS_READING)
+    {
+        if (!ar.CanRead(count))
+            return;
+        vec.resize(count);
+    }
+    for (T& elem: vec)
+    {
+        Visit(ar, elem);
+    }
+}
+
+template<class A, class T>
+void Visit(A& ar, std::list<T>& list)
+{
+    uint32_t count = static_cast<uint32_t>(list.size());
+    Visit(ar, count);
+    if (A::IS_READING)
+    {
+        if (!ar.CanRead(count))
+            return;
+        list.resize(count);
+    }
+    for (T& elem: list)
+    {
+        Visit(ar, elem);
+    }
+}
+
+template<class T>
+void Visit(DocumentWriter& ar, std::shared_ptr<T>& ptr)
+{
+    uint32_t id = 0;
+    bool is_new = false;
+    if (ptr)
+    {
+        id = ar.GetSharedId(ptr.get(), is_new);
+    }
+    Visit(ar, id);
+    if (is_new)
+    {
+        Visit(ar, *ptr);
+    }
+}
+
+template<class T>
+void Visit(DocumentReader& ar, std::shared_ptr<T>& ptr)
+{
+    uint32_t id = 0;
+    Visit(ar, id);
+    if (id == 0)
+    {
+        ptr = nullptr;
+    }
+    else if (id == ar.shared_objects.size() + 1)
+    {
+        ptr = std::make_shared<T>();
+        ar.shared_objects.push_back(ptr);
+        Visit(ar, *ptr);
+    }
+    else if (id <= ar.shared_objects.size())
+    {
+        ptr = std::static_pointer_cast<T>(ar.shared_objects[id - 1]);
+    }
+    else
+    {
+        ar.Fail();
+        ptr = nullptr;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Nodes
+
+template<class A>
+void Visit(A& ar, Node::Id& id)
+{
+    uint8_t type = (id.IsTypeNumbered()) ? 1 : (id.IsTypeNamed()) ? 2 : 0;
+    unsigned int num = id.Num();
+    std::string str = id.Str();
+    Visit(ar, type);
+    Visit(ar, num);
+    Visit(ar, str);
+    if (A::IS_READING)
+    {
+        if (type == 1)
+            id.SetNum(num);
+        else if (type == 2)
+            id.setStr(str);
+        else
+            id.Invalidate();
+    }
+}
+
+template<class A>
+void Visit(A& ar, Node::Ref& ref)
+{
+    std::string str = ref.Str();
+    unsigned int num = ref.Num();
+    unsigned int flags = ref.GetFlags();
+    unsigned int line_number = ref.GetLineNumber();
+    Visit(ar, str);
+    Visit(ar, num);
+    Visit(ar, flags);
+    Visit(ar, line_number);
+    if (A::IS_READING)
+    {
+        ref = Node::Ref(str, num, flags, line_number);
+    }
+}
+
+template<class A>
+void Visit(A& ar, std::vector<Node::Range>& vec) // `Node::Range` isn't default-constructible
+{
+    uint32_t count = static_cast<uint32_t>(vec.size());
+    Visit(ar, count);
+    if (A::IS_READING)
+    {
+        if (!ar.CanRead(count))
+            return;
+        vec.clear();
+        for (uint32_t i = 0; i < count && ar.IsOk(); ++i)
+        {
+            Node::Range range = Node::Range(Node::Ref());
+            Visit(ar, range.start);
+            Visit(ar, range.end);
+            vec.push_back(range);
+        }
+    }
+    else
+    {
+        for (Node::Range& range: vec)
+        {
+            Visit(ar, range.start);
+            Visit(ar, range.end);
+        }
+    }
+}
+
+template<class A>
+void Visit(A& ar, NodeDefaults& def)
+{
+    Visit(ar, def.load_weight);
+    Visit(ar, def.friction);
+    Visit(ar, def.volume);
+    Visit(ar, def.surface);
+    Visit(ar, def.options);
+}
+
+template<class A>
+void Visit(A& ar, DefaultMinimass& def)
+{
+    Visit(ar, def.min_mass_Kg);
+}
+
+template<class A>
+void Visit(A& ar, BeamDefaultsScale& def)
+{
+    Visit(ar, def.springiness);
+    Visit(ar, def.damping_constant);
+    Visit(ar, def.deformation_threshold_constant);
+    Visit(ar, def.breaking_threshold_constant);
+}
+
+template<class A>
+void Visit(A& ar, BeamDefaults& def)
+{
+    Visit(ar, def.springiness);
+    Visit(ar, def.damping_constant);
+    Visit(ar, def.deformation_threshold);
+    Visit(ar, def.breaking_threshold);
+    Visit(ar, def.visual_beam_diameter);
+    Visit(ar, def.beam_material_name);
+    Visit(ar, def.plastic_deform_coef);
+    Visit(ar, def._enable_advanced_deformation);
+    Visit(ar, def._is_plastic_deform_coef_user_defined);
+    Visit(ar, def._is_user_defined);
+    Visit(ar, def.scale);
+}
+
+template<class A>
+void Visit(A& ar, Inertia& def)
+{
+    Visit(ar, def.start_delay_factor);
+    Visit(ar, def.stop_delay_factor);
+    Visit(ar, def.start_function);
+    Visit(ar, def.stop_function);
+}
+
+template<class A>
+void Visit(A& ar, Node& def)
+{
+    Visit(ar, def.id);
+    Visit(ar, def.position);
+    Visit(ar, def.options);
+    Visit(ar, def.load_weight_override);
+    Visit(ar, def._has_load_weight_override);
+    Visit(ar, def.node_defaults);
+    Visit(ar, def.default_minimass);
+    Visit(ar, def.beam_defaults);
+    Visit(ar, def.detacher_group);
+}
+
+// ----------------------------------------------------------------------------
+// Shared/helper data
+
+template<class A>
+void Visit(A& ar, AeroAnimator& def)
+{
+    Visit(ar, def.flags);
+    Visit(ar, def.engine_idx);
+}
+
+template<class A>
+void Visit(A& ar, BaseWheel& def)
+{
+    Visit(ar, def.width);
+    Visit(ar, def.num_rays);
+    Visit(ar, def.nodes);
+    Visit(ar, def.rigidity_node);
+    Visit(ar, def.braking);
+    Visit(ar, def.propulsion);
+    Visit(ar, def.reference_arm_node);
+    Visit(ar, def.mass);
+    Visit(ar, def.node_defaults);
+    Visit(ar, def.beam_defaults);
+}
+
+template<class A>
+void Visit(A& ar, BaseMeshWheel& def)
+{
+    Visit(ar, static_cast<BaseWheel&>(def));
+    Visit(ar, def.side);
+    Visit(ar, def.mesh_name);
+    Visit(ar, def.material_name);
+    Visit(ar, def.rim_radius);
+    Visit(ar, def.tyre_radius);
+    Visit(ar, def.spring);
+    Visit(ar, def.damping);
+}
+
+template<class A>
+void Visit(A& ar, BaseWheel2& def)
+{
+    Visit(ar, static_cast<BaseWheel&>(def));
+    Visit(ar, def.rim_radius);
+    Visit(ar, def.tyre_radius);
+    Visit(ar, def.tyre_springiness);
+    Visit(ar, def.tyre_damping);
+}
+
+template<class A>
+void Visit(A& ar, DocComment& def)
+{
+    Visit(ar, def.comment_text);
+    Visit(ar, def.commented_keyword);
+    Visit(ar, def.commented_datapos);
+}
+
+template<class A>
+void Visit(A& ar, Animation::MotorSource& def)
+{
+    Visit(ar, def.source);
+    Visit(ar, def.motor);
+}
+
+template<class A>
+void Visit(A& ar, Animation& def)
+{
+    Visit(ar, def.ratio);
+    Visit(ar, def.lower_limit);
+    Visit(ar, def.upper_limit);
+    Visit(ar, def.source);
+    Visit(ar, def.motor_sources);
+    Visit(ar, def.mode);
+    Visit(ar, def.event_name);
+    Visit(ar, def.dash_link_name);
+}
+
+template<class A>
+void Visit(A& ar, CameraSettings& def)
+{
+    Visit(ar, def.mode);
+}
+
+template<class A>
+void Visit(A& ar, FlareBase& def)
+{
+    Visit(ar, def.reference_node);
+    Visit(ar, def.node_axis_x);
+    Visit(ar, def.node_axis_y);
+    Visit(ar, def.offset);
+    Visit(ar, def.type);
+    Visit(ar, def.control_number);
+    Visit(ar, def.dashboard_link);
+    Visit(ar, def.blink_delay_milis);
+    Visit(ar, def.size);
+    Visit(ar, def.material_name);
+}
+
+template<class A>
+void Visit(A& ar, Forvert& def)
+{
+    Visit(ar, def.node_ref);
+    Visit(ar, def.node_x);
+    Visit(ar, def.node_y);
+    Visit(ar, def.vert_index);
+    Visit(ar, def.line_number);
+}
+
+template<class A>
+void Visit(A& ar, Cab& def)
+{
+    Visit(ar, def.nodes);
+    Visit(ar, def.options);
+}
+
+template<class A>
+void Visit(A& ar, Texcoord& def)
+{
+    Visit(ar, def.node);
+    Visit(ar, def.u);
+    Visit(ar, def.v);
+}
+
+template<class A>
+void Visit(A& ar, TorqueCurve::Sample& def)
+{
+    Visit(ar, def.power);
+    Visit(ar, def.torque_percent);
+}
+
+template<class A>
+void Visit(A& ar, ManagedMaterialsOptions& def)
+{
+    Visit(ar, def.double_sided);
+}
+
+template<class A>
+void Visit(A& ar, Prop::DashboardSpecial& def)
+{
+    Visit(ar, def.offset);
+    Visit(ar, def._offset_is_set);
+    Visit(ar, def.rotation_angle);
+    Visit(ar, def.mesh_name);
+}
+
+template<class A>
+void Visit(A& ar, Prop::BeaconSpecial& def)
+{
+    Visit(ar, def.flare_material_name);
+    Visit(ar, def.color);
+}
+
+// ----------------------------------------------------------------------------
+// Elements, in order of `Document::Module`
+
+template<class A>
+void Visit(A& ar, Airbrake& def)
+{
+    Visit(ar, def.reference_node);
+    Visit(ar, def.x_axis_node);
+    Visit(ar, def.y_axis_node);
+    Visit(ar, def.aditional_node);
+    Visit(ar, def.offset);
+    Visit(ar, def.width);
+    Visit(ar, def.height);
+    Visit(ar, def.max_inclination_angle);
+    Visit(ar, def.texcoord_x1);
+    Visit(ar, def.texcoord_x2);
+    Visit(ar, def.texcoord_y1);
+    Visit(ar, def.texcoord_y2);
+    Visit(ar, def.lift_coefficient);
+}
+
+template<class A>
+void Visit(A& ar, Animator& def)
+{
+    Visit(ar, def.nodes);
+    Visit(ar, def.lenghtening_factor);
+    Visit(ar, def.flags);
+    Visit(ar, def.short_limit);
+    Visit(ar, def.long_limit);
+    Visit(ar, def.aero_animator);
+    Visit(ar, def.inertia_defaults);
+    Visit(ar, def.beam_defaults);
+    Visit(ar, def.detacher_group);
+}
+
+template<class A>
+void Visit(A& ar, AntiLockBrakes& def)
+{
+    Visit(ar, def.regulation_force);
+    Visit(ar, def.min_speed);
+    Visit(ar, def.pulse_per_sec);
+    Visit(ar, def.attr_is_on);
+    Visit(ar, def.attr_no_dashboard);
+    Visit(ar, def.attr_no_toggle);
+}
+
+template<class A>
+void Visit(A& ar, Assetpack& def)
+{
+    Visit(ar, def.filename);
+}
+
+template<class A>
+void Visit(A& ar, Author& def)
+{
+    Visit(ar, def.type);
+    Visit(ar, def.forum_account_id);
+    Visit(ar, def.name);
+    Visit(ar, def.email);
+    Visit(ar, def._has_forum_account);
+}
+
+template<class A>
+void Visit(A& ar, Axle& def)
+{
+    Visit(ar, def.wheels);
+    Visit(ar, def.options);
+}
+
+template<class A>
+void Visit(A& ar, Beam& def)
+{
+    Visit(ar, def.nodes);
+    Visit(ar, def.options);
+    Visit(ar, def.extension_break_limit);
+    Visit(ar, def._has_extension_break_limit);
+    Visit(ar, def.detacher_group);
+    Visit(ar, def.defaults);
+}
+
+template<class A>
+void Visit(A& ar, Brakes& def)
+{
+    Visit(ar, def.default_braking_force);
+    Visit(ar, def.parking_brake_force);
+}
+
+template<class A>
+void Visit(A& ar, Camera& def)
+{
+    Visit(ar, def.center_node);
+    Visit(ar, def.back_node);
+    Visit(ar, def.left_node);
+}
+
+template<class A>
+void Visit(A& ar, CameraRail& def)
+{
+    Visit(ar, def.nodes);
+}
+
+template<class A>
+void Visit(A& ar, CollisionBox& def)
+{
+    Visit(ar, def.nodes);
+}
+
+template<class A>
+void Visit(A& ar, Cinecam& def)
+{
+    Visit(ar, def.position);
+    Visit(ar, def.nodes);
+    Visit(ar, def.spring);
+    Visit(ar, def.damping);
+    Visit(ar, def.node_mass);
+    Visit(ar, def.beam_defaults);
+    Visit(ar, def.node_defaults);
+}
+
+template<class A>
+void Visit(A& ar, Command2& def)
+{
+    Visit(ar, def.nodes);
+    Visit(ar, def.shorten_rate);
+    Visit(ar, def.lengthen_rate);
+    Visit(ar, def.max_contraction);
+    Visit(ar, def.max_extension);
+    Visit(ar, def.contract_key);
+    Visit(ar, def.extend_key);
+    Visit(ar, def.description);
+    Visit(ar, def.inertia);
+    Visit(ar, def.affect_engine);
+    Visit(ar, def.needs_engine);
+    Visit(ar, def.plays_sound);
+    Visit(ar, def.beam_defaults);
+    Visit(ar, def.inertia_defaults);
+    Visit(ar, def.detacher_group);
+    Visit(ar, def.option_i_invisible);
+    Visit(ar, def.option_r_rope);
+    Visit(ar, def.option_c_auto_center);
+    Visit(ar, def.option_f_not_faster);
+    Visit(ar, def.option_p_1press);
+    Visit(ar, def.option_o_1press_center);
+}
+
+template<class A>
+void Visit(A& ar, CruiseControl& def)
+{
+    Visit(ar, def.min_speed);
+    Visit(ar, def.autobrake);
+}
+
+template<class A>
+void Visit(A& ar, CustomDashboardInput& def)
+{
+    Visit(ar, def.name);
+    Visit(ar, def.data_type);
+}
+
+template<class A>
+void Visit(A& ar, DefaultSkin& def)
+{
+    Visit(ar, def.skin_name);
+}
+
+template<class A>
+void Visit(A& ar, Engine& def)
+{
+    Visit(ar, def.shift_down_rpm);
+    Visit(ar, def.shift_up_rpm);
+    Visit(ar, def.torque);
+    Visit(ar, def.global_gear_ratio);
+    Visit(ar, def.reverse_gear_ratio);
+    Visit(ar, def.neutral_gear_ratio);
+    Visit(ar, def.gear_ratios);
+}
+
+template<class A>
+void Visit(A& ar, Engoption& def)
+{
+    Visit(ar, def.inertia);
+    Visit(ar, def.type);
+    Visit(ar, def.clutch_force);
+    Visit(ar, def.shift_time);
+    Visit(ar, def.clutch_time);
+    Visit(ar, def.post_shift_time);
+    Visit(ar, def.idle_rpm);
+    Visit(ar, def.stall_rpm);
+    Visit(ar, def.max_idle_mixture);
+    Visit(ar, def.min_idle_mixture);
+    Visit(ar, def.braking_torque);
+}
+
+template<class A>
+void Visit(A& ar, Engturbo& def)
+{
+    Visit(ar, def.version);
+    Visit(ar, def.tinertiaFactor);
+    Visit(ar, def.nturbos);
+    Visit(ar, def.param1);
+    Visit(ar, def.param2);
+    Visit(ar, def.param3);
+    Visit(ar, def.param4);
+    Visit(ar, def.param5);
+    Visit(ar, def.param6);
+    Visit(ar, def.param7);
+    Visit(ar, def.param8);
+    Visit(ar, def.param9);
+    Visit(ar, def.param10);
+    Visit(ar, def.param11);
+}
+
+template<class A>
+void Visit(A& ar, Exhaust& def)
+{
+    Visit(ar, def.reference_node);
+    Visit(ar, def.direction_node);
+    Visit(ar, def.particle_name);
+}
+
+template<class A>
+void Visit(A& ar, ExtCamera& def)
+{
+    Visit(ar, def.mode);
+    Visit(ar, def.node);
+}
+
+template<class A>
+void Visit(A& ar, FileFormatVersion& def)
+{
+    Visit(ar, def.version);
+}
+
+template<class A>
+void Visit(A& ar, Fileinfo& def)
+{
+    Visit(ar, def.unique_id);
+    Visit(ar, def.category_id);
+    Visit(ar, def.file_version);
+}
+
+template<class A>
+void Visit(A& ar, Flare2& def)
+{
+    Visit(ar, static_cast<FlareBase&>(def));
+}
+
+template<class A>
+void Visit(A& ar, Flare3& def)
+{
+    Visit(ar, static_cast<FlareBase&>(def));
+    Visit(ar, def.inertia_defaults);
+}
+
+template<class A>
+void Visit(A& ar, FlaregroupNoImport& def)
+{
+    Visit(ar, def.type);
+    Visit(ar, def.control_number);
+}
+
+template<class A>
+void Visit(A& ar, Flexbody& def)
+{
+    Visit(ar, def.reference_node);
+    Visit(ar, def.x_axis_node);
+    Visit(ar, def.y_axis_node);
+    Visit(ar, def.offset);
+    Visit(ar, def.rotation);
+    Visit(ar, def.mesh_name);
+    Visit(ar, def.animations);
+    Visit(ar, def.node_list_to_import);
+    Visit(ar, def.node_list);
+    Visit(ar, def.forvert);
+    Visit(ar, def.camera_settings);
+}
+
+template<class A>
+void Visit(A& ar, FlexBodyWheel& def)
+{
+    Visit(ar, static_cast<BaseWheel2&>(def));
+    Visit(ar, def.side);
+    Visit(ar, def.rim_springiness);
+    Visit(ar, def.rim_damping);
+    Visit(ar, def.rim_mesh_name);
+    Visit(ar, def.tyre_mesh_name);
+}
+
+template<class A>
+void Visit(A& ar, Fusedrag& def)
+{
+    Visit(ar, def.autocalc);
+    Visit(ar, def.front_node);
+    Visit(ar, def.rear_node);
+    Visit(ar, def.approximate_width);
+    Visit(ar, def.airfoil_name);
+    Visit(ar, def.area_coefficient);
+}
+
+template<class A>
+void Visit(A& ar, Globals& def)
+{
+    Visit(ar, def.dry_mass);
+    Visit(ar, def.cargo_mass);
+    Visit(ar, def.material_name);
+}
+
+template<class A>
+void Visit(A& ar, Guid& def)
+{
+    Visit(ar, def.guid);
+}
+
+template<class A>
+void Visit(A& ar, GuiSettings& def)
+{
+    Visit(ar, def.key);
+    Visit(ar, def.value);
+}
+
+template<class A>
+void Visit(A& ar, Help& def)
+{
+    Visit(ar, def.material);
+}
+
+template<class A>
+void Visit(A& ar, Hook& def)
+{
+    Visit(ar, def.node);
+    Visit(ar, def.option_hook_range);
+    Visit(ar, def.option_speed_coef);
+    Visit(ar, def.option_max_force);
+    Visit(ar, def.option_hookgroup);
+    Visit(ar, def.option_lockgroup);
+    Visit(ar, def.option_timer);
+    Visit(ar, def.option_min_range_meters);
+
+    // Bit fields can't be bound to a reference
+    uint8_t flags[] = { def.flag_self_lock, def.flag_auto_lock, def.flag_no_disable, def.flag_no_rope, def.flag_visible };
+    Visit(ar, flags);
+    def.flag_self_lock  = flags[0] != 0;
+    def.flag_auto_lock  = flags[1] != 0;
+    def.flag_no_disable = flags[2] != 0;
+    def.flag_no_rope    = flags[3] != 0;
+    def.flag_visible    = flags[4] != 0;
+}
+
+template<class A>
+void Visit(A& ar, Hydro& def)
+{
+    Visit(ar, def.nodes);
+    Visit(ar, def.lenghtening_factor);
+    Visit(ar, def.options);
+    Visit(ar, def.inertia);
+    Visit(ar, def.inertia_defaults);
+    Visit(ar, def.beam_defaults);
+    Visit(ar, def.detacher_group);
+}
+
+template<class A>
+void Visit(A& ar, InterAxle& def)
+{
+    Visit(ar, def.a1);
+    Visit(ar, def.a2);
+    Visit(ar, def.options);
+}
+
+template<class A>
+void Visit(A& ar, Lockgroup& def)
+{
+    Visit(ar, def.number);
+    Visit(ar, def.nodes);
+}
+
+template<class A>
+void Visit(A& ar, ManagedMaterial& def)
+{
+    Visit(ar, def.name);
+    Visit(ar, def.type);
+    Visit(ar, def.options);
+    Visit(ar, def.diffuse_map);
+    Visit(ar, def.damaged_diffuse_map);
+    Visit(ar, def.specular_map);
+}
+
+template<class A>
+void Visit(A& ar, MaterialFlareBinding& def)
+{
+    Visit(ar, def.flare_number);
+    Visit(ar, def.material_name);
+}
+
+template<class A>
+void Visit(A& ar, MeshWheel& def)
+{
+    Visit(ar, static_cast<BaseMeshWheel&>(def));
+}
+
+template<class A>
+void Visit(A& ar, MeshWheel2& def)
+{
+    Visit(ar, static_cast<BaseMeshWheel&>(def));
+}
+
+template<class A>
+void Visit(A& ar, Minimass& def)
+{
+    Visit(ar, def.global_min_mass_Kg);
+    Visit(ar, def.option);
+}
+
+template<class A>
+void Visit(A& ar, Particle& def)
+{
+    Visit(ar, def.emitter_node);
+    Visit(ar, def.reference_node);
+    Visit(ar, def.particle_system_name);
+}
+
+template<class A>
+void Visit(A& ar, Pistonprop& def)
+{
+    Visit(ar, def.reference_node);
+    Visit(ar, def.axis_node);
+    Visit(ar, def.blade_tip_nodes);
+    Visit(ar, def.couple_node);
+    Visit(ar, def.turbine_power_kW);
+    Visit(ar, def.pitch);
+    Visit(ar, def.airfoil);
+}
+
+template<class A>
+void Visit(A& ar, Prop& def)
+{
+    Visit(ar, def.reference_node);
+    Visit(ar, def.x_axis_node);
+    Visit(ar, def.y_axis_node);
+    Visit(ar, def.offset);
+    Visit(ar, def.rotation);
+    Visit(ar, def.mesh_name);
+    Visit(ar, def.animations);
+    Visit(ar, def.camera_settings);
+    Visit(ar, def.special);
+    Visit(ar, def.special_prop_beacon);
+    Visit(ar, def.special_prop_dashboard);
+}
+
+template<class A>
+void Visit(A& ar, RailGroup& def)
+{
+    Visit(ar, def.id);
+    Visit(ar, def.node_list);
+}
+
+template<class A>
+void Visit(A& ar, Ropable& def)
+{
+    Visit(ar, def.node);
+    Visit(ar, def.group);
+    Visit(ar, def.has_multilock);
+}
+
+template<class A>
+void Visit(A& ar, Rope& def)
+{
+    Visit(ar, def.root_node);
+    Visit(ar, def.end_node);
+    Visit(ar, def.invisible);
+    Visit(ar, def.beam_defaults);
+    Visit(ar, def.detacher_group);
+}
+
+template<class A>
+void Visit(A& ar, Rotator& def)
+{
+    Visit(ar, def.axis_nodes);
+    Visit(ar, def.base_plate_nodes);
+    Visit(ar, def.rotating_plate_nodes);
+    Visit(ar, def.rate);
+    Visit(ar, def.spin_left_key);
+    Visit(ar, def.spin_right_key);
+    Visit(ar, def.inertia);
+    Visit(ar, def.inertia_defaults);
+    Visit(ar, def.engine_coupling);
+    Visit(ar, def.needs_engine);
+}
+
+template<class A>
+void Visit(A& ar, Rotator2& def)
+{
+    Visit(ar, static_cast<Rotator&>(def));
+    Visit(ar, def.rotating_force);
+    Visit(ar, def.tolerance);
+    Visit(ar, def.description);
+}
+
+template<class A>
+void Visit(A& ar, Screwprop& def)
+{
+    Visit(ar, def.prop_node);
+    Visit(ar, def.back_node);
+    Visit(ar, def.top_node);
+    Visit(ar, def.power);
+}
+
+template<class A>
+void Visit(A& ar, Script& def)
+{
+    Visit(ar, def.filename);
+}
+
+template<class A>
+void Visit(A& ar, Shock& def)
+{
+    Visit(ar, def.nodes);
+    Visit(ar, def.spring_rate);
+    Visit(ar, def.damping);
+    Visit(ar, def.short_bound);
+    Visit(ar, def.long_bound);
+    Visit(ar, def.precompression);
+    Visit(ar, def.options);
+    Visit(ar, def.beam_defaults);
+    Visit(ar, def.detacher_group);
+}
+
+template<class A>
+void Visit(A& ar, Shock2& def)
+{
+    Visit(ar, def.nodes);
+    Visit(ar, def.spring_in);
+    Visit(ar, def.damp_in);
+    Visit(ar, def.progress_factor_spring_in);
+    Visit(ar, def.progress_factor_damp_in);
+    Visit(ar, def.spring_out);
+    Visit(ar, def.damp_out);
+    Visit(ar, def.progress_factor_spring_out);
+    Visit(ar, def.progress_factor_damp_out);
+    Visit(ar, def.short_bound);
+    Visit(ar, def.long_bound);
+    Visit(ar, def.precompression);
+    Visit(ar, def.options);
+    Visit(ar, def.beam_defaults);
+    Visit(ar, def.detacher_group);
+}
+
+template<class A>
+void Visit(A& ar, Shock3& def)
+{
+    Visit(ar, def.nodes);
+    Visit(ar, def.spring_in);
+    Visit(ar, def.damp_in);
+    Visit(ar, def.spring_out);
+    Visit(ar, def.damp_out);
+    Visit(ar, def.damp_in_slow);
+    Visit(ar, def.split_vel_in);
+    Visit(ar, def.damp_in_fast);
+    Visit(ar, def.damp_out_slow);
+    Visit(ar, def.split_vel_out);
+    Visit(ar, def.damp_out_fast);
+    Visit(ar, def.short_bound);
+    Visit(ar, def.long_bound);
+    Visit(ar, def.precompression);
+    Visit(ar, def.options);
+    Visit(ar, def.beam_defaults);
+    Visit(ar, def.detacher_group);
+}
+
+template<class A>
+void Visit(A& ar, CollisionRange& def)
+{
+    Visit(ar, def.node_collision_range);
+}
+
+template<class A>
+void Visit(A& ar, SkeletonSettings& def)
+{
+    Visit(ar, def.visibility_range_meters);
+    Visit(ar, def.beam_thickness_meters);
+}
+
+template<class A>
+void Visit(A& ar, SlideNode& def)
+{
+    Visit(ar, def.slide_node);
+    Visit(ar, def.rail_node_ranges);
+    Visit(ar, def.constraint_flags);
+    Visit(ar, def.spring_rate);
+    Visit(ar, def._spring_rate_set);
+    Visit(ar, def.break_force);
+    Visit(ar, def._break_force_set);
+    Visit(ar, def.tolerance);
+    Visit(ar, def._tolerance_set);
+    Visit(ar, def.attachment_rate);
+    Visit(ar, def._attachment_rate_set);
+    Visit(ar, def.railgroup_id);
+    Visit(ar, def._railgroup_id_set);
+    Visit(ar, def.max_attach_dist);
+    Visit(ar, def._max_attach_dist_set);
+}
+
+template<class A>
+void Visit(A& ar, SoundSource& def)
+{
+    Visit(ar, def.node);
+    Visit(ar, def.sound_script_name);
+}
+
+template<class A>
+void Visit(A& ar, SoundSource2& def)
+{
+    Visit(ar, static_cast<SoundSource&>(def));
+    Visit(ar, def.mode);
+}
+
+template<class A>
+void Visit(A& ar, SpeedLimiter& def)
+{
+    Visit(ar, def.max_speed);
+    Visit(ar, def.is_enabled);
+}
+
+template<class A>
+void Visit(A& ar, Submesh& def)
+{
+    Visit(ar, def.backmesh);
+    Visit(ar, def.texcoords);
+    Visit(ar, def.cab_triangles);
+}
+
+template<class A>
+void Visit(A& ar, Tie& def)
+{
+    Visit(ar, def.root_node);
+    Visit(ar, def.max_reach_length);
+    Visit(ar, def.auto_shorten_rate);
+    Visit(ar, def.min_length);
+    Visit(ar, def.max_length);
+    Visit(ar, def.options);
+    Visit(ar, def.max_stress);
+    Visit(ar, def.beam_defaults);
+    Visit(ar, def.detacher_group);
+    Visit(ar, def.group);
+}
+
+template<class A>
+void Visit(A& ar, TorqueCurve& def)
+{
+    Visit(ar, def.samples);
+    Visit(ar, def.predefined_func_name);
+}
+
+template<class A>
+void Visit(A& ar, TractionControl& def)
+{
+    Visit(ar, def.regulation_force);
+    Visit(ar, def.wheel_slip);
+    Visit(ar, def.fade_speed);
+    Visit(ar, def.pulse_per_sec);
+    Visit(ar, def.attr_is_on);
+    Visit(ar, def.attr_no_dashboard);
+    Visit(ar, def.attr_no_toggle);
+}
+
+template<class A>
+void Visit(A& ar, TransferCase& def)
+{
+    Visit(ar, def.a1);
+    Visit(ar, def.a2);
+    Visit(ar, def.has_2wd);
+    Visit(ar, def.has_2wd_lo);
+    Visit(ar, def.gear_ratios);
+}
+
+template<class A>
+void Visit(A& ar, Trigger& def)
+{
+    Visit(ar, def.nodes);
+    Visit(ar, def.contraction_trigger_limit);
+    Visit(ar, def.expansion_trigger_limit);
+    Visit(ar, def.options);
+    Visit(ar, def.boundary_timer);
+    Visit(ar, def.beam_defaults);
+    Visit(ar, def.detacher_group);
+    Visit(ar, def.shortbound_trigger_action);
+    Visit(ar, def.longbound_trigger_action);
+}
+
+template<class A>
+void Visit(A& ar, Turbojet& def)
+{
+    Visit(ar, def.front_node);
+    Visit(ar, def.back_node);
+    Visit(ar, def.side_node);
+    Visit(ar, def.is_reversable);
+    Visit(ar, def.dry_thrust);
+    Visit(ar, def.wet_thrust);
+    Visit(ar, def.front_diameter);
+    Visit(ar, def.back_diameter);
+    Visit(ar, def.nozzle_length);
+}
+
+template<class A>
+void Visit(A& ar, Turboprop2& def)
+{
+    Visit(ar, def.reference_node);
+    Visit(ar, def.axis_node);
+    Visit(ar, def.blade_tip_nodes);
+    Visit(ar, def.turbine_power_kW);
+    Visit(ar, def.airfoil);
+    Visit(ar, def.couple_node);
+}
+
+template<class A>
+void Visit(A& ar, VideoCamera& def)
+{
+    Visit(ar, def.reference_node);
+    Visit(ar, def.left_node);
+    Visit(ar, def.bottom_node);
+    Visit(ar, def.alt_reference_node);
+    Visit(ar, def.alt_orientation_node);
+    Visit(ar, def.offset);
+    Visit(ar, def.rotation);
+    Visit(ar, def.field_of_view);
+    Visit(ar, def.texture_width);
+    Visit(ar, def.texture_height);
+    Visit(ar, def.min_clip_distance);
+    Visit(ar, def.max_clip_distance);
+    Visit(ar, def.camera_role);
+    Visit(ar, def.camera_mode);
+    Visit(ar, def.material_name);
+    Visit(ar, def.camera_name);
+}
+
+template<class A>
+void Visit(A& ar, WheelDetacher& def)
+{
+    Visit(ar, def.wheel_id);
+    Visit(ar, def.detacher_group);
+}
+
+template<class A>
+void Visit(A& ar, Wheel& def)
+{
+    Visit(ar, static_cast<BaseWheel&>(def));
+    Visit(ar, def.radius);
+    Visit(ar, def.springiness);
+    Visit(ar, def.damping);
+    Visit(ar, def.face_material_name);
+    Visit(ar, def.band_material_name);
+}
+
+template<class A>
+void Visit(A& ar, Wheel2& def)
+{
+    Visit(ar, static_cast<BaseWheel2&>(def));
+    Visit(ar, def.rim_springiness);
+    Visit(ar, def.rim_damping);
+    Visit(ar, def.face_material_name);
+    Visit(ar, def.band_material_name);
+}
+
+template<class A>
+void Visit(A& ar, Wing& def)
+{
+    Visit(ar, def.nodes);
+    Visit(ar, def.tex_coords);
+    Visit(ar, def.control_surface);
+    Visit(ar, def.chord_point);
+    Visit(ar, def.min_deflection);
+    Visit(ar, def.max_deflection);
+    Visit(ar, def.airfoil);
+    Visit(ar, def.efficacy_coef);
+}
+
+// ----------------------------------------------------------------------------
+// The document
+
+template<class A>
+void Visit(A& ar, Document::Module& m)
+{
+    // NOTE: `origin_addonpart` is not persisted, parsed documents never have it.
+    Visit(ar, m.airbrakes);
+    Visit(ar, m.animators);
+    Visit(ar, m.antilockbrakes);
+    Visit(ar, m.assetpacks);
+    Visit(ar, m.author);
+    Visit(ar, m.axles);
+    Visit(ar, m.beams);
+    Visit(ar, m.brakes);
+    Visit(ar, m.cameras);
+    Visit(ar, m.camerarail);
+    Visit(ar, m.collisionboxes);
+    Visit(ar, m.cinecam);
+    Visit(ar, m.commands2);
+    Visit(ar, m.cruisecontrol);
+    Visit(ar, m.contacters);
+    Visit(ar, m.customdashboardinputs);
+    Visit(ar, m.default_skin);
+    Visit(ar, m.description);
+    Visit(ar, m.engine);
+    Visit(ar, m.engoption);
+    Visit(ar, m.engturbo);
+    Visit(ar, m.exhausts);
+    Visit(ar, m.extcamera);
+    Visit(ar, m.fileformatversion);
+    Visit(ar, m.fixes);
+    Visit(ar, m.fileinfo);
+    Visit(ar, m.flares2);
+    Visit(ar, m.flares3);
+    Visit(ar, m.flaregroups_no_import);
+    Visit(ar, m.flexbodies);
+    Visit(ar, m.flexbodywheels);
+    Visit(ar, m.fusedrag);
+    Visit(ar, m.globals);
+    Visit(ar, m.guid);
+    Visit(ar, m.guisettings);
+    Visit(ar, m.help);
+    Visit(ar, m.hooks);
+    Visit(ar, m.hydros);
+    Visit(ar, m.interaxles);
+    Visit(ar, m.lockgroups);
+    Visit(ar, m.managedmaterials);
+    Visit(ar, m.materialflarebindings);
+    Visit(ar, m.meshwheels);
+    Visit(ar, m.meshwheels2);
+    Visit(ar, m.minimass);
+    Visit(ar, m.nodes);
+    Visit(ar, m.particles);
+    Visit(ar, m.pistonprops);
+    Visit(ar, m.props);
+    Visit(ar, m.railgroups);
+    Visit(ar, m.ropables);
+    Visit(ar, m.ropes);
+    Visit(ar, m.rotators);
+    Visit(ar, m.rotators2);
+    Visit(ar, m.screwprops);
+    Visit(ar, m.scripts);
+    Visit(ar, m.shocks);
+    Visit(ar, m.shocks2);
+    Visit(ar, m.shocks3);
+    Visit(ar, m.set_collision_range);
+    Visit(ar, m.set_skeleton_settings);
+    Visit(ar, m.slidenodes);
+    Visit(ar, m.soundsources);
+    Visit(ar, m.soundsources2);
+    Visit(ar, m.speedlimiter);
+    Visit(ar, m.submesh_groundmodel);
+    Visit(ar, m.submeshes);
+    Visit(ar, m.ties);
+    Visit(ar, m.torquecurve);
+    Visit(ar, m.tractioncontrol);
+    Visit(ar, m.transfercase);
+    Visit(ar, m.triggers);
+    Visit(ar, m.turbojets);
+    Visit(ar, m.turboprops2);
+    Visit(ar, m.videocameras);
+    Visit(ar, m.wheeldetachers);
+    Visit(ar, m.wheels);
+    Visit(ar, m.wheels2);
+    Visit(ar, m.wings);
+
+    Visit(ar, m._hint_nodes12_start_linenumber);
+    Visit(ar, m._hint_nodes12_end_linenumber);
+    Visit(ar, m._hint_beams_start_linenumber);
+    Visit(ar, m._hint_beams_end_linenumber);
+    Visit(ar, m._comments);
+}
+
+template<class A>
+void VisitModule(A& ar, std::shared_ptr<Document::Module>& module) // `Module` isn't default-constructible
+{
+    std::string name = (module) ? module->name : "";
+    Visit(ar, name);
+    if (A::IS_READING)
+    {
+        module = std::make_shared<Document::Module>(name);
+    }
+    Visit(ar, *module);
+}
+
+template<class A>
+void Visit(A& ar, Document& doc)
+{
+    Visit(ar, doc.hide_in_chooser);
+    Visit(ar, doc.enable_advanced_deformation);
+    Visit(ar, doc.slide_nodes_connect_instantly);
+    Visit(ar, doc.rollon);
+    Visit(ar, doc.forward_commands);
+    Visit(ar, doc.import_commands);
+    Visit(ar, doc.lockgroup_default_nolock);
+    Visit(ar, doc.rescuer);
+    Visit(ar, doc.disable_default_sounds);
+    Visit(ar, doc.name);
+    Visit(ar, doc.hash);
+
+    VisitModule(ar, doc.root_module);
+
+    uint32_t num_user_modules = static_cast<uint32_t>(doc.user_modules.size());
+    Visit(ar, num_user_modules);
+    if (A::IS_READING)
+    {
+        if (!ar.CanRead(num_user_modules))
+            return;
+        doc.user_modules.clear();
+        for (uint32_t i = 0; i < num_user_modules && ar.IsOk(); ++i)
+        {
+            std::shared_ptr<Document::Module> module;
+            VisitModule(ar, module);
+            doc.user_modules.insert(std::make_pair(module->name, module));
+        }
+    }
+    else
+    {
+        for (auto& entry: doc.user_modules)
+        {
+            VisitModule(ar, entry.second);
+        }
+    }
+}
+
+} // namespace
+
+std::string DocumentCache::MakeKey(std::string const& file_hash)
+{
+    // The parser and the game's defaults may change between versions, even if the data structures don't.
+    return fmt::format("{}|{}", file_hash, ROR_VERSION_STRING);
+}
+
+std::string DocumentCache::MakeFilename(std::string const& file_hash)
+{
+    return RoR::PathCombine(RoR::App::sys_cache_dir->getStr(), fmt::format("rigdef_{}.dat", file_hash));
+}
+
+DocumentCache::ResultCode DocumentCache::SaveFile(std::string const& filename, DocumentPtr const& doc)
+{
+    DocumentWriter writer;
+    Visit(writer, *doc);
+    std::vector<char> const& data = writer.GetData();
+    const std::string key = DocumentCache::MakeKey(doc->hash);
+
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return RESULT_CODE_ERR_FOPEN_FAILED;
+    }
+
+    const char padding[4] = {};
+    bool ok = true;
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(FileHeader));
+    std::strncpy(header.signature, SIGNATURE, sizeof(header.signature));
+    header.file_format_version = FILE_FORMAT_VERSION;
+    header.key_len = static_cast<uint32_t>(key.size());
+    header.data_size = static_cast<uint32_t>(data.size());
+    ok = ok && fwrite(&header, sizeof(FileHeader), 1, file) == 1;
+    ok = ok && fwrite(key.data(), 1, key.size(), file) == key.size();
+    ok = ok && fwrite(padding, 1, PaddedLength(key.size()) - key.size(), file) == PaddedLength(key.size()) - key.size();
+    ok = ok && fwrite(data.data(), 1, data.size(), file) == data.size();
+
+    fclose(file);
+    if (!ok)
+    {
+        std::remove(filename.c_str()); // Don't leave a half-written file behind.
+        return RESULT_CODE_FWRITE_OUTPUT_INCOMPLETE;
+    }
+    return RESULT_CODE_OK;
+}
+
+DocumentCache::ResultCode DocumentCache::LoadFile(std::string const& filename, std::string const& file_hash, DocumentPtr& out_doc)
+{
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (file == nullptr)
+    {
+        return RESULT_CODE_ERR_FOPEN_FAILED;
+    }
+
+    // Read it whole at once
+    std::vector<char> buf;
+    fseek(file, 0, SEEK_END);
+    const long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (file_size > 0)
+    {
+        buf.resize(static_cast<size_t>(file_size));
+        buf.resize(fread(buf.data(), 1, buf.size(), file));
+    }
+    fclose(file);
+
+    FileHeader header;
+    if (buf.size() < sizeof(FileHeader))
+    {
+        return RESULT_CODE_ERR_FILE_TRUNCATED;
+    }
+    std::memcpy(&header, buf.data(), sizeof(FileHeader));
+    if (std::strncmp(header.signature, SIGNATURE, sizeof(header.signature)) != 0)
+    {
+        return RESULT_CODE_ERR_SIGNATURE_MISMATCH;
+    }
+    if (header.file_format_version != FILE_FORMAT_VERSION)
+    {
+        return RESULT_CODE_ERR_VERSION_MISMATCH;
+    }
+
+    size_t pos = sizeof(FileHeader);
+    if (pos + PaddedLength(header.key_len) + header.data_size > buf.size())
+    {
+        return RESULT_CODE_ERR_FILE_TRUNCATED;
+    }
+    if (DocumentCache::MakeKey(file_hash) != std::string(buf.data() + pos, header.key_len))
+    {
+        return RESULT_CODE_ERR_KEY_MISMATCH;
+    }
+    pos += PaddedLength(header.key_len);
+
+    DocumentPtr doc = std::make_shared<Document>();
+    DocumentReader reader(buf.data() + pos, header.data_size);
+    Visit(reader, *doc);
+    if (!reader.IsOk() || !reader.IsFinished())
+    {
+        return RESULT_CODE_ERR_FILE_TRUNCATED;
+    }
+
+    out_doc = doc;
+    return RESULT_CODE_OK;
+}
@@ -0,0 +1,72 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Binary snapshot of a parsed+validated `RigDef::Document`, see `DocumentCache`.
+
+#pragma once
+
+#include "RigDef_File.h"
+
+#include <string>
+
+namespace RigDef
+{
+
+/// Persists parsed and validated truck documents in the cache dir, so spawning a vehicle
+/// in a later session skips the `Parser` and `Validator` and reads a single file instead.
+/// A file is keyed by the SHA1 of the truckfile (see `Document::hash`) and the game version;
+/// `FILE_FORMAT_VERSION` must be bumped whenever the structures in 'RigDef_File.h' change.
+/// Addon-part modules are not persisted - the cache only holds what the truckfile itself defines.
+class DocumentCache
+{
+public:
+    enum ResultCode
+    {
+        RESULT_CODE_OK,
+        RESULT_CODE_ERR_FOPEN_FAILED,
+        RESULT_CODE_ERR_SIGNATURE_MISMATCH,
+        RESULT_CODE_ERR_VERSION_MISMATCH,
+        RESULT_CODE_ERR_KEY_MISMATCH,
+        RESULT_CODE_ERR_FILE_TRUNCATED,
+        RESULT_CODE_FWRITE_OUTPUT_INCOMPLETE
+    };
+
+    static const char*        SIGNATURE;
+    static const unsigned int FILE_FORMAT_VERSION = 1;
+
+    static std::string MakeFilename(std::string const& file_hash); //!< Full path in the cache dir.
+
+    static ResultCode  SaveFile(std::string const& filename, DocumentPtr const& doc);
+    static ResultCode  LoadFile(std::string const& filename, std::string const& file_hash, DocumentPtr& out_doc);
+
+private:
+    struct FileHeader
+    {
+        char     signature[16];
+        uint32_t file_format_version;
+        uint32_t key_len;         //!< Followed by the key, padded to 4 bytes, then the document data
+        uint32_t data_size;       //!< In bytes
+    };
+
+    static std::string MakeKey(std::string const& file_hash);
+    static size_t      PaddedLength(size_t len)        { return (len + 3) & ~size_t(3); }
+};
+
+} // namespace RigDef
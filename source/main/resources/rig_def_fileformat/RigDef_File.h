@@ -35,6 +35,7 @@
     * all option strings should have parsing function `GetArgWhatever(int index)`.
     * option-strings should be stored as bitmasks (unless order matters). If only single option is acceptable, use the enum directly.
     * all data structs should contain only arguments, in order. Helper data (where needed) must be prefixed with `_`.
+    * any data change must be reflected in 'RigDef_DocumentCache.cpp', with `DocumentCache::FILE_FORMAT_VERSION` bumped.
 */
 
 #pragma once
@@ -100,6 +100,7 @@ struct Node
 
         inline bool     IsValidAnyState() const       { return GetImportState_IsValid() || GetRegularState_IsValid(); }
         inline unsigned GetLineNumber() const         { return m_line_number; }
+        inline unsigned GetFlags() const              { return m_flags; }
 
         void Invalidate();
         std::string ToString() const;
@@ -32,7 +32,6 @@
 #include "CacheSystem.h"
 #include "Console.h"
 #include "RigDef_File.h"
-#include "RigDef_Regexes.h"
 #include "Utils.h"
 
 #include <OgreException.h>
@@ -41,6 +40,9 @@
 #include <OgreStringConverter.h>
 
 #include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 
 using namespace RoR;
 
@@ -67,6 +69,299 @@ inline bool StrEqualsNocase(std::string const & s1, std::string const & s2)
     return true;
 }
 
+inline char ToLowerAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (c + ('a' - 'A')) : c;
+}
+
+inline bool IsKeywordChar(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || (c == '_');
+}
+
+inline bool IsDigit(char c)
+{
+    return (c >= '0' && c <= '9');
+}
+
+// --------------------------------------------------------------------------
+//  Keyword identification
+// --------------------------------------------------------------------------
+
+/// How a keyword must be delimited from the rest of the line.
+enum class KeywordForm
+{
+    BLOCK,              //!< Alone on the line, only whitespace may follow.
+    INLINE,             //!< Followed by a separator (space/comma/colon/pipe, see `IsSeparator()`) and arguments.
+    INLINE_UNSEPARATED, //!< Arguments may follow without a separator; only `forset`, see BEWARE OF QUIRKS in `ProcessForsetLine()`.
+};
+
+struct KeywordDef
+{
+    const char* name;
+    KeywordForm form;
+};
+
+// IMPORTANT! Indexed by `Keyword` value minus 1 - if you add a keyword to the enum, you must also add it here.
+static const KeywordDef KEYWORD_DEFS[] =
+{
+    { "add_animation",                 KeywordForm::INLINE },
+    { "airbrakes",                     KeywordForm::BLOCK },
+    { "animators",                     KeywordForm::BLOCK },
+    { "AntiLockBrakes",                KeywordForm::INLINE },
+    { "assetpacks",                    KeywordForm::BLOCK },
+    { "author",                        KeywordForm::INLINE },
+    { "axles",                         KeywordForm::BLOCK },
+    { "backmesh",                      KeywordForm::BLOCK },
+    { "beams",                         KeywordForm::BLOCK },
+    { "brakes",                        KeywordForm::BLOCK },
+    { "cab",                           KeywordForm::BLOCK },
+    { "camerarail",                    KeywordForm::BLOCK },
+    { "cameras",                       KeywordForm::BLOCK },
+    { "cinecam",                       KeywordForm::BLOCK },
+    { "collisionboxes",                KeywordForm::BLOCK },
+    { "commands",                      KeywordForm::BLOCK },
+    { "commands2",                     KeywordForm::BLOCK },
+    { "comment",                       KeywordForm::BLOCK },
+    { "contacters",                    KeywordForm::BLOCK },
+    { "cruisecontrol",                 KeywordForm::INLINE },
+    { "customdashboardinputs",         KeywordForm::BLOCK },
+    { "default_skin",                  KeywordForm::INLINE },
+    { "description",                   KeywordForm::BLOCK },
+    { "detacher_group",                KeywordForm::INLINE },
+    { "disabledefaultsounds",          KeywordForm::BLOCK },
+    { "enable_advanced_deformation",   KeywordForm::BLOCK },
+    { "end",                           KeywordForm::BLOCK },
+    { "end_comment",                   KeywordForm::BLOCK },
+    { "end_description",               KeywordForm::BLOCK },
+    { "end_section",                   KeywordForm::BLOCK },
+    { "engine",                        KeywordForm::BLOCK },
+    { "engoption",                     KeywordForm::BLOCK },
+    { "engturbo",                      KeywordForm::BLOCK },
+    { "envmap",                        KeywordForm::BLOCK },
+    { "exhausts",                      KeywordForm::BLOCK },
+    { "extcamera",                     KeywordForm::INLINE },
+    { "fileformatversion",             KeywordForm::INLINE },
+    { "fileinfo",                      KeywordForm::INLINE },
+    { "fixes",                         KeywordForm::BLOCK },
+    { "flares",                        KeywordForm::BLOCK },
+    { "flares2",                       KeywordForm::BLOCK },
+    { "flares3",                       KeywordForm::BLOCK },
+    { "flaregroups_no_import",         KeywordForm::BLOCK },
+    { "flexbodies",                    KeywordForm::BLOCK },
+    { "flexbody_camera_mode",          KeywordForm::INLINE },
+    { "flexbodywheels",                KeywordForm::BLOCK },
+    { "forset",                        KeywordForm::INLINE_UNSEPARATED },
+    { "forvert",                       KeywordForm::INLINE },
+    { "forwardcommands",               KeywordForm::BLOCK },
+    { "fusedrag",                      KeywordForm::BLOCK },
+    { "globals",                       KeywordForm::BLOCK },
+    { "guid",                          KeywordForm::INLINE },
+    { "guisettings",                   KeywordForm::BLOCK },
+    { "help",                          KeywordForm::BLOCK },
+    { "hideInChooser",                 KeywordForm::BLOCK },
+    { "hookgroup",                     KeywordForm::BLOCK },
+    { "hooks",                         KeywordForm::BLOCK },
+    { "hydros",                        KeywordForm::BLOCK },
+    { "importcommands",                KeywordForm::BLOCK },
+    { "interaxles",                    KeywordForm::BLOCK },
+    { "lockgroups",                    KeywordForm::BLOCK },
+    { "lockgroup_default_nolock",      KeywordForm::BLOCK },
+    { "managedmaterials",              KeywordForm::BLOCK },
+    { "materialflarebindings",         KeywordForm::BLOCK },
+    { "meshwheels",                    KeywordForm::BLOCK },
+    { "meshwheels2",                   KeywordForm::BLOCK },
+    { "minimass",                      KeywordForm::BLOCK },
+    { "nodecollision",                 KeywordForm::BLOCK },
+    { "nodes",                         KeywordForm::BLOCK },
+    { "nodes2",                        KeywordForm::BLOCK },
+    { "particles",                     KeywordForm::BLOCK },
+    { "pistonprops",                   KeywordForm::BLOCK },
+    { "prop_camera_mode",              KeywordForm::INLINE },
+    { "props",                         KeywordForm::BLOCK },
+    { "railgroups",                    KeywordForm::BLOCK },
+    { "rescuer",                       KeywordForm::BLOCK },
+    { "rigidifiers",                   KeywordForm::BLOCK },
+    { "rollon",                        KeywordForm::BLOCK },
+    { "ropables",                      KeywordForm::BLOCK },
+    { "ropes",                         KeywordForm::BLOCK },
+    { "rotators",                      KeywordForm::BLOCK },
+    { "rotators2",                     KeywordForm::BLOCK },
+    { "screwprops",                    KeywordForm::BLOCK },
+    { "scripts",                       KeywordForm::BLOCK },
+    { "section",                       KeywordForm::INLINE },
+    { "sectionconfig",                 KeywordForm::INLINE },
+    { "set_beam_defaults",             KeywordForm::INLINE },
+    { "set_beam_defaults_scale",       KeywordForm::INLINE },
+    { "set_collision_range",           KeywordForm::INLINE },
+    { "set_default_minimass",          KeywordForm::INLINE },
+    { "set_inertia_defaults",          KeywordForm::INLINE },
+    { "set_managedmaterials_options",  KeywordForm::INLINE },
+    { "set_node_defaults",             KeywordForm::INLINE },
+    { "set_shadows",                   KeywordForm::BLOCK },
+    { "set_skeleton_settings",         KeywordForm::INLINE },
+    { "shocks",                        KeywordForm::BLOCK },
+    { "shocks2",                       KeywordForm::BLOCK },
+    { "shocks3",                       KeywordForm::BLOCK },
+    { "slidenode_connect_instantly",   KeywordForm::BLOCK },
+    { "slidenodes",                    KeywordForm::BLOCK },
+    { "SlopeBrake",                    KeywordForm::INLINE },
+    { "soundsources",                  KeywordForm::BLOCK },
+    { "soundsources2",                 KeywordForm::BLOCK },
+    { "speedlimiter",                  KeywordForm::INLINE },
+    { "submesh",                       KeywordForm::BLOCK },
+    { "submesh_groundmodel",           KeywordForm::INLINE },
+    { "texcoords",                     KeywordForm::BLOCK },
+    { "ties",                          KeywordForm::BLOCK },
+    { "torquecurve",                   KeywordForm::BLOCK },
+    { "TractionControl",               KeywordForm::INLINE },
+    { "transfercase",                  KeywordForm::BLOCK },
+    { "triggers",                      KeywordForm::BLOCK },
+    { "turbojets",                     KeywordForm::BLOCK },
+    { "turboprops",                    KeywordForm::BLOCK },
+    { "turboprops2",                   KeywordForm::BLOCK },
+    { "videocamera",                   KeywordForm::BLOCK },
+    { "wheeldetachers",                KeywordForm::BLOCK },
+    { "wheels",                        KeywordForm::BLOCK },
+    { "wheels2",                       KeywordForm::BLOCK },
+    { "wings",                         KeywordForm::BLOCK }
+};
+
+static_assert(sizeof(KEYWORD_DEFS) / sizeof(KeywordDef) == static_cast<size_t>(Keyword::WINGS), "KEYWORD_DEFS out of sync with `Keyword` enum");
+
+/// Case-insensitive lookup of keyword names - open addressing hashtable, filled once on first use.
+class KeywordTable
+{
+public:
+    static KeywordTable const& Get()
+    {
+        static const KeywordTable instance; // Thread-safe init; truckfiles are parsed on worker threads during cache updates.
+        return instance;
+    }
+
+    Keyword Find(const char* word, size_t len) const
+    {
+        for (size_t slot = Hash(word, len) & SLOT_MASK; m_slots[slot].keyword != Keyword::INVALID; slot = (slot + 1) & SLOT_MASK)
+        {
+            Slot const& s = m_slots[slot];
+            if (s.name_len == len && EqualsNocase(KEYWORD_DEFS[static_cast<int>(s.keyword) - 1].name, word, len))
+            {
+                return s.keyword;
+            }
+        }
+        return Keyword::INVALID;
+    }
+
+private:
+    static const size_t NUM_SLOTS = 512; // Power of 2, keeps the load factor under 1/4 -> probe chains are near 1.
+    static const size_t SLOT_MASK = NUM_SLOTS - 1;
+
+    struct Slot
+    {
+        Keyword keyword = Keyword::INVALID;
+        size_t  name_len = 0;
+    };
+
+    KeywordTable()
+    {
+        for (int i = 0; i < static_cast<int>(Keyword::WINGS); ++i)
+        {
+            const size_t len = std::strlen(KEYWORD_DEFS[i].name);
+            size_t slot = Hash(KEYWORD_DEFS[i].name, len) & SLOT_MASK;
+            while (m_slots[slot].keyword != Keyword::INVALID)
+            {
+                slot = (slot + 1) & SLOT_MASK;
+            }
+            m_slots[slot].keyword = static_cast<Keyword>(i + 1);
+            m_slots[slot].name_len = len;
+        }
+    }
+
+    static size_t Hash(const char* str, size_t len) // FNV-1a over lowercase chars
+    {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < len; ++i)
+        {
+            hash = (hash ^ static_cast<unsigned char>(ToLowerAscii(str[i]))) * 16777619u;
+        }
+        return hash;
+    }
+
+    static bool EqualsNocase(const char* name, const char* word, size_t len)
+    {
+        for (size_t i = 0; i < len; ++i)
+        {
+            if (ToLowerAscii(name[i]) != ToLowerAscii(word[i])) { return false; }
+        }
+        return true;
+    }
+
+    Slot m_slots[NUM_SLOTS];
+};
+
+// --------------------------------------------------------------------------
+//  Section helpers
+// --------------------------------------------------------------------------
+
+/// One comma-separated property of 'axles'/'interaxles': `w1(node node)` and/or `d(olsv)`, optionally followed by a comment.
+struct AxleProperty
+{
+    int           wheel_number = 0;       //!< 1 or 2 if `w#(...)` was given, 0 otherwise.
+    Parser::Token wheel_nodes[2] = {};
+    bool          has_diff_types = false;
+    Parser::Token diff_types = {};        //!< Characters of `DifferentialType`, may be empty.
+};
+
+inline const char* SkipWhitespace(const char* pos, const char* end)
+{
+    while (pos != end && IsWhitespace(*pos)) { ++pos; }
+    return pos;
+}
+
+/// Reads a node ID `[[:alnum:]_-]+`; returns false if there's none.
+inline bool ReadAxleNodeId(const char*& pos, const char* end, Parser::Token& out_token)
+{
+    out_token.start = pos;
+    while (pos != end && (IsKeywordChar(*pos) || *pos == '-')) { ++pos; }
+    out_token.length = static_cast<int>(pos - out_token.start);
+    return out_token.length > 0;
+}
+
+/// Returns false if the text is malformed.
+static bool ParseAxleProperty(const char* pos, const char* end, AxleProperty& out)
+{
+    pos = SkipWhitespace(pos, end);
+    if (pos != end && *pos == 'w')
+    {
+        if (end - pos < 3 || (pos[1] != '1' && pos[1] != '2') || pos[2] != '(') { return false; }
+        out.wheel_number = pos[1] - '0';
+        pos += 3;
+        if (!ReadAxleNodeId(pos, end, out.wheel_nodes[0]))        { return false; }
+        if (pos == end || !IsWhitespace(*pos))                     { return false; }
+        pos = SkipWhitespace(pos, end);
+        if (!ReadAxleNodeId(pos, end, out.wheel_nodes[1]))        { return false; }
+        if (pos == end || *pos != ')')                             { return false; }
+        pos = SkipWhitespace(pos + 1, end);
+    }
+    if (pos != end && *pos == 'd')
+    {
+        if (end - pos < 2 || pos[1] != '(') { return false; }
+        pos += 2;
+        out.has_diff_types = true;
+        out.diff_types.start = pos;
+        while (pos != end && (*pos == 'o' || *pos == 'l' || *pos == 's' || *pos == 'v')) { ++pos; }
+        out.diff_types.length = static_cast<int>(pos - out.diff_types.start);
+        if (pos == end || *pos != ')') { return false; }
+        pos = SkipWhitespace(pos + 1, end);
+    }
+    // Trailing comment
+    if (pos != end && (*pos == ';' || (*pos == '/' && (end - pos) > 1 && pos[1] == '/')))
+    {
+        return true;
+    }
+    return pos == end;
+}
+
 Parser::Parser()
 {
     // Push defaults 
@@ -952,31 +1247,44 @@ void Parser::ParseDirectiveForvert()
         return;
     }
 
-    std::string input = input_pos;
-    std::regex pattern(R"((\d+)\s*-\s*(\d+)|(\d+))");
-    std::smatch matches;
-
-    std::string::const_iterator searchStart(input.cbegin());
-    while (std::regex_search(searchStart, input.cend(), matches, pattern))
+    // Scan for numbers, anything else between them is ignored.
+    const char* pos = input_pos;
+    while (*pos != '\0')
     {
-        if (matches[1].matched && matches[2].matched)
+        if (!IsDigit(*pos))
         {
-            // Range found - unroll it into the `Forvert` array.
-            int start = std::stoi(matches[1].str());
-            int end = std::stoi(matches[2].str());
-            for (int i = start; i <= end; ++i)
-            {
-                forvert.vert_index = i; // Update the temp object
-                m_current_module->flexbodies.back().forvert.push_back(forvert); // Copy the temp object
-            }
+            ++pos;
+            continue;
         }
-        else if (matches[3].matched)
+
+        char* num_end = nullptr;
+        const int start = static_cast<int>(std::strtol(pos, &num_end, 10));
+        pos = num_end;
+
+        // Range "A - B"?
+        const char* range_pos = pos;
+        while (std::isspace(static_cast<unsigned char>(*range_pos))) { ++range_pos; }
+        if (*range_pos == '-')
         {
-            // Single number found
-            forvert.vert_index = std::stoi(matches[3].str()); // Update the temp object
-            m_current_module->flexbodies.back().forvert.push_back(forvert); // Copy the temp object
+            ++range_pos;
+            while (std::isspace(static_cast<unsigned char>(*range_pos))) { ++range_pos; }
+            if (IsDigit(*range_pos))
+            {
+                // Range found - unroll it into the `Forvert` array.
+                const int end = static_cast<int>(std::strtol(range_pos, &num_end, 10));
+                pos = num_end;
+                for (int i = start; i <= end; ++i)
+                {
+                    forvert.vert_index = i; // Update the temp object
+                    m_current_module->flexbodies.back().forvert.push_back(forvert); // Copy the temp object
+                }
+                continue;
+            }
         }
-        searchStart = matches.suffix().first;
+
+        // Single number found
+        forvert.vert_index = start; // Update the temp object
+        m_current_module->flexbodies.back().forvert.push_back(forvert); // Copy the temp object
     }
 }
 
@@ -1698,28 +2006,35 @@ void Parser::ParseAxles()
 {
     Axle axle;
 
-    Ogre::StringVector tokens = Ogre::StringUtil::split(m_current_line, ",");
-    Ogre::StringVector::iterator iter = tokens.begin();
-    for ( ; iter != tokens.end(); iter++)
+    // Comma-separated properties; walk the line buffer in place.
+    const char* pos = m_current_line;
+    while (*pos != '\0')
     {
-        std::smatch results;
-        if (! std::regex_search(*iter, results, Regexes::SECTION_AXLES_PROPERTY))
+        const char* end = std::strchr(pos, ',');
+        if (end == nullptr)
+        {
+            end = pos + std::strlen(pos);
+        }
+
+        AxleProperty property;
+        if (! ParseAxleProperty(pos, end, property))
         {
             this->LogMessage(Console::CONSOLE_SYSTEM_ERROR, "Invalid property, ignoring whole line...");
             return;
         }
-        // NOTE: Positions in 'results' array match E_CAPTURE*() positions (starting with 1) in the respective regex. 
 
-        if (results[1].matched)
+        if (property.wheel_number != 0)
         {
-            unsigned int wheel_index = PARSEINT(results[2]) - 1;
-            axle.wheels[wheel_index][0] = _ParseNodeRef(results[3]);
-            axle.wheels[wheel_index][1] = _ParseNodeRef(results[4]);
+            const int wheel_index = property.wheel_number - 1;
+            axle.wheels[wheel_index][0] = _ParseNodeRef(std::string(property.wheel_nodes[0].start, property.wheel_nodes[0].length));
+            axle.wheels[wheel_index][1] = _ParseNodeRef(std::string(property.wheel_nodes[1].start, property.wheel_nodes[1].length));
         }
-        else if (results[5].matched)
+        else if (property.has_diff_types)
         {
-            this->_ParseDifferentialTypes(axle.options, results[6].str());
+            this->_ParseDifferentialTypes(axle.options, std::string(property.diff_types.start, property.diff_types.length));
         }
+
+        pos = (*end == ',') ? (end + 1) : end;
     }
 
     m_current_module->axles.push_back(axle);
@@ -1736,17 +2051,16 @@ void Parser::ParseInterAxles()
     interaxle.a1 = this->ParseArgInt(args[0].c_str()) - 1;
     interaxle.a2 = this->ParseArgInt(args[1].c_str()) - 1;
 
-    std::smatch results;
-    if (! std::regex_search(args[2], results, Regexes::SECTION_AXLES_PROPERTY))
+    AxleProperty property;
+    if (args.size() > 2 && ! ParseAxleProperty(args[2].c_str(), args[2].c_str() + args[2].size(), property))
     {
         this->LogMessage(Console::CONSOLE_SYSTEM_ERROR, "Invalid property, ignoring whole line...");
         return;
     }
-    // NOTE: Positions in 'results' array match E_CAPTURE*() positions (starting with 1) in the respective regex. 
 
-    if (results[5].matched)
+    if (property.has_diff_types)
     {
-        this->_ParseDifferentialTypes(interaxle.options, results[6].str());
+        this->_ParseDifferentialTypes(interaxle.options, std::string(property.diff_types.start, property.diff_types.length));
     }
 
     m_current_module->interaxles.push_back(interaxle);
@@ -2769,19 +3083,24 @@ void Parser::ParseAnimator()
     {
         Ogre::String token = *itor;
         Ogre::StringUtil::trim(token);
-        std::smatch results;
         bool is_shortlimit = false;
 
-        // Numbered keywords 
-        if (std::regex_search(token, results, Regexes::PARSE_ANIMATORS_NUMBERED_KEYWORD))
+        // Numbered keywords, i.e. 'throttle1' - name followed by single digit
+        unsigned int aero_flag = 0u;
+        const size_t name_len = token.size() - 1;
+        if (token.size() > 1 && IsDigit(token[name_len]))
         {
-                 if (results[1] == "throttle")   animator.aero_animator.flags |= AeroAnimator::OPTION_THROTTLE;
-            else if (results[1] == "rpm")        animator.aero_animator.flags |= AeroAnimator::OPTION_RPM;
-            else if (results[1] == "aerotorq")   animator.aero_animator.flags |= AeroAnimator::OPTION_TORQUE;
-            else if (results[1] == "aeropit")    animator.aero_animator.flags |= AeroAnimator::OPTION_PITCH;
-            else if (results[1] == "aerostatus") animator.aero_animator.flags |= AeroAnimator::OPTION_STATUS;
+                 if (token.compare(0, name_len, "throttle") == 0)   aero_flag = AeroAnimator::OPTION_THROTTLE;
+            else if (token.compare(0, name_len, "rpm") == 0)        aero_flag = AeroAnimator::OPTION_RPM;
+            else if (token.compare(0, name_len, "aerotorq") == 0)   aero_flag = AeroAnimator::OPTION_TORQUE;
+            else if (token.compare(0, name_len, "aeropit") == 0)    aero_flag = AeroAnimator::OPTION_PITCH;
+            else if (token.compare(0, name_len, "aerostatus") == 0) aero_flag = AeroAnimator::OPTION_STATUS;
+        }
 
-            animator.aero_animator.engine_idx = this->ParseArgUint(results[2].str().c_str()) - 1;
+        if (aero_flag != 0u)
+        {
+            animator.aero_animator.flags |= aero_flag;
+            animator.aero_animator.engine_idx = this->ParseArgUint(token.c_str() + name_len) - 1;
         }
         else if ((is_shortlimit = (token.compare(0, 10, "shortlimit") == 0)) || (token.compare(0, 9, "longlimit") == 0))
         {
@@ -2867,23 +3186,48 @@ void Parser::LogMessage(Console::MessageType type, std::string const& msg)
 
 Keyword Parser::IdentifyKeyword(const std::string& line)
 {
-    // Search and ignore lettercase
-    std::smatch results;
-    std::regex_search(line, results, Regexes::IDENTIFY_KEYWORD_IGNORE_CASE); // Always returns true.
+    const char* start = line.c_str();
+
+    // `forset` is the only keyword which may be glued to its arguments; no other keyword starts with it.
+    static const size_t FORSET_LEN = 6;
+    if (line.size() >= FORSET_LEN && KeywordTable::Get().Find(start, FORSET_LEN) == Keyword::FORSET)
+    {
+        return Keyword::FORSET;
+    }
+
+    // Other keywords must be followed by whitespace, separator or end of line - none is a keyword char.
+    const char* pos = start;
+    while (IsKeywordChar(*pos))
+    {
+        ++pos;
+    }
+    if (pos == start)
+    {
+        return Keyword::INVALID;
+    }
+
+    const Keyword keyword = KeywordTable::Get().Find(start, pos - start);
+    if (keyword == Keyword::INVALID)
+    {
+        return Keyword::INVALID;
+    }
 
-    // The 'results' array contains a complete match at positon [0] and sub-matches starting with [1], 
-    //    so we get exact positions in Regexes::IDENTIFY_KEYWORD, which again match Keyword enum members
-    for (unsigned int i = 1; i < results.size(); i++)
+    // Check the keyword is delimited correctly
+    switch (KEYWORD_DEFS[static_cast<int>(keyword) - 1].form)
     {
-        std::ssub_match sub  = results[i];
-        if (sub.matched)
+    case KeywordForm::BLOCK:
+        while (IsWhitespace(*pos))
         {
-            // Build enum value directly from result offset
-            return Keyword(i);
+            ++pos;
         }
-    }
+        return (*pos == '\0') ? keyword : Keyword::INVALID;
+
+    case KeywordForm::INLINE:
+        return IsSeparator(*pos) ? keyword : Keyword::INVALID;
 
-    return Keyword::INVALID;
+    default:
+        return keyword;
+    }
 }
 
 void Parser::Prepare()
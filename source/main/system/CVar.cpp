@@ -34,6 +34,7 @@ void Console::cVarSetupBuiltins()
     App::app_skip_main_menu      = this->cVarCreate("app_skip_main_menu",      "SkipMainMenu",               CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::app_async_physics       = this->cVarCreate("app_async_physics",       "AsyncPhysics",               CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
     App::app_num_workers         = this->cVarCreate("app_num_workers",         "NumWorkerThreads",           CVAR_ARCHIVE | CVAR_TYPE_INT);
+    App::app_worker_spin_count   = this->cVarCreate("app_worker_spin_count",   "",                           CVAR_ARCHIVE | CVAR_TYPE_INT,     "100");
     App::app_screenshot_format   = this->cVarCreate("app_screenshot_format",   "Screenshot Format",          CVAR_ARCHIVE,                     "png");
     App::app_rendersys_override  = this->cVarCreate("app_rendersys_override",  "Render system",              CVAR_ARCHIVE);
     App::app_extra_mod_path      = this->cVarCreate("app_extra_mod_path",      "Extra mod path",             CVAR_ARCHIVE);
@@ -60,6 +61,9 @@ void Console::cVarSetupBuiltins()
     App::sim_quickload_dialog    = this->cVarCreate("sim_quickload_dialog",    "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
     App::sim_live_repair_interval = this->cVarCreate("sim_live_repair_interval", "",                         CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "2.f");
     App::sim_tuning_enabled      = this->cVarCreate("sim_tuning_enabled",      "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
+    App::sim_buoyancy_parallel_threshold = this->cVarCreate("sim_buoyancy_parallel_threshold", "",           CVAR_ARCHIVE | CVAR_TYPE_INT,     "500");
+    App::sim_collision_mesh_cache = this->cVarCreate("sim_collision_mesh_cache", "",                         CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
+    App::sim_deterministic       = this->cVarCreate("sim_deterministic",       "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
 
     App::mp_state                = this->cVarCreate("mp_state",                "",                                          CVAR_TYPE_INT,     "0"/*(int)MpState::DISABLED*/);
     App::mp_join_on_startup      = this->cVarCreate("mp_join_on_startup",      "Auto connect",               CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
@@ -204,6 +208,9 @@ void Console::cVarSetupBuiltins()
     App::gfx_enable_rtshaders    = this->cVarCreate("gfx_enable_rtshaders",    "Use RTShader System",        CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::gfx_alt_actor_materials = this->cVarCreate("gfx_alt_actor_materials", "Use alternate vehicle materials", CVAR_ARCHIVE | CVAR_TYPE_BOOL, "false");
     App::gfx_auto_lod            = this->cVarCreate("gfx_auto_lod",            "Use OGREs Automatic Mesh LOD Generator", CVAR_ARCHIVE | CVAR_TYPE_BOOL, "true");
+    App::gfx_static_batching     = this->cVarCreate("gfx_static_batching",     "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
+    App::gfx_terrain_object_streaming       = this->cVarCreate("gfx_terrain_object_streaming",       "", CVAR_ARCHIVE | CVAR_TYPE_BOOL,  "false");
+    App::gfx_terrain_object_streaming_range = this->cVarCreate("gfx_terrain_object_streaming_range", "", CVAR_ARCHIVE | CVAR_TYPE_FLOAT, "1000");
 
     App::flexbody_defrag_enabled           = this->cVarCreate("flexbody_defrag_enabled",           "", CVAR_TYPE_BOOL);
     App::flexbody_defrag_const_penalty     = this->cVarCreate("flexbody_defrag_const_penalty",     "", CVAR_TYPE_INT, "7");
@@ -212,6 +219,8 @@ void Console::cVarSetupBuiltins()
     App::flexbody_defrag_reorder_indices   = this->cVarCreate("flexbody_defrag_reorder_indices",   "", CVAR_TYPE_BOOL, "true");
     App::flexbody_defrag_reorder_texcoords = this->cVarCreate("flexbody_defrag_reorder_texcoords", "", CVAR_TYPE_BOOL, "true");
     App::flexbody_defrag_invert_lookup     = this->cVarCreate("flexbody_defrag_invert_lookup",     "", CVAR_TYPE_BOOL, "true");
+    App::flexbody_lod_max_interval         = this->cVarCreate("flexbody_lod_max_interval",         "", CVAR_ARCHIVE | CVAR_TYPE_INT, "4");
+    App::flexbody_still_epsilon            = this->cVarCreate("flexbody_still_epsilon",            "", CVAR_ARCHIVE | CVAR_TYPE_FLOAT, "0.0005");
 
     App::ui_show_live_repair_controls      = this->cVarCreate("ui_show_live_repair_controls",      "", CVAR_ARCHIVE | CVAR_TYPE_BOOL, "true");
     App::ui_show_vehicle_buttons           = this->cVarCreate("ui_show_vehicle_buttons", "Show vehicle buttons menu", CVAR_ARCHIVE | CVAR_TYPE_BOOL, "true");
@@ -29,9 +29,11 @@
 #include "GfxScene.h"
 #include "GUIManager.h"
 #include "IGfxWater.h"
+#include "InputReplay.h"
 #include "Language.h"
 #include "Network.h"
 #include "OverlayWrapper.h"
+#include "PlatformUtils.h"
 #include "RoRnet.h"
 #include "RoRVersion.h"
 #include "ScriptEngine.h"
@@ -314,6 +316,78 @@ public:
 };
 
 
+class ReplayCmd: public ConsoleCmd
+{
+public:
+    ReplayCmd(): ConsoleCmd("replay", "<save/play> <name>", _L("replay save/play <name> - deterministic replay of the current vehicle (see 'sim_deterministic')")) {}
+
+    void Run(Ogre::StringVector const& args) override
+    {
+        if (!this->CheckAppState(AppState::SIMULATION))
+            return;
+
+        Str<400> reply;
+        reply << m_name << ": ";
+        Console::MessageType reply_type = Console::CONSOLE_SYSTEM_REPLY;
+
+        if (args.size() != 3 || (args[1] != "save" && args[1] != "play"))
+        {
+            reply_type = Console::CONSOLE_HELP;
+            reply << _L("usage: replay save/play <name>");
+        }
+        else if (args[1] == "save")
+        {
+            const std::string filename = PathCombine(App::sys_savegames_dir->getStr(), args[2] + ".rorreplay");
+            ActorPtr actor = App::GetGameContext()->GetPlayerActor();
+            if (!actor || !actor->getInputReplay() || actor->getInputReplay()->IsPlaying())
+            {
+                reply_type = Console::CONSOLE_SYSTEM_ERROR;
+                reply << _L("The current vehicle has no recording; set 'sim_deterministic' before spawning it");
+            }
+            else if (actor->getInputReplay()->SaveFile(filename) != InputReplay::RESULT_CODE_OK)
+            {
+                reply_type = Console::CONSOLE_SYSTEM_ERROR;
+                reply << _L("Could not save ") << filename;
+            }
+            else
+            {
+                reply << _L("Saved ") << actor->getInputReplay()->GetNumFrames() << _L(" frames to ") << filename;
+            }
+        }
+        else // play
+        {
+            const std::string filename = PathCombine(App::sys_savegames_dir->getStr(), args[2] + ".rorreplay");
+            InputReplayPtr replay = std::make_shared<InputReplay>();
+            if (replay->LoadFile(filename) != InputReplay::RESULT_CODE_OK)
+            {
+                reply_type = Console::CONSOLE_SYSTEM_ERROR;
+                reply << _L("Could not load ") << filename;
+            }
+            else
+            {
+                if (!App::sim_deterministic->getBool() || replay->GetTerrainName() != App::sim_terrain_name->getStr())
+                {
+                    App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_WARNING,
+                        _L("Replay: the result will differ from the recording (needs 'sim_deterministic' and the same terrain)"));
+                }
+
+                ActorSpawnRequest* rq = new ActorSpawnRequest;
+                rq->asr_filename     = replay->GetActorFilename();
+                rq->asr_config       = replay->GetActorConfig();
+                rq->asr_position     = replay->GetInitialPosition();
+                rq->asr_rotation     = Ogre::Quaternion::IDENTITY;
+                rq->asr_free_position = true;
+                rq->asr_origin       = ActorSpawnRequest::Origin::USER;
+                rq->asr_input_replay = replay;
+                App::GetGameContext()->PushMessage(Message(MSG_SIM_SPAWN_ACTOR_REQUESTED, (void*)rq));
+                reply << _L("Playing ") << replay->GetNumFrames() << _L(" frames from ") << filename;
+            }
+        }
+
+        App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, reply_type, reply.ToCStr());
+    }
+};
+
 class AsCmd: public ConsoleCmd
 {
 public:
@@ -694,6 +768,7 @@ void Console::regBuiltinCommands()
     cmd = new ClearCmd();                 m_commands.insert(std::make_pair(cmd->getName(), cmd));
     cmd = new LoadScriptCmd();            m_commands.insert(std::make_pair(cmd->getName(), cmd));
     cmd = new SpeedOfSoundCmd();          m_commands.insert(std::make_pair(cmd->getName(), cmd));
+    cmd = new ReplayCmd();                m_commands.insert(std::make_pair(cmd->getName(), cmd));
     // CVars
     cmd = new SetCmd();                   m_commands.insert(std::make_pair(cmd->getName(), cmd));
     cmd = new SetstringCmd();             m_commands.insert(std::make_pair(cmd->getName(), cmd));
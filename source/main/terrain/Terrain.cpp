@@ -24,6 +24,7 @@
 #include "Actor.h"
 #include "ActorManager.h"
 #include "CacheSystem.h"
+#include "CollisionMeshCache.h"
 #include "Collisions.h"
 #include "ContentManager.h"
 #include "Renderdash.h"
@@ -42,6 +43,8 @@
 #include "Terrn2FileFormat.h"
 #include "Utils.h"
 #include "GfxWater.h"
+#include "PlatformUtils.h"
+#include "RoRVersion.h"
 
 #include <Terrain/OgreTerrainPaging.h>
 #include <Terrain/OgreTerrainGroup.h>
@@ -192,6 +195,13 @@ bool RoR::Terrain::initialize()
 
     loading_window->SetProgress(60, _L("Initializing Collision Subsystem"));
     this->m_collisions = new Collisions(this->getMaxTerrainSize());
+    if (App::sim_collision_mesh_cache->getBool())
+    {
+        this->initCollisionMeshCache();
+    }
+
+    // Parse *.tobj files on the thread pool while scripting and water initialize.
+    this->m_object_manager->StartParsingTObjFiles(m_def->tobj_files);
 
     loading_window->SetProgress(75, _L("Initializing Script Subsystem"));
     this->initScripting();
@@ -441,10 +451,14 @@ void RoR::Terrain::initShadows()
 
 void RoR::Terrain::loadTerrainObjects()
 {
+    m_object_manager->FinishParsingTObjFiles(); // Also pre-loads the ODef files in parallel.
+
     for (std::string tobj_filename : m_def->tobj_files)
     {
         m_object_manager->LoadTObjFile(tobj_filename);
     }
+
+    m_object_manager->BuildStaticBatches();
 }
 
 void RoR::Terrain::initTerrainCollisions()
@@ -455,6 +469,24 @@ void RoR::Terrain::initTerrainCollisions()
     }
 }
 
+void RoR::Terrain::initCollisionMeshCache()
+{
+    // The cached tris are baked from meshes which may come from any bundle, including the game's own content,
+    // so the game version is part of the key along with the terrain bundle's timestamp.
+    // For folder bundles that timestamp only covers the .terrn2 file, so the .tobj files are stamped separately;
+    // ODef and mesh files are stamped per entry, see `Collisions::addCollisionMesh()`.
+    std::string terrain_key = fmt::format("{}|{}|{}|{}",
+        m_cache_entry->resource_bundle_path, m_cache_entry->fname, (int64_t)m_cache_entry->filetime, ROR_VERSION_STRING);
+    for (std::string const& tobj_filename : m_def->tobj_files)
+    {
+        terrain_key += "|" + CollisionMeshCache::MakeResourceStamp(tobj_filename, m_cache_entry->resource_group);
+    }
+    const std::string filename = PathCombine(App::sys_cache_dir->getStr(),
+        fmt::format("collmeshes_{}.dat", Sha1Hash(m_cache_entry->resource_bundle_path + m_cache_entry->fname).substr(0, 16)));
+
+    m_collisions->setupCollisionMeshCache(filename, terrain_key);
+}
+
 void RoR::Terrain::initScripting()
 {
 #ifdef USE_ANGELSCRIPT
@@ -519,6 +551,11 @@ Ogre::Vector3 RoR::Terrain::GetNormalAt(float x, float y, float z)
     return m_geometry_manager->getNormalAt(x, y, z);
 }
 
+float RoR::Terrain::GetHeightAndNormalAt(float x, float z, Ogre::Vector3& out_normal)
+{
+    return m_geometry_manager->getHeightAndNormalAt(x, z, out_normal);
+}
+
 SkyManager* RoR::Terrain::getSkyManager()
 {
     return m_sky_manager;
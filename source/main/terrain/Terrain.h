@@ -100,6 +100,7 @@ public:
     void                    setGravity(float value);
     float                   getGravity() const            { return m_cur_gravity; }
     Ogre::Vector3           GetNormalAt(float x, float y, float z);
+    float                   GetHeightAndNormalAt(float x, float z, Ogre::Vector3& out_normal);
     Ogre::Vector3           getMaxTerrainSize();
     Ogre::AxisAlignedBox    getTerrainCollisionAAB();
     /// @}
@@ -117,6 +118,7 @@ private:
     // internal methods
     void initCamera();
     void initTerrainCollisions();
+    void initCollisionMeshCache();
     void initFog();
     void initLight();
     void initObjects();
@@ -481,6 +481,10 @@ void TerrainEditorObjectRefreshActorVisual(TerrainEditorObjectPtr obj)
 
 void TerrainEditorObject::setPosition(Ogre::Vector3 const& pos)
 {
+    if (static_object_node)
+    {
+        App::GetGameContext()->GetTerrain()->getObjectManager()->PrepareObjectForEditing(this); // Must see the old position
+    }
     position = pos;
     if (static_object_node)
     {
@@ -497,6 +501,7 @@ void TerrainEditorObject::setRotation(Ogre::Vector3 const& rot)
     rotation = rot;
     if (static_object_node)
     {
+        App::GetGameContext()->GetTerrain()->getObjectManager()->PrepareObjectForEditing(this);
         static_object_node->setOrientation(Quaternion(Degree(rot.x), Vector3::UNIT_X) * Quaternion(Degree(rot.y), Vector3::UNIT_Y) * Quaternion(Degree(rot.z), Vector3::UNIT_Z));
         static_object_node->pitch(Degree(-90));
     }
@@ -51,6 +51,9 @@ public:
     std::vector<int> static_collision_tris;
     bool enable_collisions = true;
     int script_handler = -1;
+    int static_batch_id = -1; //!< Offset to `TerrainObjectManager::m_static_batches`; -1 if the entity renders on its own.
+    float rendering_distance = 0.f;
+    bool static_streamed = false; //!< Visuals are created/destroyed by distance, see `TerrainObjectManager::m_object_tiles`
     // ~ only for preloaded actors:
     TObjSpecialObject special_object_type = TObjSpecialObject::NONE;
     ActorInstanceID_t actor_instance_id = ACTORINSTANCEID_INVALID;
@@ -36,6 +36,7 @@
 
 #include <OgreLight.h>
 #include <Terrain/OgreTerrainGroup.h>
+#include <cmath>
 
 using namespace Ogre;
 using namespace RoR;
@@ -155,28 +156,21 @@ TerrainGeometryManager::~TerrainGeometryManager()
     }
 }
 
-/// @author Ported from OGRE engine, www.ogre3d.org, file OgreTerrain.cpp
-float TerrainGeometryManager::getHeightAtTerrainPosition(Real x, Real y)
+/// Same triangulation as OGRE's `Terrain::getHeightAtTerrainPosition()` (OgreTerrain.cpp), but the triangle's
+/// slopes are read straight from the 4 height samples instead of building a plane from cross products.
+float TerrainGeometryManager::getHeightAtGrid(float gx, float gy, Ogre::Vector3* out_normal)
 {
-    // get left / bottom points (rounded down)
-    Real factor = (Real)mSize - 1.0f;
-    Real invFactor = 1.0f / factor;
-
-    long startX = static_cast<long>(x * factor);
-    long startY = static_cast<long>(y * factor);
-    long endX = startX + 1;
-    long endY = startY + 1;
-
-    // now get points in terrain space (effectively rounding them to boundaries)
-    // note that we do not clamp! We need a valid plane
-    Real startXTS = startX * invFactor;
-    Real startYTS = startY * invFactor;
-    Real endXTS = endX * invFactor;
-    Real endYTS = endY * invFactor;
-
-    // get parametric from start coord to next point
-    Real xParam = (x * factor - startX);
-    Real yParam = (y * factor - startY);
+    const int cell_x = static_cast<int>(gx);
+    const int cell_y = static_cast<int>(gy);
+    const float fx = gx - cell_x;
+    const float fy = gy - cell_y;
+
+    const float* row0 = mHeightData + cell_y * mSize + cell_x;
+    const float* row1 = row0 + mSize;
+    const float h0 = row0[0];
+    const float h1 = row0[1];
+    const float h2 = row1[1];
+    const float h3 = row1[0];
 
     /* For even / odd tri strip rows, triangles are this shape:
     even     odd
@@ -184,72 +178,325 @@ float TerrainGeometryManager::getHeightAtTerrainPosition(Real x, Real y)
     | / |   | \ |
     0---1   0---1
     */
+    float base, slope_x, slope_y; // Height = base + slope_x * fx + slope_y * fy
+    if (cell_y % 2)
+    {
+        if ((1.0f - fy) > fx) { base = h0;           slope_x = h1 - h0; slope_y = h3 - h0; }
+        else                  { base = h1 + h3 - h2; slope_x = h2 - h3; slope_y = h2 - h1; }
+    }
+    else
+    {
+        if (fy > fx)          { base = h0;           slope_x = h2 - h3; slope_y = h3 - h0; }
+        else                  { base = h0;           slope_x = h1 - h0; slope_y = h2 - h1; }
+    }
+
+    if (out_normal)
+    {
+        // Grid Y runs along world -Z
+        *out_normal = Vector3(-slope_x * mInvScale, 1.0f, slope_y * mInvScale);
+        out_normal->normalise();
+    }
+    return base + slope_x * fx + slope_y * fy;
+}
 
-    // Build all 4 positions in terrain space, using point-sampled height
-    Vector3 v0(startXTS, startYTS, mHeightData[startY * mSize + startX]);
-    Vector3 v1(endXTS  , startYTS, mHeightData[startY * mSize + endX]);
-    Vector3 v2(endXTS  , endYTS  , mHeightData[endY   * mSize + endX]);
-    Vector3 v3(startXTS, endYTS  , mHeightData[endY   * mSize + startX]);
+float TerrainGeometryManager::getHeightAt(float x, float z)
+{
+    return this->sampleHeight(x, z, nullptr);
+}
 
-    // define this plane in terrain space
-    Vector3 normal;
-    Real d;
-    if (startY % 2)
+float TerrainGeometryManager::getHeightAndNormalAt(float x, float z, Ogre::Vector3& out_normal)
+{
+    out_normal = Vector3::UNIT_Y; // Outside the heightfield or flat
+    return this->sampleHeight(x, z, &out_normal);
+}
+
+float TerrainGeometryManager::sampleHeight(float x, float z, Ogre::Vector3* out_normal)
+{
+    if (m_spec->is_flat)
+        return 0.0f;
+
+    const float gx = (x - mBase - mPos.x) * mInvScale;
+    const float gy = (mPos.z - mBase - z) * mInvScale;
+
+    if (gx <= 0.0f || gy <= 0.0f || gx >= mSize - 1 || gy >= mSize - 1)
+        return terrainManager->GetDef()->water_bottom_height;
+    else if (mIsFlat)
+        return mMinHeight;
+
+    return this->getHeightAtGrid(gx, gy, out_normal);
+}
+
+void TerrainGeometryManager::buildHeightBoundsMips()
+{
+    m_height_bounds_mips.clear();
+    if (mHeightData == nullptr || mSize < 2)
+        return;
+
+    // Level 0: cells
+    const int num_cells = mSize - 1;
+    std::vector<HeightBounds> level(num_cells * num_cells);
+    for (int y = 0; y < num_cells; y++)
+    {
+        for (int x = 0; x < num_cells; x++)
+        {
+            const float h0 = mHeightData[y       * mSize + x];
+            const float h1 = mHeightData[y       * mSize + x + 1];
+            const float h2 = mHeightData[(y + 1) * mSize + x + 1];
+            const float h3 = mHeightData[(y + 1) * mSize + x];
+            level[y * num_cells + x].min_height = std::min(std::min(h0, h1), std::min(h2, h3));
+            level[y * num_cells + x].max_height = std::max(std::max(h0, h1), std::max(h2, h3));
+        }
+    }
+    m_height_bounds_mips.push_back(std::move(level));
+
+    // Next levels: merge 2x2 tiles
+    int dim = num_cells;
+    while (dim > 1)
+    {
+        const int next_dim = (dim + 1) / 2;
+        const std::vector<HeightBounds>& prev = m_height_bounds_mips.back();
+        std::vector<HeightBounds> next(next_dim * next_dim);
+        for (int y = 0; y < next_dim; y++)
+        {
+            for (int x = 0; x < next_dim; x++)
+            {
+                HeightBounds bounds = prev[(y * 2) * dim + (x * 2)];
+                for (int sy = y * 2; sy < std::min(y * 2 + 2, dim); sy++)
+                {
+                    for (int sx = x * 2; sx < std::min(x * 2 + 2, dim); sx++)
+                    {
+                        bounds.min_height = std::min(bounds.min_height, prev[sy * dim + sx].min_height);
+                        bounds.max_height = std::max(bounds.max_height, prev[sy * dim + sx].max_height);
+                    }
+                }
+                next[y * next_dim + x] = bounds;
+            }
+        }
+        m_height_bounds_mips.push_back(std::move(next));
+        dim = next_dim;
+    }
+}
+
+// First point of the ray segment [t_min, t_max] below the given height
+static bool IntersectRaySegmentWithHeight(Ogre::Ray const& ray, float height, float t_min, float t_max, float& out_t)
+{
+    if (ray.getOrigin().y + ray.getDirection().y * t_min < height)
+    {
+        out_t = t_min;
+        return true;
+    }
+    if (ray.getDirection().y >= 0.0f)
+        return false;
+    const float t = (height - ray.getOrigin().y) / ray.getDirection().y;
+    if (t > t_max)
+        return false;
+    out_t = t;
+    return true;
+}
+
+std::pair<bool, Ogre::Real> TerrainGeometryManager::intersectsRay(Ogre::Ray const& ray)
+{
+    // NaN defeats the tile clipping below, the descent would then test every cell
+    const Vector3& origin = ray.getOrigin();
+    const Vector3& dir = ray.getDirection();
+    if (!std::isfinite(origin.x) || !std::isfinite(origin.y) || !std::isfinite(origin.z)
+        || !std::isfinite(dir.x) || !std::isfinite(dir.y) || !std::isfinite(dir.z))
     {
-        // odd row
-        bool secondTri = ((1.0 - yParam) > xParam);
-        if (secondTri)
+        return std::make_pair(false, Ogre::Real(0));
+    }
+
+    float t = 0.0f;
+    if (m_spec->is_flat)
+    {
+        // Plain plane test; `getHeightAt()` is 0 everywhere
+        if (IntersectRaySegmentWithHeight(ray, 0.0f, 0.0f, 1.0f, t))
+            return std::make_pair(true, Ogre::Real(t));
+        return std::make_pair(false, Ogre::Real(0));
+    }
+
+    // Convert the ray to grid space: X/Z are in cells (height sample indices), Y stays height.
+    // The conversion is linear, so the ray parameter doesn't change.
+    const Vector3 grid_origin(
+        (ray.getOrigin().x - mBase - mPos.x) / mScale,
+        ray.getOrigin().y,
+        (mPos.z - mBase - ray.getOrigin().z) / mScale);
+    const Vector3 grid_dir(
+        ray.getDirection().x / mScale,
+        ray.getDirection().y,
+        -ray.getDirection().z / mScale);
+    const Ogre::Ray grid_ray(grid_origin, grid_dir);
+
+    // Clip the ray to the heightfield; outside of it, `getHeightAt()` reports the water bottom.
+    float t_in = 0.0f;
+    float t_out = 1.0f;
+    const float num_cells = static_cast<float>(mSize - 1);
+    const float origin_2d[2] = { grid_origin.x, grid_origin.z };
+    const float dir_2d[2] = { grid_dir.x, grid_dir.z };
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (dir_2d[axis] == 0.0f)
         {
-            normal = (v1 - v0).crossProduct(v3 - v0);
-            d = -normal.dotProduct(v0);
+            if (origin_2d[axis] < 0.0f || origin_2d[axis] > num_cells)
+                t_in = 2.0f; // Parallel to the border and outside: empty
         }
         else
         {
-            normal = (v2 - v1).crossProduct(v3 - v1);
-            d = -normal.dotProduct(v1);
+            float t0 = (0.0f - origin_2d[axis]) / dir_2d[axis];
+            float t1 = (num_cells - origin_2d[axis]) / dir_2d[axis];
+            if (t0 > t1)
+                std::swap(t0, t1);
+            t_in = std::max(t_in, t0);
+            t_out = std::min(t_out, t1);
         }
     }
+
+    const float water_bottom_height = terrainManager->GetDef()->water_bottom_height;
+    if (t_in > t_out)
+    {
+        // Misses the heightfield entirely
+        if (IntersectRaySegmentWithHeight(ray, water_bottom_height, 0.0f, 1.0f, t))
+            return std::make_pair(true, Ogre::Real(t));
+        return std::make_pair(false, Ogre::Real(0));
+    }
+
+    // Front to back: before the heightfield, on it, after it
+    if (t_in > 0.0f && IntersectRaySegmentWithHeight(ray, water_bottom_height, 0.0f, t_in, t))
+    {
+        return std::make_pair(true, Ogre::Real(t));
+    }
+    if (mIsFlat || m_height_bounds_mips.empty())
+    {
+        if (IntersectRaySegmentWithHeight(ray, mMinHeight, t_in, t_out, t))
+            return std::make_pair(true, Ogre::Real(t));
+    }
     else
     {
-        // even row
-        bool secondTri = (yParam > xParam);
-        if (secondTri)
+        const int top_level = static_cast<int>(m_height_bounds_mips.size()) - 1;
+        if (this->intersectsRayTile(grid_ray, top_level, 0, 0, t_in, t_out, t))
+            return std::make_pair(true, Ogre::Real(t));
+    }
+    if (t_out < 1.0f && IntersectRaySegmentWithHeight(ray, water_bottom_height, t_out, 1.0f, t))
+    {
+        return std::make_pair(true, Ogre::Real(t));
+    }
+    return std::make_pair(false, Ogre::Real(0));
+}
+
+bool TerrainGeometryManager::intersectsRayTile(Ogre::Ray const& grid_ray, int level, int tile_x, int tile_y, float t_min, float t_max, float& out_t)
+{
+    const int num_cells = mSize - 1;
+    const int tile_size = 1 << level;
+    const int dim = (num_cells + tile_size - 1) / tile_size;
+    if (tile_x >= dim || tile_y >= dim)
+        return false;
+
+    // Clip the ray segment to the tile's X/Z rectangle
+    const float lo[2] = { (float)(tile_x * tile_size), (float)(tile_y * tile_size) };
+    const float hi[2] = { (float)std::min((tile_x + 1) * tile_size, num_cells), (float)std::min((tile_y + 1) * tile_size, num_cells) };
+    const float origin[2] = { grid_ray.getOrigin().x, grid_ray.getOrigin().z };
+    const float dir[2] = { grid_ray.getDirection().x, grid_ray.getDirection().z };
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (dir[axis] == 0.0f)
         {
-            normal = (v2 - v0).crossProduct(v3 - v0);
-            d = -normal.dotProduct(v0);
+            if (origin[axis] < lo[axis] || origin[axis] > hi[axis])
+                return false;
         }
         else
         {
-            normal = (v1 - v0).crossProduct(v2 - v0);
-            d = -normal.dotProduct(v0);
+            float t0 = (lo[axis] - origin[axis]) / dir[axis];
+            float t1 = (hi[axis] - origin[axis]) / dir[axis];
+            if (t0 > t1)
+                std::swap(t0, t1);
+            t_min = std::max(t_min, t0);
+            t_max = std::min(t_max, t1);
         }
     }
+    if (t_min > t_max)
+        return false;
 
-    // Solve plane equation for z
-    return (-normal.x * x - normal.y * y - d) / normal.z;
+    // Compare the segment's height range with the tile's
+    const HeightBounds& bounds = m_height_bounds_mips[level][tile_y * dim + tile_x];
+    const float y_min = grid_ray.getOrigin().y + grid_ray.getDirection().y * ((grid_ray.getDirection().y < 0.0f) ? t_max : t_min);
+    const float y_max = grid_ray.getOrigin().y + grid_ray.getDirection().y * ((grid_ray.getDirection().y < 0.0f) ? t_min : t_max);
+    if (y_min > bounds.max_height)
+    {
+        return false; // passes above
+    }
+    if (y_max < bounds.min_height)
+    {
+        out_t = t_min; // all underground
+        return true;
+    }
+
+    if (level == 0)
+    {
+        return this->intersectsRayCell(grid_ray, tile_x, tile_y, t_min, t_max, out_t);
+    }
+
+    // Visit the sub-tiles front to back, so the first hit is the nearest one
+    const int first_x = (grid_ray.getDirection().x >= 0.0f) ? 0 : 1;
+    const int first_y = (grid_ray.getDirection().z >= 0.0f) ? 0 : 1;
+    for (int iy = 0; iy < 2; iy++)
+    {
+        for (int ix = 0; ix < 2; ix++)
+        {
+            const int sub_x = tile_x * 2 + (first_x ^ ix);
+            const int sub_y = tile_y * 2 + (first_y ^ iy);
+            if (this->intersectsRayTile(grid_ray, level - 1, sub_x, sub_y, t_min, t_max, out_t))
+                return true;
+        }
+    }
+    return false;
 }
 
-float TerrainGeometryManager::getHeightAt(float x, float z)
+bool TerrainGeometryManager::intersectsRayCell(Ogre::Ray const& grid_ray, int cell_x, int cell_y, float t_min, float t_max, float& out_t)
 {
-    if (m_spec->is_flat)
-        return 0.0f;
+    // Same triangulation as `getHeightAtGrid()`
+    const Vector3 v0((Real)cell_x,     mHeightData[cell_y       * mSize + cell_x],     (Real)cell_y);
+    const Vector3 v1((Real)cell_x + 1, mHeightData[cell_y       * mSize + cell_x + 1], (Real)cell_y);
+    const Vector3 v2((Real)cell_x + 1, mHeightData[(cell_y + 1) * mSize + cell_x + 1], (Real)cell_y + 1);
+    const Vector3 v3((Real)cell_x,     mHeightData[(cell_y + 1) * mSize + cell_x],     (Real)cell_y + 1);
 
-    float tx = (x - mBase - mPos.x) / ((mSize - 1) *  mScale);
-    float ty = (z + mBase - mPos.z) / ((mSize - 1) * -mScale);
+    std::pair<bool, Real> hit_a, hit_b;
+    if (cell_y % 2)
+    {
+        hit_a = Ogre::Math::intersects(grid_ray, v0, v1, v3);
+        hit_b = Ogre::Math::intersects(grid_ray, v1, v2, v3);
+    }
+    else
+    {
+        hit_a = Ogre::Math::intersects(grid_ray, v0, v1, v2);
+        hit_b = Ogre::Math::intersects(grid_ray, v0, v2, v3);
+    }
 
-    if (tx <= 0.0f || ty <= 0.0f || tx >= 1.0f || ty >= 1.0f)
-        return terrainManager->GetDef()->water_bottom_height;
-    else if (mIsFlat)
-        return mMinHeight;
+    // tolerate rounding at the cell borders
+    const float epsilon = 1e-5f;
+    t_min -= epsilon;
 
-    return getHeightAtTerrainPosition(tx, ty);
+    bool found = false;
+    float nearest = t_max + epsilon;
+    if (hit_a.first && hit_a.second >= t_min && hit_a.second <= nearest)
+    {
+        nearest = hit_a.second;
+        found = true;
+    }
+    if (hit_b.first && hit_b.second >= t_min && hit_b.second <= nearest)
+    {
+        nearest = hit_b.second;
+        found = true;
+    }
+    if (found)
+    {
+        out_t = std::max(nearest, 0.0f);
+    }
+    return found;
 }
 
 Ogre::Vector3 TerrainGeometryManager::getNormalAt(float x, float y, float z)
 {
-    const float precision = 0.1f;
-    Vector3 normal(getHeightAt(x - precision, z) - y, precision, y - getHeightAt(x, z + precision));
-    normal.normalise();
+    Vector3 normal;
+    this->getHeightAndNormalAt(x, z, normal);
     return normal;
 }
 
@@ -339,6 +586,7 @@ bool TerrainGeometryManager::InitTerrain(std::string otc_filename)
     const float world_size = terrain->getWorldSize();
     mBase = -world_size * 0.5f;
     mScale = world_size / (Real)(mSize - 1);
+    mInvScale = 1.0f / mScale;
     mPos = terrain->getPosition();
 
     // terrain->getMinHeight() / terrain->getMaxHeight() seem to be unreliable ~ ulteq 12/18
@@ -353,6 +601,8 @@ bool TerrainGeometryManager::InitTerrain(std::string otc_filename)
     }
     mIsFlat = std::abs(mMaxHeight - mMinHeight) < std::numeric_limits<float>::epsilon();
 
+    this->buildHeightBoundsMips();
+
     if (m_was_new_geometry_generated)
     {
         // update the blend maps
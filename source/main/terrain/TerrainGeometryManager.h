@@ -46,6 +46,14 @@ public:
     Ogre::TerrainGroup* getTerrainGroup() { return m_ogre_terrain_group; };
 
     float getHeightAt(float x, float z);
+    float getHeightAndNormalAt(float x, float z, Ogre::Vector3& out_normal); //!< For ground contact; one lookup instead of `getHeightAt()` + `getNormalAt()`.
+
+    /**
+     * Intersects the ray with the heightfield, skipping whole areas using min/max mip levels; only tested for the length of the direction vector of the ray.
+     * Parts of the ray outside of the heightfield are tested against the water bottom height, same as `getHeightAt()` reports there.
+     * @return Pair of whether an intersection was found and the distance to the point of the intersection, in the ray's direction vector's unit.
+     */
+    std::pair<bool, Ogre::Real> intersectsRay(Ogre::Ray const& ray);
 
     Ogre::Vector3 getNormalAt(float x, float y, float z);
 
@@ -58,7 +66,18 @@ public:
 
 private:
 
-    float getHeightAtTerrainPosition(float x, float z);
+    float sampleHeight(float x, float z, Ogre::Vector3* out_normal);
+    float getHeightAtGrid(float gx, float gy, Ogre::Vector3* out_normal); //!< Grid space = height sample indices, see `intersectsRay()`
+
+    struct HeightBounds
+    {
+        float min_height;
+        float max_height;
+    };
+
+    void buildHeightBoundsMips();
+    bool intersectsRayTile(Ogre::Ray const& grid_ray, int level, int tile_x, int tile_y, float t_min, float t_max, float& out_t);
+    bool intersectsRayCell(Ogre::Ray const& grid_ray, int cell_x, int cell_y, float t_min, float t_max, float& out_t);
 
     bool getTerrainImage(int x, int y, Ogre::Image& img);
     bool loadTerrainConfig(Ogre::String filename);
@@ -78,9 +97,13 @@ private:
     Ogre::Vector3 mPos = Ogre::Vector3::ZERO;
     Ogre::Real mBase = 0.f;
     Ogre::Real mScale = 0.f;
+    Ogre::Real mInvScale = 0.f;
     Ogre::uint16 mSize = 0;
     float* mHeightData = nullptr;
 
+    /// Min/max heights of square tiles of the heightfield: level 0 = single cells (between 4 height samples), each next level = 2x2 tiles of the previous one; the last level is a single tile.
+    std::vector<std::vector<HeightBounds>> m_height_bounds_mips;
+
     bool  mIsFlat;
     float mMinHeight;
     float mMaxHeight;
@@ -25,11 +25,13 @@
 #include "Application.h"
 #include "AutoPilot.h"
 #include "CacheSystem.h"
+#include "CameraManager.h"
 #include "Collisions.h"
 #include "Console.h"
 #include "ErrorUtils.h"
 #include "Language.h"
 #include "GameContext.h"
+#include "GfxActor.h"
 #include "GfxScene.h"
 #include "GUIManager.h"
 #include "GUI_LoadingWindow.h"
@@ -43,11 +45,14 @@
 #include "Terrain.h"
 #include "Terrn2FileFormat.h"
 #include "TObjFileFormat.h"
+#include "ThreadPool.h"
 #include "Utils.h"
 #include "WriteTextToTexture.h"
 
 #include <RTShaderSystem/OgreRTShaderSystem.h>
 #include <Overlay/OgreFontManager.h>
+#include <cfloat>
+#include <unordered_set>
 
 #ifdef USE_ANGELSCRIPT
 #    include "ExtinguishableFireAffector.h"
@@ -59,6 +64,10 @@ using namespace RoR;
 using namespace Forests;
 #endif //USE_PAGED
 
+const float OBJECT_CELL_SIZE = 250.f; //!< Meters; for both static batches and streaming tiles. Smaller cells cull better, bigger cells mean fewer draw calls.
+const float OBJECT_STREAMING_UNLOAD_FACTOR = 1.25f; //!< Tiles are unloaded farther than they're loaded, so they don't flicker at the edge.
+const unsigned long OBJECT_STREAMING_BUDGET_US = 2000; //!< Per frame; at least one tile is always loaded.
+
 //workaround for pagedgeometry
 inline float getTerrainHeight(Real x, Real z, void* unused = 0)
 {
@@ -75,6 +84,11 @@ TerrainObjectManager::TerrainObjectManager(Terrain* terrainManager) :
 
 TerrainObjectManager::~TerrainObjectManager()
 {
+    for (StaticBatch& batch : m_static_batches)
+    {
+        if (batch.geometry)
+            App::GetGfxScene()->GetSceneManager()->destroyStaticGeometry(batch.geometry);
+    }
     for (MeshObject* mo : m_mesh_objects)
     {
         if (mo)
@@ -147,6 +161,117 @@ void GenerateGridAndPutToScene(Ogre::Vector3 position)
     n->setVisible(true);
 }
 
+void TerrainObjectManager::StartParsingTObjFiles(std::vector<std::string> const& tobj_names)
+{
+    ROR_ASSERT(this->terrainManager->getCacheEntry()->resource_group != "");
+
+    for (std::string const& tobj_name : tobj_names)
+    {
+        auto job = std::make_shared<TObjParseJob>();
+        job->tobj_name = tobj_name;
+        try
+        {
+            DataStreamPtr file = ResourceGroupManager::getSingleton().openResource(
+                tobj_name, this->terrainManager->getCacheEntry()->resource_group);
+            job->stream = DataStreamPtr(OGRE_NEW MemoryDataStream(tobj_name, file));
+        }
+        catch (...)
+        {
+            continue; // `LoadTObjFile()` will report the error
+        }
+
+        job->task = App::GetThreadPool()->RunTask([job]()
+        {
+            try
+            {
+                TObjParser parser;
+                parser.Prepare();
+                parser.ProcessOgreStream(job->stream.get());
+                job->document = parser.Finalize();
+            }
+            catch (...)
+            {
+                job->document = nullptr;
+            }
+            job->stream.reset();
+        });
+        m_tobj_parse_jobs.push_back(job);
+    }
+}
+
+void TerrainObjectManager::FinishParsingTObjFiles()
+{
+    for (std::shared_ptr<TObjParseJob>& job : m_tobj_parse_jobs)
+    {
+        job->task->join();
+    }
+
+    // Collect ODefs referenced by the TObj files
+    std::vector<std::string> odef_names;
+    std::unordered_set<std::string> odef_names_seen;
+    for (std::shared_ptr<TObjParseJob>& job : m_tobj_parse_jobs)
+    {
+        if (!job->document)
+            continue;
+
+        for (TObjEntry const& entry : job->document->objects)
+        {
+            const std::string odef_name = entry.odef_name;
+            if (m_odef_cache.find(odef_name) == m_odef_cache.end() && odef_names_seen.insert(odef_name).second)
+            {
+                odef_names.push_back(odef_name);
+            }
+        }
+    }
+
+    // Read on main thread, parse in parallel
+    std::vector<Ogre::DataStreamPtr> odef_streams(odef_names.size());
+    for (size_t i = 0; i < odef_names.size(); i++)
+    {
+        Ogre::DataStreamPtr file = this->OpenODefFile(odef_names[i]);
+        if (file)
+        {
+            odef_streams[i] = DataStreamPtr(OGRE_NEW MemoryDataStream(file->getName(), file));
+        }
+    }
+
+    std::vector<std::shared_ptr<ODefDocument>> odefs(odef_names.size());
+    App::GetThreadPool()->ParallelFor(odef_names.size(), /*chunk_size:*/16, /*max_participants:*/App::GetThreadPool()->GetNumWorkers() + 1,
+        [&odef_streams, &odefs](size_t begin, size_t end, size_t participant)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                if (odef_streams[i])
+                {
+                    odefs[i] = TerrainObjectManager::ParseODefFile(odef_streams[i]);
+                }
+            }
+        });
+
+    for (size_t i = 0; i < odef_names.size(); i++)
+    {
+        if (odefs[i]) // Failures are reported (and retried) by `FetchODef()`
+        {
+            m_odef_cache.insert(std::make_pair(odef_names[i], odefs[i]));
+        }
+    }
+}
+
+TObjDocumentPtr TerrainObjectManager::TakeParsedTObj(std::string const & tobj_name)
+{
+    for (auto itor = m_tobj_parse_jobs.begin(); itor != m_tobj_parse_jobs.end(); ++itor)
+    {
+        if ((*itor)->tobj_name == tobj_name)
+        {
+            (*itor)->task->join();
+            TObjDocumentPtr tobj = (*itor)->document;
+            m_tobj_parse_jobs.erase(itor);
+            return tobj;
+        }
+    }
+    return nullptr;
+}
+
 void TerrainObjectManager::LoadTObjFile(Ogre::String tobj_name)
 {
     ROR_ASSERT(this->terrainManager);
@@ -156,12 +281,16 @@ void TerrainObjectManager::LoadTObjFile(Ogre::String tobj_name)
     TObjDocumentPtr tobj;
     try
     {
-        DataStreamPtr stream_ptr = ResourceGroupManager::getSingleton().openResource(
-            tobj_name, this->terrainManager->getCacheEntry()->resource_group);
-        TObjParser parser;
-        parser.Prepare();
-        parser.ProcessOgreStream(stream_ptr.get());
-        tobj = parser.Finalize();
+        tobj = this->TakeParsedTObj(tobj_name);
+        if (!tobj)
+        {
+            DataStreamPtr stream_ptr = ResourceGroupManager::getSingleton().openResource(
+                tobj_name, this->terrainManager->getCacheEntry()->resource_group);
+            TObjParser parser;
+            parser.Prepare();
+            parser.ProcessOgreStream(stream_ptr.get());
+            tobj = parser.Finalize();
+        }
         m_tobj_cache.push_back(tobj);
     }
     catch (...)
@@ -528,6 +657,7 @@ void TerrainObjectManager::destroyObject(const String& instancename)
     {
         // Static object: Destroy the scene node and everything attached to it.
         ROR_ASSERT(object->static_object_node);
+        this->PrepareObjectForEditing(object.GetRef());
         for (Ogre::MovableObject* mova : object->static_object_node->getAttachedObjects())
         {
             App::GetGfxScene()->GetSceneManager()->destroyMovableObject(mova);
@@ -564,6 +694,26 @@ ODefDocument* TerrainObjectManager::FetchODef(std::string const & odef_name)
         return search_res->second.get();
     }
 
+    Ogre::DataStreamPtr ds = this->OpenODefFile(odef_name);
+    if (!ds)
+    {
+        return nullptr; // Error already logged
+    }
+
+    std::shared_ptr<ODefDocument> odef = TerrainObjectManager::ParseODefFile(ds);
+    if (!odef)
+    {
+        LOG(fmt::format("[ODEF] An exception occurred when loading or parsing {}.odef", odef_name));
+        return nullptr;
+    }
+
+    // Add to cache and return
+    m_odef_cache.insert(std::make_pair(odef_name, odef));
+    return odef.get();
+}
+
+Ogre::DataStreamPtr TerrainObjectManager::OpenODefFile(std::string const & odef_name)
+{
     // Search for the file
     const std::string filename = odef_name + ".odef";
     std::string group_name;
@@ -579,20 +729,26 @@ ODefDocument* TerrainObjectManager::FetchODef(std::string const & odef_name)
 
     try
     {
-        // Load and parse the file
-        Ogre::DataStreamPtr ds = ResourceGroupManager::getSingleton().openResource(filename, group_name);
+        return ResourceGroupManager::getSingleton().openResource(filename, group_name);
+    }
+    catch (...)
+    {
+        LOG(fmt::format("[ODEF] An exception occurred when opening {}", filename));
+        return nullptr;
+    }
+}
+
+std::shared_ptr<ODefDocument> TerrainObjectManager::ParseODefFile(Ogre::DataStreamPtr ds)
+{
+    try
+    {
         ODefParser parser;
         parser.Prepare();
         parser.ProcessOgreStream(ds.get());
-        std::shared_ptr<ODefDocument> odef = parser.Finalize();
-
-        // Add to cache and return
-        m_odef_cache.insert(std::make_pair(odef_name, odef));
-        return odef.get();
+        return parser.Finalize();
     }
     catch (...)
     {
-        LOG(fmt::format("[ODEF] An exception occurred when loading or parsing {}", filename));
         return nullptr;
     }
 }
@@ -628,29 +784,6 @@ bool TerrainObjectManager::LoadTerrainObject(const Ogre::String& name, const Ogr
 
     SceneNode* tenode = this->getGroupingSceneNode()->createChildSceneNode();
 
-    MeshObject* mo = nullptr;
-    if (odef->header.mesh_name != "none")
-    {
-        Str<100> ebuf; ebuf << m_entity_counter++ << "-" << odef->header.mesh_name;
-        mo = new MeshObject(odef->header.mesh_name, terrainManager->getTerrainFileResourceGroup(), ebuf.ToCStr(), tenode);
-        if (mo->getEntity())
-        {
-            mo->getEntity()->setCastShadows(odef->header.cast_shadows);
-            mo->getEntity()->setRenderingDistance(rendering_distance);
-            m_mesh_objects.push_back(mo);
-        }
-        else
-        {
-            delete mo;
-            // Only log to console if requested from Console UI or script (debug message to RoR.log is written anyway).
-            if (App::app_state->getEnum<AppState>() == AppState::SIMULATION)
-            {
-                App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_TERRN, Console::CONSOLE_SYSTEM_WARNING,
-                    fmt::format(_L("Could not load mesh '{}' (used by object '{}')"), odef->header.mesh_name, odefname));
-            }
-        }
-    }
-
     tenode->setScale(odef->header.scale);
     tenode->setPosition(pos);
     Quaternion rotation = Quaternion(Degree(rot.x), Vector3::UNIT_X) * Quaternion(Degree(rot.y), Vector3::UNIT_Y) * Quaternion(Degree(rot.z), Vector3::UNIT_Z);
@@ -669,21 +802,10 @@ bool TerrainObjectManager::LoadTerrainObject(const Ogre::String& name, const Ogr
     object->static_object_node = tenode;
     object->enable_collisions = enable_collisions;
     object->script_handler = scripthandler;
+    object->rendering_distance = rendering_distance;
     object->tobj_cache_id = m_tobj_cache_active_id;
     m_editor_objects.push_back(object);
 
-    if (mo && uniquifyMaterial && !instancename.empty())
-    {
-        for (unsigned int i = 0; i < mo->getEntity()->getNumSubEntities(); i++)
-        {
-            SubEntity* se = mo->getEntity()->getSubEntity(i);
-            String matname = se->getMaterialName();
-            String newmatname = matname + "/" + instancename;
-            se->getMaterial()->clone(newmatname);
-            se->setMaterialName(newmatname);
-        }
-    }
-
     for (LocalizerType type : odef->localizers)
     {
         Localizer loc;
@@ -754,7 +876,73 @@ bool TerrainObjectManager::LoadTerrainObject(const Ogre::String& name, const Ogr
         terrainManager->GetCollisions()->addCollisionMesh(
             odefname,
             cmesh.mesh_name, pos, tenode->getOrientation(),
-            cmesh.scale, gm, &(object->static_collision_tris));
+            cmesh.scale, gm, &(object->static_collision_tris), /*cache_source_file:*/odefname);
+    }
+
+    if (odef->mat_name_generate != "")
+    {
+        Ogre::MaterialPtr mat = Ogre::MaterialManager::getSingleton().create(odef->mat_name_generate,"generatedMaterialShaders");
+        Ogre::RTShader::ShaderGenerator::getSingleton().createShaderBasedTechnique(*mat, Ogre::MaterialManager::DEFAULT_SCHEME_NAME, Ogre::RTShader::ShaderGenerator::DEFAULT_SCHEME_NAME);
+        Ogre::RTShader::ShaderGenerator::getSingleton().invalidateMaterial(RTShader::ShaderGenerator::DEFAULT_SCHEME_NAME, String(odef->mat_name_generate));
+    }
+
+    // Visuals: objects from TOBJ files may be streamed in by distance, see `UpdateObjectStreaming()`.
+    if (m_tobj_cache_active_id != -1 && !uniquifyMaterial && App::gfx_terrain_object_streaming->getBool()
+        && odef->animations.empty() && odef->texture_prints.empty()) // Both keep per-instance state
+    {
+        object->static_streamed = true;
+        m_object_tiles[this->GetObjectTileKey(pos)].objects.push_back(object);
+    }
+    else
+    {
+        this->CreateObjectVisuals(object, odef, uniquifyMaterial);
+    }
+
+    return true;
+}
+
+void TerrainObjectManager::CreateObjectVisuals(TerrainEditorObjectPtr const& object, ODefDocument* odef, bool uniquifyMaterial)
+{
+    const std::string& name = object->name;
+    const std::string& instancename = object->instance_name;
+    const std::string odefname = name + ".odef"; // for logging
+    const float rendering_distance = object->rendering_distance;
+    SceneNode* tenode = object->static_object_node;
+
+    MeshObject* mo = nullptr;
+    if (odef->header.mesh_name != "none")
+    {
+        Str<100> ebuf; ebuf << m_entity_counter++ << "-" << odef->header.mesh_name;
+        mo = new MeshObject(odef->header.mesh_name, terrainManager->getTerrainFileResourceGroup(), ebuf.ToCStr(), tenode);
+        if (mo->getEntity())
+        {
+            mo->getEntity()->setCastShadows(odef->header.cast_shadows);
+            mo->getEntity()->setRenderingDistance(rendering_distance);
+            m_mesh_objects.push_back(mo);
+        }
+        else
+        {
+            delete mo;
+            mo = nullptr;
+            // Only log to console if requested from Console UI or script (debug message to RoR.log is written anyway).
+            if (App::app_state->getEnum<AppState>() == AppState::SIMULATION)
+            {
+                App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_TERRN, Console::CONSOLE_SYSTEM_WARNING,
+                    fmt::format(_L("Could not load mesh '{}' (used by object '{}')"), odef->header.mesh_name, odefname));
+            }
+        }
+    }
+
+    if (mo && uniquifyMaterial && !instancename.empty())
+    {
+        for (unsigned int i = 0; i < mo->getEntity()->getNumSubEntities(); i++)
+        {
+            SubEntity* se = mo->getEntity()->getSubEntity(i);
+            String matname = se->getMaterialName();
+            String newmatname = matname + "/" + instancename;
+            se->getMaterial()->clone(newmatname);
+            se->setMaterialName(newmatname);
+        }
     }
 
     for (ODefParticleSys& psys : odef->particle_systems)
@@ -796,22 +984,15 @@ bool TerrainObjectManager::LoadTerrainObject(const Ogre::String& name, const Ogr
 
     if (!odef->mat_name.empty())
     {
-        if (mo->getEntity())
+        if (mo && mo->getEntity())
         {
             mo->getEntity()->setMaterialName(odef->mat_name);
         }
     }
 
-    if (odef->mat_name_generate != "")
-    {
-        Ogre::MaterialPtr mat = Ogre::MaterialManager::getSingleton().create(odef->mat_name_generate,"generatedMaterialShaders");
-        Ogre::RTShader::ShaderGenerator::getSingleton().createShaderBasedTechnique(*mat, Ogre::MaterialManager::DEFAULT_SCHEME_NAME, Ogre::RTShader::ShaderGenerator::DEFAULT_SCHEME_NAME);
-        Ogre::RTShader::ShaderGenerator::getSingleton().invalidateMaterial(RTShader::ShaderGenerator::DEFAULT_SCHEME_NAME, String(odef->mat_name_generate));
-    }
-
     for (ODefAnimation& anim : odef->animations)
     {
-        if (tenode && mo->getEntity())
+        if (mo && mo->getEntity())
         {
             AnimationStateSet *s = mo->getEntity()->getAllAnimationStates();
             String anim_name_str(anim.name);
@@ -846,7 +1027,7 @@ bool TerrainObjectManager::LoadTerrainObject(const Ogre::String& name, const Ogr
 
     for (ODefTexPrint& tex_print : odef->texture_prints)
     {
-        if (!mo->getEntity())
+        if (!mo || !mo->getEntity())
             continue;
         String matName = mo->getEntity()->getSubEntity(0)->getMaterialName();
         MaterialPtr m = MaterialManager::getSingleton().getByName(matName);
@@ -967,7 +1148,11 @@ bool TerrainObjectManager::LoadTerrainObject(const Ogre::String& name, const Ogr
         sn->attachObject(lflare);
     }
 
-    return true;
+    if (mo && mo->getEntity() && odef->animations.empty() && !mo->getEntity()->hasSkeleton()
+        && (!m_static_batches_built || object->static_streamed) && App::gfx_static_batching->getBool())
+    {
+        this->AddToStaticBatch(object, rendering_distance, odef->header.cast_shadows);
+    }
 }
 
 bool TerrainObjectManager::LoadTerrainScript(const Ogre::String& filename)
@@ -1103,10 +1288,286 @@ bool TerrainObjectManager::UpdateTerrainObjects(float dt)
 #endif //USE_PAGED
     this->UpdateAnimatedObjects(dt);
     this->UpdateParticleEffectObjects();
+    this->UpdateObjectStreaming();
+    this->UpdateStaticBatches();
 
     return true;
 }
 
+Ogre::Entity* TerrainObjectManager::FindStaticObjectEntity(TerrainEditorObjectPtr const& object)
+{
+    // The mesh entity is attached directly; lights and particles live in child nodes.
+    for (Ogre::MovableObject* mova : object->static_object_node->getAttachedObjects())
+    {
+        if (mova->getMovableType() == Ogre::EntityFactory::FACTORY_TYPE_NAME)
+            return static_cast<Ogre::Entity*>(mova);
+    }
+    return nullptr;
+}
+
+void TerrainObjectManager::AddToStaticBatch(TerrainEditorObjectPtr const& object, float rendering_distance, bool cast_shadows)
+{
+    const ObjectTileKey cell = GetObjectTileKey(object->position);
+    const StaticBatchKey key(cell.first, cell.second, static_cast<int>(rendering_distance), cast_shadows);
+
+    auto itor = m_static_batch_lookup.find(key);
+    if (itor == m_static_batch_lookup.end())
+    {
+        StaticBatch batch;
+        batch.rendering_distance = rendering_distance;
+        batch.cast_shadows = cast_shadows;
+        m_static_batches.push_back(batch);
+        itor = m_static_batch_lookup.insert(std::make_pair(key, static_cast<int>(m_static_batches.size() - 1))).first;
+    }
+
+    m_static_batches[itor->second].objects.push_back(object);
+    m_static_batches[itor->second].needs_rebuild = m_static_batches_built; // Streamed in
+    object->static_batch_id = itor->second;
+}
+
+void TerrainObjectManager::BuildStaticBatch(int batch_id)
+{
+    StaticBatch& batch = m_static_batches[batch_id];
+    if (batch.geometry)
+    {
+        batch.geometry->reset();
+    }
+    else
+    {
+        batch.geometry = App::GetGfxScene()->GetSceneManager()->createStaticGeometry(fmt::format("TerrainObjects-StaticBatch{}", batch_id));
+        batch.geometry->setRegionDimensions(Ogre::Vector3(OBJECT_CELL_SIZE));
+        batch.geometry->setRenderingDistance(batch.rendering_distance);
+        batch.geometry->setCastShadows(batch.cast_shadows);
+    }
+
+    for (TerrainEditorObjectPtr& object : batch.objects)
+    {
+        Ogre::Entity* entity = FindStaticObjectEntity(object);
+        SceneNode* node = object->static_object_node;
+        batch.geometry->addEntity(entity, node->_getDerivedPosition(), node->_getDerivedOrientation(), node->_getDerivedScale());
+        entity->setVisible(false);
+    }
+
+    batch.geometry->build();
+    batch.needs_rebuild = false;
+}
+
+void TerrainObjectManager::BuildStaticBatches()
+{
+    m_static_batches_built = true;
+    if (m_static_batches.empty())
+    {
+        return;
+    }
+
+    // A batch of one object saves nothing, leave it as is.
+    size_t num_batched = 0;
+    size_t num_batches = 0;
+    size_t num_regions = 0;
+    for (int i = 0; i < static_cast<int>(m_static_batches.size()); i++)
+    {
+        StaticBatch& batch = m_static_batches[i];
+        if (batch.objects.size() < 2)
+        {
+            for (TerrainEditorObjectPtr& object : batch.objects)
+            {
+                object->static_batch_id = -1;
+            }
+            batch.objects.clear();
+            continue;
+        }
+
+        this->BuildStaticBatch(i);
+        num_batched += batch.objects.size();
+        num_batches++;
+        Ogre::StaticGeometry::RegionIterator region_itor = batch.geometry->getRegionIterator();
+        while (region_itor.hasMoreElements())
+        {
+            region_itor.moveNext();
+            num_regions++;
+        }
+    }
+
+    LOG(fmt::format("[RoR|Terrain] Static batching: {} of {} objects baked into {} batches ({} regions, cell size {}m)",
+        num_batched, m_editor_objects.size(), num_batches, num_regions, OBJECT_CELL_SIZE));
+}
+
+void TerrainObjectManager::UnbatchObject(TerrainEditorObject* object)
+{
+    if (object->static_batch_id == -1)
+    {
+        return;
+    }
+
+    StaticBatch& batch = m_static_batches[object->static_batch_id];
+    auto itor = std::find(batch.objects.begin(), batch.objects.end(), object);
+    ROR_ASSERT(itor != batch.objects.end());
+    Ogre::Entity* entity = FindStaticObjectEntity(*itor);
+    if (entity)
+    {
+        entity->setVisible(true);
+    }
+    batch.objects.erase(itor);
+    batch.needs_rebuild = true;
+    object->static_batch_id = -1;
+}
+
+void TerrainObjectManager::UpdateStaticBatches()
+{
+    for (int i = 0; i < static_cast<int>(m_static_batches.size()); i++)
+    {
+        if (m_static_batches[i].needs_rebuild)
+        {
+            this->BuildStaticBatch(i);
+        }
+    }
+}
+
+TerrainObjectManager::ObjectTileKey TerrainObjectManager::GetObjectTileKey(Ogre::Vector3 const& pos)
+{
+    return ObjectTileKey(
+        static_cast<int>(std::floor(pos.x / OBJECT_CELL_SIZE)),
+        static_cast<int>(std::floor(pos.z / OBJECT_CELL_SIZE)));
+}
+
+void TerrainObjectManager::UpdateObjectStreaming()
+{
+    if (m_object_tiles.empty())
+    {
+        return;
+    }
+
+    // Visuals are needed around the camera and all actors - the camera may switch to any of them.
+    std::vector<Ogre::Vector2> viewers;
+    const Ogre::Vector3 cam_pos = App::GetCameraManager()->GetCameraNode()->getPosition();
+    viewers.push_back(Ogre::Vector2(cam_pos.x, cam_pos.z));
+    for (GfxActor* gfx_actor : App::GetGfxScene()->GetGfxActors())
+    {
+        const Ogre::Vector3& pos = gfx_actor->GetSimDataBuffer().simbuf_pos;
+        viewers.push_back(Ogre::Vector2(pos.x, pos.z));
+    }
+
+    const float load_range = App::gfx_terrain_object_streaming_range->getFloat();
+    const float unload_range = load_range * OBJECT_STREAMING_UNLOAD_FACTOR;
+    std::vector<std::pair<float, ObjectTile*>> tiles_to_load; // Distance, tile
+    for (auto& entry : m_object_tiles)
+    {
+        // Distance to the nearest point of the tile, on the ground plane.
+        const float x0 = entry.first.first * OBJECT_CELL_SIZE;
+        const float z0 = entry.first.second * OBJECT_CELL_SIZE;
+        float dist_sq = FLT_MAX;
+        for (Ogre::Vector2 const& viewer : viewers)
+        {
+            const float dx = std::max(0.f, std::max(x0 - viewer.x, viewer.x - (x0 + OBJECT_CELL_SIZE)));
+            const float dz = std::max(0.f, std::max(z0 - viewer.y, viewer.y - (z0 + OBJECT_CELL_SIZE)));
+            dist_sq = std::min(dist_sq, dx * dx + dz * dz);
+        }
+
+        if (!entry.second.loaded && dist_sq < load_range * load_range)
+        {
+            tiles_to_load.push_back(std::make_pair(dist_sq, &entry.second));
+        }
+        else if (entry.second.loaded && dist_sq > unload_range * unload_range)
+        {
+            this->UnloadObjectTile(entry.second);
+        }
+    }
+
+    // Nearest first; the first update (terrain just loaded) takes everything in range, later ones are time-sliced to avoid hitches.
+    std::sort(tiles_to_load.begin(), tiles_to_load.end(),
+        [](std::pair<float, ObjectTile*> const& a, std::pair<float, ObjectTile*> const& b) { return a.first < b.first; });
+    Ogre::Timer timer;
+    for (auto& entry : tiles_to_load)
+    {
+        this->LoadObjectTile(*entry.second);
+        if (m_object_tiles_primed && timer.getMicroseconds() > OBJECT_STREAMING_BUDGET_US)
+        {
+            break;
+        }
+    }
+    m_object_tiles_primed = true;
+}
+
+void TerrainObjectManager::LoadObjectTile(ObjectTile& tile)
+{
+    for (TerrainEditorObjectPtr& object : tile.objects)
+    {
+        ODefDocument* odef = this->FetchODef(object->name); // Cached since `LoadTerrainObject()`
+        if (odef)
+        {
+            this->CreateObjectVisuals(object, odef, /*uniquifyMaterial:*/false);
+        }
+    }
+    tile.loaded = true;
+}
+
+void TerrainObjectManager::UnloadObjectTile(ObjectTile& tile)
+{
+    for (TerrainEditorObjectPtr& object : tile.objects)
+    {
+        this->DestroyObjectVisuals(object);
+    }
+    tile.loaded = false;
+}
+
+static void DestroyAttachedObjectsRecursive(Ogre::SceneNode* node)
+{
+    while (node->numAttachedObjects() > 0)
+    {
+        App::GetGfxScene()->GetSceneManager()->destroyMovableObject(node->getAttachedObject(0));
+    }
+    for (Ogre::Node* child : node->getChildren())
+    {
+        DestroyAttachedObjectsRecursive(static_cast<Ogre::SceneNode*>(child));
+    }
+}
+
+void TerrainObjectManager::DestroyObjectVisuals(TerrainEditorObjectPtr const& object)
+{
+    this->UnbatchObject(object.GetRef());
+
+    Ogre::SceneNode* node = object->static_object_node;
+    m_particle_effect_objects.erase(
+        std::remove_if(m_particle_effect_objects.begin(), m_particle_effect_objects.end(),
+            [node](ParticleEffectObject const& peo) { return peo.node->getParentSceneNode() == node; }),
+        m_particle_effect_objects.end());
+
+    auto mo_itor = std::find_if(m_mesh_objects.begin(), m_mesh_objects.end(),
+        [node](MeshObject* mo) { return mo->GetSceneNode() == node; });
+    if (mo_itor != m_mesh_objects.end())
+    {
+        delete *mo_itor;
+        m_mesh_objects.erase(mo_itor);
+    }
+
+    DestroyAttachedObjectsRecursive(node);
+    node->removeAndDestroyAllChildren();
+}
+
+void TerrainObjectManager::PrepareObjectForEditing(TerrainEditorObject* object)
+{
+    if (object->static_streamed)
+    {
+        // Take it out of its tile for good; an edited object stays visible regardless of distance.
+        ObjectTile& tile = m_object_tiles[GetObjectTileKey(object->position)];
+        auto itor = std::find(tile.objects.begin(), tile.objects.end(), object);
+        ROR_ASSERT(itor != tile.objects.end());
+        TerrainEditorObjectPtr object_ptr = *itor;
+        tile.objects.erase(itor);
+        object->static_streamed = false;
+        if (!tile.loaded)
+        {
+            ODefDocument* odef = this->FetchODef(object->name);
+            if (odef)
+            {
+                this->CreateObjectVisuals(object_ptr, odef, /*uniquifyMaterial:*/false);
+            }
+        }
+    }
+
+    this->UnbatchObject(object);
+}
+
 void TerrainObjectManager::ProcessODefCollisionBoxes(TerrainEditorObjectPtr obj, ODefDocument* odef, const TerrainEditorObjectPtr& params, bool race_event)
 {
     for (ODefCollisionBox& cbox : odef->collision_boxes)
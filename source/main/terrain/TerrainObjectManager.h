@@ -39,6 +39,7 @@
 #endif //USE_PAGED
 
 #include <map>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
@@ -65,6 +66,8 @@ public:
 
     TerrainEditorObjectPtrVec& GetEditorObjects() { return m_editor_objects; }
     std::vector<TObjDocumentPtr>& GetTobjCache() { return m_tobj_cache; }
+    void           StartParsingTObjFiles(std::vector<std::string> const& tobj_names); //!< Reads the files on main thread, parses them on the thread pool.
+    void           FinishParsingTObjFiles(); //!< Waits for `StartParsingTObjFiles()`, then reads all referenced ODefs and parses them on the thread pool.
     void           LoadTObjFile(Ogre::String filename);
     bool           LoadTerrainObject(const Ogre::String& name, const Ogre::Vector3& pos, const Ogre::Vector3& rot, const Ogre::String& instancename, const Ogre::String& type, float rendering_distance = 0, bool enable_collisions = true, int scripthandler = -1, bool uniquifyMaterial = false);
     bool           LoadTerrainScript(const Ogre::String& filename);
@@ -76,6 +79,9 @@ public:
     void           LoadPredefinedActors();
     bool           HasPredefinedActors() { return m_has_predefined_actors; };
     bool           UpdateTerrainObjects(float dt);
+    void           BuildStaticBatches(); //!< Bakes the objects collected while loading into static geometry, see `gfx_static_batching`; later objects are rendered individually.
+    void           UnbatchObject(TerrainEditorObject* object); //!< Lets the object be moved or destroyed - shows its own entity again; the batch is rebuilt on next update.
+    void           PrepareObjectForEditing(TerrainEditorObject* object); //!< Unbatches the object and exempts it from streaming (creating its visuals if they're streamed out).
 
     void ProcessTree(
         float yawfrom, float yawto,
@@ -113,15 +119,64 @@ protected:
         Ogre::SceneNode* node = nullptr;
     };
 
+    /// Non-animated objects within one world cell which share rendering distance and shadow mode.
+    /// `Ogre::StaticGeometry` merges their meshes by material, so a cell full of lamp posts renders in a handful of draw calls.
+    struct StaticBatch
+    {
+        Ogre::StaticGeometry*      geometry = nullptr; //!< Null until built
+        TerrainEditorObjectPtrVec  objects;
+        float                      rendering_distance = 0.f;
+        bool                       cast_shadows = false;
+        bool                       needs_rebuild = false;
+    };
+    typedef std::tuple<int, int, int, bool> StaticBatchKey; //!< Cell X, cell Z, rendering distance (meters), cast shadows
+
+    /// Objects from TOBJ files within one world cell (same cells as `StaticBatch`), see `gfx_terrain_object_streaming`.
+    /// Only the visuals (entity, particles, lights) come and go; scene nodes, collisions, localizers and map icons stay resident.
+    struct ObjectTile
+    {
+        TerrainEditorObjectPtrVec  objects;
+        bool                       loaded = false;
+    };
+    typedef std::pair<int, int> ObjectTileKey; //!< Cell X, cell Z
+
+    /// Only the parsing runs on the thread pool; the OGRE resource system and scene graph are only touched from main thread.
+    struct TObjParseJob
+    {
+        std::string           tobj_name;
+        Ogre::DataStreamPtr   stream;   //!< File contents, read into memory on main thread.
+        TObjDocumentPtr       document; //!< Result; null if parsing failed - `LoadTObjFile()` then retries synchronously and reports the error.
+        std::shared_ptr<Task> task;
+    };
+
     // ODef processing functions
 
     RoR::ODefDocument* FetchODef(std::string const & odef_name);
+    Ogre::DataStreamPtr OpenODefFile(std::string const & odef_name); //!< Returns null if not found.
+    static std::shared_ptr<RoR::ODefDocument> ParseODefFile(Ogre::DataStreamPtr ds); //!< Thread-safe.
+    TObjDocumentPtr TakeParsedTObj(std::string const & tobj_name); //!< Returns null if not pre-parsed, see `StartParsingTObjFiles()`
     void           ProcessODefCollisionBoxes(TerrainEditorObjectPtr obj, ODefDocument* odef, const TerrainEditorObjectPtr& params, bool race_event);
     
     // Update functions
 
     void           UpdateAnimatedObjects(float dt);
     void           UpdateParticleEffectObjects();
+    void           UpdateStaticBatches(); //!< Rebuilds batches which lost objects, see `UnbatchObject()`
+    void           UpdateObjectStreaming(); //!< Loads tiles near the camera and actors (nearest first, time-sliced), unloads distant ones.
+
+    // Static batching
+
+    void           AddToStaticBatch(TerrainEditorObjectPtr const& object, float rendering_distance, bool cast_shadows);
+    void           BuildStaticBatch(int batch_id);
+    static Ogre::Entity* FindStaticObjectEntity(TerrainEditorObjectPtr const& object);
+
+    // Object streaming
+
+    void           CreateObjectVisuals(TerrainEditorObjectPtr const& object, ODefDocument* odef, bool uniquifyMaterial);
+    void           DestroyObjectVisuals(TerrainEditorObjectPtr const& object); //!< Keeps the scene node so the object can be shown again.
+    void           LoadObjectTile(ObjectTile& tile);
+    void           UnloadObjectTile(ObjectTile& tile);
+    static ObjectTileKey GetObjectTileKey(Ogre::Vector3 const& pos);
 
     // Helpers
 
@@ -132,11 +187,17 @@ protected:
     LocalizerVec                          m_localizers;
     std::unordered_map<std::string, std::shared_ptr<RoR::ODefDocument>> m_odef_cache;
     std::vector<TObjDocumentPtr>          m_tobj_cache;
+    std::vector<std::shared_ptr<TObjParseJob>> m_tobj_parse_jobs;
     int                                   m_tobj_cache_active_id = -1;
     TerrainEditorObjectPtrVec             m_editor_objects;
     bool                                  m_has_predefined_actors = false;
     std::vector<AnimatedObject>           m_animated_objects;
     std::vector<ParticleEffectObject>     m_particle_effect_objects;
+    std::vector<StaticBatch>              m_static_batches;
+    std::map<StaticBatchKey, int>         m_static_batch_lookup;     //!< Offsets to `m_static_batches`
+    bool                                  m_static_batches_built = false;
+    std::map<ObjectTileKey, ObjectTile>   m_object_tiles;
+    bool                                  m_object_tiles_primed = false; //!< The first update loads everything in range at once, later ones are time-sliced.
     std::vector<MeshObject*>              m_mesh_objects;
     SurveyMapEntityVec                    m_map_entities;
     Terrain*                  terrainManager = nullptr;
@@ -21,23 +21,26 @@ along with Rigs of Rods.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "Application.h"
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <stdexcept>
 #include <vector>
 
 namespace RoR {
 
+class ThreadPool;
+
 /** /brief Handle for a task executed by ThreadPool
  *
  * Returned by ThreadPool instance when submitting a new task to run.
- * Provides a thin wrapper around the callable object which implements the actual task.
  * Allows for synchronization, i.e. to wait for the associated task to finish (see join()).
+ * For many small tasks which are waited for together, prefer a TaskGroup - it needs no allocation per task.
  *
  * \see ThreadPool
  */
@@ -46,43 +49,46 @@ class Task
     friend class ThreadPool;
     public:
     /// Block the current thread and wait for the associated task to finish.
-    void join() const
-    {
-        // Wait until the tasks is_finished property is set to true by the ThreadPool instance.
-        // Three possible scenarios:
-        // 1) Execution of task has not started yet
-        //    - locks task_mutex
-        //    - is_finished will be false
-        //    - therefore unlocks task_mutex again and waits until signaled by thread pool
-        //    - then is_finished will be true (except in case of spurious wakeups for which the waiting continues)
-        // 2) Task is being executed
-        //    - will try to lock task_mutex, but will fail
-        //    - task_mutex is locked while the task is still running
-        //    - is_finished will be true after aquiring the lock
-        // 3) Task has already finished execution
-        //    - locks task_mutex
-        //    - is_finished will be true
-        std::unique_lock<std::mutex> lock(m_task_mutex);
-        m_finish_cv.wait(lock, [this]{ return m_is_finished; });
-    }
+    void join() const;
+
+    /// Non-blocking check; see also ThreadPool::HelpUntil().
+    bool IsFinished() const { return m_num_pending.load() == 0; }
 
     private:
     // Only constructable by friend class ThreadPool
-    Task(std::function<void()> task_func) : m_task_func(task_func) {}
+    Task(ThreadPool* pool) : m_pool(pool) {}
     Task(Task &) = delete;
     Task & operator=(Task &) = delete;
 
-    bool m_is_finished = false;                   //!< Indicates whether the task execution has finished.
-    mutable std::condition_variable m_finish_cv;  //!< Used to signal the current thread when the task has finished.
-    mutable std::mutex m_task_mutex;              //!< Mutex which is locked while the task is running.
-    const std::function<void()> m_task_func;      //!< Callable object which implements the task to execute.
+    ThreadPool* m_pool;
+    std::atomic<size_t> m_num_pending{1};         //!< Drops to 0 when the task execution has finished.
+};
+
+/** \brief Counts tasks submitted with ThreadPool::RunTask(TaskGroup&, ...); wait for all of them with ThreadPool::WaitForGroup().
+ *
+ * Just an atomic counter - the group must outlive its tasks, i.e. always wait before destroying it.
+ */
+class TaskGroup
+{
+    friend class ThreadPool;
+    public:
+    TaskGroup() {}
+    TaskGroup(TaskGroup &) = delete;
+    TaskGroup & operator=(TaskGroup &) = delete;
+
+    bool IsIdle() const { return m_num_pending.load() == 0; }
+
+    private:
+    std::atomic<size_t> m_num_pending{0};
 };
 
 /** \brief Facilitates execution of (small) tasks on separate threads.
  *
  * Implements a "rent-a-thread" model where each submitted task is assigned to one of several worker threads managed by the thread pool instance.
- * This is especially useful for short running tasks as it avoids the runtime cost of creating and launching a new thread. Notice, there
- * still is a certain overhead present due to the synchronization of threads required in the internal implementation.
+ * Each worker has its own task deque: tasks submitted from a worker go to its own deque (taken newest-first, while the data is
+ * still in cache), tasks submitted from other threads are distributed round-robin. An idle worker steals the oldest task
+ * from the other deques before it spins (see `app_worker_spin_count`) and finally parks on a condition variable.
+ * Completion is tracked by atomic counters; threads waiting for them spin the same way, then park on a single shared condition variable.
  *
  * Usage example 1:
  * \code
@@ -100,7 +106,14 @@ class Task
  *  tp.Parallelize({task1, task2});  // Run tasks in parallel and wait until all have finished
  * \endcode
  *
- * \see Task
+ * Usage example 3:
+ * \code
+ *  TaskGroup group;
+ *  for (Item& item: items) { tp.RunTask(group, [&item]{ item.Update(); }); }
+ *  tp.WaitForGroup(group);
+ * \endcode
+ *
+ * \see Task, TaskGroup
  */
 class ThreadPool {
 public:
@@ -119,102 +132,339 @@ public:
         RoR::LogFormat("[RoR|ThreadPool] Found %d logical CPU cores, creating %d worker threads",
                   logical_cores, num_threads);
 
-        return new ThreadPool(num_threads);
+        return new ThreadPool(num_threads, App::app_worker_spin_count->getInt());
     }
 
     /** \brief Construct thread pool and launch worker threads.
      *
      * @param num_threads Number of worker threads to use
+     * @param spin_count How many times an idle thread re-checks for work (yielding in between) before it parks.
      */
-    ThreadPool(int num_threads)
+    ThreadPool(int num_threads, int spin_count = 0)
+        : m_spin_count(std::max(spin_count, 0))
     {
         ROR_ASSERT(num_threads > 0);
 
-        // Generic function (to be run on a separate thread) within which submitted tasks
-        // are executed. It implements an endless loop (only returning when the ThreadPool
-        // instance itself is destructed) which constantly checks the task queue, grabbing
-        // and executing the frontmost task while the queue is not empty.
-        auto thread_body = [this]{ 
-            while (true) {
-                // Get next task from queue (synchronized access via taskqueue_mutex).
-                // If the queue is empty wait until either
-                //   - being signaled about an available task.
-                //   - the terminate flag is true (i.e. the ThreadPool instance is being destructed).
-                //     In this case return from the running thread.
-                std::unique_lock<std::mutex> queue_lock(m_taskqueue_mutex);
-                while (m_taskqueue.empty()) {
-                    if (m_terminate.load()) { return; }
-                    m_task_available_cv.wait(queue_lock);
-                }
-                const auto current_task = m_taskqueue.front();
-                m_taskqueue.pop();
-                queue_lock.unlock();
-
-                // Execute the actual task and signal the associated Task instance when finished.
-                {
-                    std::lock_guard<std::mutex> task_lock(current_task->m_task_mutex);
-                    current_task->m_task_func();
-                    current_task->m_is_finished = true;
-                }
-                current_task->m_finish_cv.notify_all();
-            }
-        };
-
+        for (int i = 0; i < num_threads; ++i) {
+            m_queues.emplace_back(new WorkerQueue());
+        }
         // Launch the specified number of threads
         for (int i = 0; i < num_threads; ++i) {
-            m_threads.emplace_back(thread_body);
+            m_threads.emplace_back([this, i]{ this->WorkerMain(static_cast<size_t>(i)); });
         }
     }
 
     ~ThreadPool() {
         // Indicate termination and signal potential waiting threads to wake up.
         // Then wait for all threads to finish their work and return properly.
-        m_terminate = true;
-        m_task_available_cv.notify_all();
+        {
+            std::lock_guard<std::mutex> lock(m_wake_mutex);
+            m_terminate = true;
+        }
+        m_wake_cv.notify_all();
         for (auto &t : m_threads) { t.join(); }
     }
 
     /// Submit new asynchronous task to thread pool and return Task handle to allow for synchronization.
     std::shared_ptr<Task> RunTask(const std::function<void()> &task_func) {
-        // Wrap provided task callable object in task handle. Then append it to the task queue and
-        // notify a waiting worker thread (if any) about the newly available task
-        auto task = std::shared_ptr<Task>(new Task(task_func));
+        // The job keeps a reference, so the handle stays valid until the job is done even if the caller drops it.
+        auto task = std::shared_ptr<Task>(new Task(this));
+        this->PushJob([task, task_func]{ task_func(); }, &task->m_num_pending);
+        return task;
+    }
+
+    /// Submit new asynchronous task as part of a group; see WaitForGroup().
+    void RunTask(TaskGroup& group, const std::function<void()> &task_func) {
+        group.m_num_pending.fetch_add(1);
+        this->PushJob(task_func, &group.m_num_pending);
+    }
+
+    /// Block the current thread until all tasks of the group have finished.
+    void WaitForGroup(const TaskGroup& group) {
+        this->WaitForCounter(group.m_num_pending);
+    }
+
+    /** \brief Split index range [0, count) into chunks and process them in parallel; returns when all chunks are done.
+     *
+     * The calling thread participates in processing the chunks. Unlike waiting for a Task, it never waits for a helper which
+     * is still queued - only for chunks which are already being processed - so it's safe to use from within a running task.
+     *
+     * @param func Called as `func(begin, end, participant)`; participant is unique per concurrently running
+     *             thread and lies in range [0, max_participants), use it to index per-thread accumulators.
+     * @param max_participants Upper limit of threads (including the calling one); clamped to GetNumWorkers() + 1.
+     * @return Number of participant slots which may have been used.
+     */
+    size_t ParallelFor(size_t count, size_t chunk_size, size_t max_participants, const std::function<void(size_t, size_t, size_t)> &func)
+    {
+        if (count == 0) return 0;
+
+        chunk_size = std::max(chunk_size, size_t(1));
+        const size_t num_chunks = (count + chunk_size - 1) / chunk_size;
+        max_participants = std::min(std::min(max_participants, m_threads.size() + 1), num_chunks);
+        if (max_participants <= 1)
         {
-            std::lock_guard<std::mutex> lock(m_taskqueue_mutex);
-            m_taskqueue.push(task);
+            func(0, count, 0);
+            return 1;
         }
-        m_task_available_cv.notify_one();
 
-        // Return task handle for later synchronization
-        return task;
+        // Shared with helper jobs, which may outlive this call if they start late (they'll find no work then).
+        auto state = std::make_shared<ParallelForState>();
+        state->count = count;
+        state->chunk_size = chunk_size;
+        state->num_chunks = num_chunks;
+        state->num_remaining_chunks = num_chunks;
+        state->func = &func;
+
+        for (size_t i = 1; i < max_participants; ++i)
+        {
+            this->PushJob([this, state, i]{ this->ProcessParallelForChunks(*state, i); }, nullptr, /*helpable:*/true);
+        }
+
+        this->ProcessParallelForChunks(*state, 0);
+        this->WaitForCounter(state->num_remaining_chunks);
+        return max_participants;
     }
 
+    size_t GetNumWorkers() const { return m_threads.size(); }
+
     /// Run collection of tasks in parallel and wait until all have finished.
+    /// The calling thread runs tasks too, so this is safe to use from within a running task.
     void Parallelize(const std::vector<std::function<void()>> &task_funcs)
     {
-        if (task_funcs.empty()) return;
+        this->ParallelFor(task_funcs.size(), /*chunk_size:*/1, task_funcs.size(),
+            [&task_funcs](size_t begin, size_t end, size_t)
+            {
+                for (size_t i = begin; i < end; ++i) { task_funcs[i](); }
+            });
+    }
+
+    /** \brief Let a non-worker thread which would otherwise block help out with short jobs (ParallelFor()/Parallelize() chunks).
+     *
+     * Returns when `is_done()` is true, or when no such job showed up for a while (then the caller should block the usual way).
+     * Long tasks submitted by RunTask() are never picked up here, so the calling thread isn't held up by i.e. background loading.
+     */
+    void HelpUntil(const std::function<bool()>& is_done)
+    {
+        Job job;
+        int idle_count = 0;
+        while (!is_done() && idle_count <= m_spin_count)
+        {
+            if (this->TryStealHelpableJob(job))
+            {
+                m_num_queued.fetch_sub(1);
+                this->RunJob(job);
+                idle_count = 0;
+            }
+            else
+            {
+                ++idle_count;
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /// Block the current thread until the counter drops to 0; spins first, then parks.
+    void WaitForCounter(const std::atomic<size_t>& counter)
+    {
+        for (int i = 0; i < m_spin_count; ++i)
+        {
+            if (counter.load() == 0) { return; }
+            std::this_thread::yield();
+        }
+
+        std::unique_lock<std::mutex> lock(m_done_mutex);
+        m_num_done_waiters.fetch_add(1);
+        m_done_cv.wait(lock, [&counter]{ return counter.load() == 0; });
+        m_num_done_waiters.fetch_sub(1);
+    }
+
+private:
+    struct Job
+    {
+        std::function<void()> func;
+        std::atomic<size_t>*  counter = nullptr; //!< Decremented when the job is done; optional.
+        bool                  helpable = false;  //!< Short job which HelpUntil() may run.
+    };
+
+    struct WorkerQueue
+    {
+        std::mutex       mutex;
+        std::deque<Job>  jobs;                   //!< Owner works at the back, thieves steal from the front.
+    };
+
+    struct ParallelForState
+    {
+        size_t count = 0;
+        size_t chunk_size = 0;
+        size_t num_chunks = 0;
+        const std::function<void(size_t, size_t, size_t)>* func = nullptr; //!< Only dereferenced while a chunk is claimed.
+        std::atomic<size_t> next_chunk{0};
+        std::atomic<size_t> num_remaining_chunks{0};
+    };
 
-        // Launch all provided tasks (except for the first) in parallel and store the associated handles
-        auto it = begin(task_funcs);
-        const auto first_task = it++;
-        std::vector<std::shared_ptr<Task>> handles;
-        for(; it != end(task_funcs); ++it)
-        { 
-            handles.push_back(RunTask(*it));
+    struct CurrentWorker
+    {
+        const ThreadPool* pool = nullptr;
+        size_t index = 0;
+    };
+
+    static CurrentWorker& GetCurrentWorker()
+    {
+        static thread_local CurrentWorker current_worker;
+        return current_worker;
+    }
+
+    void ProcessParallelForChunks(ParallelForState& state, size_t participant)
+    {
+        size_t chunk;
+        while ((chunk = state.next_chunk.fetch_add(1)) < state.num_chunks)
+        {
+            const size_t begin = chunk * state.chunk_size;
+            const size_t end = std::min(begin + state.chunk_size, state.count);
+            (*state.func)(begin, end, participant);
+            this->FinishCounter(state.num_remaining_chunks);
         }
+    }
 
-        // Run the first task locally on the current thread
-        (*first_task)();
+    void PushJob(std::function<void()> func, std::atomic<size_t>* counter, bool helpable = false)
+    {
+        // Workers push to their own deque; other threads spread the jobs.
+        CurrentWorker const& current_worker = GetCurrentWorker();
+        const size_t queue_index = (current_worker.pool == this)
+            ? current_worker.index
+            : (m_next_queue.fetch_add(1) % m_queues.size());
+
+        Job job;
+        job.func = std::move(func);
+        job.counter = counter;
+        job.helpable = helpable;
+
+        m_num_queued.fetch_add(1); // Before the push, so that a worker never decrements first.
+        {
+            std::lock_guard<std::mutex> lock(m_queues[queue_index]->mutex);
+            m_queues[queue_index]->jobs.push_back(std::move(job));
+        }
 
-        // Synchronize, i.e. wait for all parallelized tasks to complete
-        for(const auto &h : handles) { h->join(); }
+        if (m_num_sleeping.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(m_wake_mutex);
+            m_wake_cv.notify_one();
+        }
     }
 
-    std::atomic_bool m_terminate{false};            //!< Indicates destruction of ThreadPool instance to worker threads
-    std::vector<std::thread> m_threads;             //!< Collection of worker threads to run tasks
-    std::queue<std::shared_ptr<Task>> m_taskqueue;  //!< Queue of submitted tasks pending for execution
-    std::mutex m_taskqueue_mutex;                   //!< Protects task queue from concurrent access.
-    std::condition_variable m_task_available_cv;    //!< Used to signal threads that a new task was submitted and is ready to run.
+    bool TryPopJob(size_t worker_index, Job& out_job)
+    {
+        // Own deque first, newest job
+        {
+            WorkerQueue& queue = *m_queues[worker_index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.jobs.empty())
+            {
+                out_job = std::move(queue.jobs.back());
+                queue.jobs.pop_back();
+                return true;
+            }
+        }
+
+        // Steal the oldest job from another worker
+        for (size_t i = 1; i < m_queues.size(); ++i)
+        {
+            WorkerQueue& queue = *m_queues[(worker_index + i) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.jobs.empty())
+            {
+                out_job = std::move(queue.jobs.front());
+                queue.jobs.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool TryStealHelpableJob(Job& out_job)
+    {
+        for (auto& queue_ptr: m_queues)
+        {
+            WorkerQueue& queue = *queue_ptr;
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            for (auto itor = queue.jobs.begin(); itor != queue.jobs.end(); ++itor)
+            {
+                if (itor->helpable)
+                {
+                    out_job = std::move(*itor);
+                    queue.jobs.erase(itor);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void RunJob(Job& job)
+    {
+        job.func();
+        if (job.counter) { this->FinishCounter(*job.counter); }
+        job = Job(); // Release captured data (i.e. Task handle) now, not on next pop.
+    }
+
+    void FinishCounter(std::atomic<size_t>& counter)
+    {
+        if (counter.fetch_sub(1) == 1 && m_num_done_waiters.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(m_done_mutex);
+            m_done_cv.notify_all();
+        }
+    }
+
+    void WorkerMain(size_t worker_index)
+    {
+        GetCurrentWorker().pool = this;
+        GetCurrentWorker().index = worker_index;
+
+        Job job;
+        while (true) {
+            if (this->TryPopJob(worker_index, job))
+            {
+                m_num_queued.fetch_sub(1);
+                this->RunJob(job);
+                continue;
+            }
+
+            // Spin a while - jobs often come in bursts (i.e. physics substeps) and parking costs a context switch.
+            bool work_available = false;
+            for (int i = 0; i < m_spin_count && !work_available; ++i)
+            {
+                work_available = (m_num_queued.load() > 0);
+                if (!work_available) { std::this_thread::yield(); }
+            }
+            if (work_available) { continue; }
+
+            // Park until signaled about an available job or termination.
+            std::unique_lock<std::mutex> lock(m_wake_mutex);
+            m_num_sleeping.fetch_add(1);
+            m_wake_cv.wait(lock, [this]{ return m_num_queued.load() > 0 || m_terminate; });
+            m_num_sleeping.fetch_sub(1);
+            if (m_terminate && m_num_queued.load() == 0) { return; }
+        }
+    }
+
+    const int m_spin_count;
+    bool m_terminate = false;                                //!< Indicates destruction of ThreadPool instance to worker threads; protected by `m_wake_mutex`
+    std::vector<std::thread> m_threads;                      //!< Collection of worker threads to run tasks
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;      //!< One per worker thread
+    std::atomic<size_t> m_next_queue{0};                     //!< Round-robin target for jobs submitted by non-worker threads
+    std::atomic<size_t> m_num_queued{0};                     //!< Jobs in all queues, not yet started
+    std::atomic<size_t> m_num_sleeping{0};                   //!< Parked workers
+    std::mutex m_wake_mutex;
+    std::condition_variable m_wake_cv;                       //!< Used to signal parked workers that a new job was submitted.
+    std::atomic<size_t> m_num_done_waiters{0};               //!< Threads parked in WaitForCounter()
+    std::mutex m_done_mutex;
+    std::condition_variable m_done_cv;                       //!< Used to signal parked waiters that some counter dropped to 0.
 };
 
-} // namespace RoR
\ No newline at end of file
+inline void Task::join() const
+{
+    m_pool->WaitForCounter(m_num_pending);
+}
+
+} // namespace RoR
@@ -21,8 +21,10 @@
 
 #include "Application.h"
 #include "Console.h"
+#include "PlatformUtils.h"
 
 #include <algorithm>
+#include <cstring>
 
 using namespace RoR;
 using namespace Ogre;
@@ -52,13 +54,13 @@ enum class PartialToken
 
 struct DocumentParser
 {
-    DocumentParser(GenericDocument& d, const BitMask_t opt, Ogre::DataStreamPtr ds)
-        : doc(d), options(opt), datastream(ds) {}
+    DocumentParser(GenericDocument& d, const BitMask_t opt, std::string const& name)
+        : doc(d), options(opt), doc_name(name) {}
 
     // Config
     GenericDocument& doc;
     const BitMask_t options;
-    Ogre::DataStreamPtr datastream;
+    const std::string doc_name; // For messages only
 
     // State
     std::vector<char> tok;
@@ -67,6 +69,7 @@ struct DocumentParser
     PartialToken partial_tok_type = PartialToken::NONE;
     bool title_found = false; // Only for OPTION_FIRST_LINE_IS_TITLE
 
+    void ProcessBuffer(const char* buf, const size_t len);
     void ProcessChar(const char c);
     void ProcessEOF();
     void ProcessSeparatorWithinBool();
@@ -85,6 +88,8 @@ struct DocumentParser
     void DiscontinueKeyword();
     void FlushStringishToken(RoR::TokenType type);
     void FlushNumericToken();
+
+    const char* FindSpanEnd(const char* pos, const char* end) const;
 };
 
 void DocumentParser::BeginToken(const char c)
@@ -270,7 +275,7 @@ void DocumentParser::BeginToken(const char c)
     if (partial_tok_type == PartialToken::GARBAGE)
     {
         App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_WARNING,
-            fmt::format("{}, line {}, pos {}: stray character '{}'", datastream->getName(), line_num, line_pos, c));
+            fmt::format("{}, line {}, pos {}: stray character '{}'", doc_name, line_num, line_pos, c));
     }
 }
 
@@ -341,7 +346,7 @@ void DocumentParser::UpdateString(const char c)
         if (partial_tok_type == PartialToken::STRING_QUOTED)
         {
             App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_WARNING,
-                fmt::format("{}, line {}, pos {}: quoted string interrupted by newline", datastream->getName(), line_num, line_pos));
+                fmt::format("{}, line {}, pos {}: quoted string interrupted by newline", doc_name, line_num, line_pos));
         }
         this->FlushStringishToken(TokenType::STRING);
         // Break line
@@ -417,7 +422,7 @@ void DocumentParser::UpdateString(const char c)
     if (partial_tok_type == PartialToken::GARBAGE)
     {
         App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_WARNING,
-            fmt::format("{}, line {}, pos {}: stray character '{}' in string", datastream->getName(), line_num, line_pos, c));
+            fmt::format("{}, line {}, pos {}: stray character '{}' in string", doc_name, line_num, line_pos, c));
     }
 }
 
@@ -577,7 +582,7 @@ void DocumentParser::UpdateNumber(const char c)
     if (partial_tok_type == PartialToken::GARBAGE)
     {
         App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_WARNING,
-            fmt::format("{}, line {}, pos {}: stray character '{}' in number", datastream->getName(), line_num, line_pos, c));
+            fmt::format("{}, line {}, pos {}: stray character '{}' in number", doc_name, line_num, line_pos, c));
     }
 }
 
@@ -596,7 +601,7 @@ void DocumentParser::ProcessSeparatorWithinBool()
             // Discard token
             tok.push_back('\0');
             App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_WARNING,
-                fmt::format("{}, line {}, pos {}: discarding incomplete boolean token '{}'", datastream->getName(), line_num, line_pos, tok.data()));
+                fmt::format("{}, line {}, pos {}: discarding incomplete boolean token '{}'", doc_name, line_num, line_pos, tok.data()));
             tok.clear();
             partial_tok_type = PartialToken::NONE;
             break;
@@ -727,7 +732,7 @@ void DocumentParser::UpdateBool(const char c)
     if (partial_tok_type == PartialToken::GARBAGE)
     {
         App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_WARNING,
-            fmt::format("{}, line {}, pos {}: stray character '{}' in boolean", datastream->getName(), line_num, line_pos, c));
+            fmt::format("{}, line {}, pos {}: stray character '{}' in boolean", doc_name, line_num, line_pos, c));
     }
 }
 
@@ -852,7 +857,7 @@ void DocumentParser::UpdateKeyword(const char c)
     if (partial_tok_type == PartialToken::GARBAGE)
     {
         App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_WARNING,
-            fmt::format("{}, line {}, pos {}: stray character '{}' in keyword", datastream->getName(), line_num, line_pos, c));
+            fmt::format("{}, line {}, pos {}: stray character '{}' in keyword", doc_name, line_num, line_pos, c));
     }
 }
 
@@ -891,7 +896,7 @@ void DocumentParser::UpdateGarbage(const char c)
     case '\n':
         tok.push_back('\0');
         App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_WARNING,
-            fmt::format("{}, line {}, pos {}: discarding garbage token '{}'", datastream->getName(), line_num, line_pos, tok.data()));
+            fmt::format("{}, line {}, pos {}: discarding garbage token '{}'", doc_name, line_num, line_pos, tok.data()));
         tok.clear();
         partial_tok_type = PartialToken::NONE;
         line_pos++;
@@ -908,7 +913,7 @@ void DocumentParser::FlushStringishToken(RoR::TokenType type)
 {
     doc.tokens.push_back({ type, (float)doc.string_pool.size() });
     tok.push_back('\0');
-    std::copy(tok.begin(), tok.end(), std::back_inserter(doc.string_pool));
+    doc.string_pool.insert(doc.string_pool.end(), tok.begin(), tok.end());
     tok.clear();
     partial_tok_type = PartialToken::NONE;
 }
@@ -928,6 +933,109 @@ void DocumentParser::FlushNumericToken()
     partial_tok_type = PartialToken::NONE;
 }
 
+inline bool IsDigitChar(const char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline bool IsKeywordChar(const char c) // Like `isalnum()` in "C" locale, plus '_'
+{
+    return IsDigitChar(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+inline bool IsNakedStringChar(const char c) // Characters which `UpdateString()` just appends, regardless of options
+{
+    return c != ' ' && c != ',' && c != '\t' && c != '\r' && c != '\n' && c != ':' && c != '=' && c != '"' && c != '(' && c != ')';
+}
+
+const char* FindLineEnd(const char* pos, const char* end) // First '\r' or '\n'
+{
+    const char* lf = static_cast<const char*>(memchr(pos, '\n', end - pos));
+    const char* line_end = (lf != nullptr) ? lf : end;
+    const char* cr = static_cast<const char*>(memchr(pos, '\r', line_end - pos));
+    return (cr != nullptr) ? cr : line_end;
+}
+
+/// Returns the end of the run of characters which the current state would just append to `tok`.
+/// Such runs are copied in bulk; everything else goes through `ProcessChar()`.
+const char* DocumentParser::FindSpanEnd(const char* pos, const char* end) const
+{
+    switch (partial_tok_type)
+    {
+    case PartialToken::COMMENT_SLASH:
+        if (tok.empty()) // Leading '/' are skipped
+            return pos;
+        return FindLineEnd(pos, end);
+
+    case PartialToken::COMMENT_SEMICOLON:
+    case PartialToken::COMMENT_HASH:
+    case PartialToken::TITLE_STRING:
+        return FindLineEnd(pos, end);
+
+    case PartialToken::STRING_QUOTED:
+        while (pos != end && *pos != '"' && *pos != '\n' && *pos != '\r')
+            pos++;
+        return pos;
+
+    case PartialToken::STRING_NAKED:
+    case PartialToken::STRING_NAKED_CAPTURING_SPACES:
+        while (pos != end && IsNakedStringChar(*pos))
+            pos++;
+        return pos;
+
+    case PartialToken::NUMBER_INTEGER:
+    case PartialToken::NUMBER_DECIMAL:
+    case PartialToken::NUMBER_SCIENTIFIC:
+        while (pos != end && IsDigitChar(*pos))
+            pos++;
+        return pos;
+
+    case PartialToken::KEYWORD:
+    case PartialToken::KEYWORD_BRACED:
+        while (pos != end && IsKeywordChar(*pos))
+            pos++;
+        return pos;
+
+    default:
+        return pos;
+    }
+}
+
+void DocumentParser::ProcessBuffer(const char* buf, const size_t len)
+{
+    const char* pos = buf;
+    const char* end = buf + len;
+    while (pos != end)
+    {
+        if (partial_tok_type == PartialToken::NONE)
+        {
+            // Skip separators
+            while (pos != end && (*pos == ' ' || *pos == ',' || *pos == '\t'))
+            {
+                line_pos++;
+                pos++;
+            }
+            if (pos == end)
+                break;
+            this->ProcessChar(*pos++);
+        }
+        else
+        {
+            const char* span_end = this->FindSpanEnd(pos, end);
+            if (span_end != pos)
+            {
+                tok.insert(tok.end(), pos, span_end);
+                line_pos += span_end - pos;
+                pos = span_end;
+            }
+            else
+            {
+                this->ProcessChar(*pos++);
+            }
+        }
+    }
+}
+
 void DocumentParser::ProcessChar(const char c)
 {
     switch (partial_tok_type)
@@ -1004,31 +1112,68 @@ void DocumentParser::ProcessEOF()
     }
 }
 
+void GenericDocument::reserveForTextSize(size_t text_size)
+{
+    // Typical files average ~6 characters per token (including separators); the string pool can't exceed the text much.
+    tokens.reserve(text_size / 5 + 1);
+    string_pool.reserve(text_size + 1);
+}
+
 void GenericDocument::loadFromDataStream(Ogre::DataStreamPtr datastream, const BitMask_t options)
 {
+    // If the whole text is already in memory, tokenize it in place.
+    Ogre::MemoryDataStream* memstream = dynamic_cast<Ogre::MemoryDataStream*>(datastream.get());
+    if (memstream != nullptr)
+    {
+        const size_t offset = memstream->tell();
+        this->loadFromBuffer(reinterpret_cast<const char*>(memstream->getCurrentPtr()), memstream->size() - offset, options, datastream->getName());
+        memstream->seek(memstream->size());
+        return;
+    }
+
     // Reset the document
     tokens.clear();
     string_pool.clear();
+    this->reserveForTextSize(datastream->size()); // 0 if unknown
 
     // Prepare context
-    DocumentParser parser(*this, options, datastream);
-    const size_t LINE_BUF_MAX = 10 * 1024; // 10Kb
-    char buf[LINE_BUF_MAX];
+    DocumentParser parser(*this, options, datastream->getName());
+    const size_t LINE_BUF_MAX = 64 * 1024; // 64Kb
+    std::vector<char> buf(LINE_BUF_MAX);
 
     // Parse the text
     while (!datastream->eof())
     {
-        size_t buf_len = datastream->read(buf, LINE_BUF_MAX);
-        for (size_t i = 0; i < buf_len; i++)
-        {
-            const char c = buf[i];
-
-            parser.ProcessChar(c);
-        }
+        size_t buf_len = datastream->read(buf.data(), LINE_BUF_MAX);
+        parser.ProcessBuffer(buf.data(), buf_len);
     }
     parser.ProcessEOF();
 }
 
+void GenericDocument::loadFromBuffer(const char* buf, size_t len, BitMask_t options, std::string const& name)
+{
+    // Reset the document
+    tokens.clear();
+    string_pool.clear();
+    this->reserveForTextSize(len);
+
+    // Parse the text
+    DocumentParser parser(*this, options, name);
+    parser.ProcessBuffer(buf, len);
+    parser.ProcessEOF();
+}
+
+bool GenericDocument::loadFromMappedFile(std::string const& path, BitMask_t options)
+{
+    MappedFile file;
+    if (!file.Open(path))
+    {
+        return false;
+    }
+    this->loadFromBuffer(file.GetData(), file.GetSize(), options, path);
+    return true;
+}
+
 #if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
     const char* EOL_STR = "\r\n"; // CR+LF
 #else
@@ -1098,6 +1243,17 @@ bool GenericDocument::loadFromResource(std::string resource_name, std::string re
 {
     try
     {
+        // Loose files are tokenized straight from a mapping; archives (i.e. ZIPs) must go through the DataStream.
+        if (resource_group_name != Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME)
+        {
+            Ogre::FileInfoListPtr file_infos = Ogre::ResourceGroupManager::getSingleton().findResourceFileInfo(resource_group_name, resource_name);
+            if (file_infos->size() == 1 && file_infos->front().archive->getType() == "FileSystem"
+                && this->loadFromMappedFile(PathCombine(file_infos->front().archive->getName(), file_infos->front().filename), options))
+            {
+                return true;
+            }
+        }
+
         Ogre::DataStreamPtr datastream = Ogre::ResourceGroupManager::getSingleton().openResource(resource_name, resource_group_name);
         this->loadFromDataStream(datastream, options);
         return true;
@@ -82,6 +82,11 @@ struct GenericDocument: public RefCountingObject<GenericDocument>
     virtual void loadFromDataStream(Ogre::DataStreamPtr datastream, BitMask_t options = 0);
     virtual void saveToDataStream(Ogre::DataStreamPtr datastream);
 
+    /// Tokenizes text already in memory (i.e. a mapped file) without copying it; `name` is for messages only.
+    void loadFromBuffer(const char* buf, size_t len, BitMask_t options = 0, std::string const& name = "");
+    bool loadFromMappedFile(std::string const& path, BitMask_t options = 0); //!< Loose files only; path must be UTF-8 encoded. Returns false if the file can't be opened or is empty.
+    void reserveForTextSize(size_t text_size); //!< Reserves `tokens` and `string_pool` for parsing text of the given size.
+
     virtual bool loadFromResource(std::string resource_name, std::string resource_group_name, BitMask_t options = 0);
     virtual bool saveToResource(std::string resource_name, std::string resource_group_name);
 };
@@ -427,6 +427,11 @@ InputEngine::InputEngine() :
     for (int i = 0; i < MAX_JOYSTICKS; i++)
         mJoy[i] = 0;
 
+    keyState.fill(false);
+    event_values_simulated.fill(0.f);
+    event_states_supressed.fill(false);
+    m_event_values.fill(0.f);
+
     LOG("*** Loading OIS ***");
 
     initAllKeys();
@@ -468,6 +473,9 @@ void InputEngine::destroy()
         OIS::InputManager::destroyInputSystem(mInputManager);
         mInputManager = 0;
     }
+
+    free_joysticks = 0;
+    m_bindings_dirty = true; // Joystick bindings are compiled against connected devices
 }
 
 void InputEngine::setup()
@@ -646,6 +654,9 @@ void InputEngine::Capture()
     }
 
     m_oisworkaround_frames_since_reset++;
+
+    // The listeners were invoked from `capture()` - evaluate all events at once
+    this->updateEventValues();
 }
 
 void InputEngine::windowResized(Ogre::RenderWindow* rw)
@@ -686,17 +697,22 @@ void InputEngine::ProcessJoystickEvent(const OIS::JoyStickEvent& arg)
     if (i < 0 || i >= MAX_JOYSTICKS)
         i = 0;
     joyState[i] = arg.state;
+    m_event_values_dirty = true;
 }
 
 /* --- Key Events ------------------------------------------ */
 void InputEngine::ProcessKeyPress(const OIS::KeyEvent& arg)
 {
-    keyState[arg.key] = 1;
+    if (arg.key < (int)keyState.size())
+        keyState[arg.key] = true;
+    m_event_values_dirty = true;
 }
 
 void InputEngine::ProcessKeyRelease(const OIS::KeyEvent& arg)
 {
-    keyState[arg.key] = 0;
+    if (arg.key < (int)keyState.size())
+        keyState[arg.key] = false;
+    m_event_values_dirty = true;
 }
 
 /* --- Mouse Events ------------------------------------------ */
@@ -706,6 +722,7 @@ void InputEngine::processMouseMotionEvent(const OIS::MouseEvent& arg)
     mouseState.X = arg.state.X;
     mouseState.Y = arg.state.Y;
     mouseState.Z = arg.state.Z;
+    m_event_values_dirty = true;
 }
 
 void InputEngine::processMousePressEvent(const OIS::MouseEvent& arg, OIS::MouseButtonID _id)
@@ -723,6 +740,7 @@ void InputEngine::processMousePressEvent(const OIS::MouseEvent& arg, OIS::MouseB
     // Only update the one particular button, OIS's persistent state may be dirty, see commentary in `getMouseState()`
     BitMask_t btnmask = 1 << _id;
     BITMASK_SET_1(mouseState.buttons, btnmask);
+    m_event_values_dirty = true;
 }
 
 void InputEngine::processMouseReleaseEvent(const OIS::MouseEvent& arg, OIS::MouseButtonID _id)
@@ -730,15 +748,13 @@ void InputEngine::processMouseReleaseEvent(const OIS::MouseEvent& arg, OIS::Mous
     // Only update the one particular button, OIS's persistent state may be dirty, see commentary in `getMouseState()`
     BitMask_t btnmask = 1 << _id;
     BITMASK_SET_0(mouseState.buttons, btnmask);
+    m_event_values_dirty = true;
 }
 
 /* --- Custom Methods ------------------------------------------ */
 void InputEngine::resetKeysAndMouseButtons()
 {
-    for (std::map<int, bool>::iterator iter = keyState.begin(); iter != keyState.end(); ++iter)
-    {
-        iter->second = false;
-    }
+    keyState.fill(false);
 
     // OIS WORKAROUND: After a window focus is restored for the 2nd+ time, OIS delivers a fabricated 'LMB pressed' event,
     //    without ever sending matching 'LMB released', see analysis: https://github.com/RigsOfRods/rigs-of-rods/pull/3184#issuecomment-2380397463
@@ -749,16 +765,19 @@ void InputEngine::resetKeysAndMouseButtons()
 
     // Reset internal button states; see commentary in `getMouseState()`
     mouseState.buttons = 0;
+    m_event_values_dirty = true;
 }
 
 void InputEngine::setEventSimulatedValue(RoR::events eventID, float value)
 {
-    event_values_simulated[eventID] = value;
+    if (eventID >= 0 && eventID < EV_MODE_LAST)
+        event_values_simulated[eventID] = value;
 }
 
 void InputEngine::setEventStatusSupressed(RoR::events eventID, bool supress)
 {
-    event_states_supressed[eventID] = supress;
+    if (eventID >= 0 && eventID < EV_MODE_LAST)
+        event_states_supressed[eventID] = supress;
 }
 
 bool InputEngine::getEventBoolValue(int eventID)
@@ -914,7 +933,7 @@ std::string InputEngine::composeEventConfigString(event_trigger_t const& trig)
 
 bool InputEngine::isEventDefined(int eventID)
 {
-    std::vector<event_trigger_t> t_vec = events[eventID];
+    std::vector<event_trigger_t> const& t_vec = events[eventID];
     if (t_vec.size() > 0)
     {
         if (t_vec[0].eventtype != ET_NONE) // TODO: handle multiple mappings for one event code - currently we only check the first one.
@@ -925,10 +944,8 @@ bool InputEngine::isEventDefined(int eventID)
 
 int InputEngine::getKeboardKeyForCommand(int eventID)
 {
-    std::vector<event_trigger_t> t_vec = events[eventID];
-    for (std::vector<event_trigger_t>::iterator i = t_vec.begin(); i != t_vec.end(); i++)
+    for (event_trigger_t const& t: events[eventID])
     {
-        event_trigger_t t = *i;
         if (t.eventtype == ET_Keyboard)
             return t.keyCode;
     }
@@ -937,7 +954,7 @@ int InputEngine::getKeboardKeyForCommand(int eventID)
 
 bool InputEngine::isEventAnalog(int eventID)
 {
-    std::vector<event_trigger_t> t_vec = events[eventID];
+    std::vector<event_trigger_t> const& t_vec = events[eventID];
     if (t_vec.size() > 0)
     {
         //loop through all eventtypes, because we want to find a analog device wether it is the first device or not
@@ -964,6 +981,9 @@ bool InputEngine::isEventAnalog(int eventID)
 
 float InputEngine::getEventValue(int eventID, bool pure, InputSourceType valueSource /*= InputSourceType::IST_ANY*/)
 {
+    if (eventID < 0 || eventID >= EV_MODE_LAST)
+        return 0.f;
+
     const float simulatedValue = event_values_simulated[eventID];
     if (simulatedValue != 0.f)
         return simulatedValue;
@@ -971,207 +991,282 @@ float InputEngine::getEventValue(int eventID, bool pure, InputSourceType valueSo
     if (event_states_supressed[eventID])
         return 0.f;
 
-    float returnValue = 0;
-    std::vector<event_trigger_t> t_vec = events[eventID];
-    float value = 0;
-    for (std::vector<event_trigger_t>::iterator i = t_vec.begin(); i != t_vec.end(); i++)
+    if (!pure && valueSource == InputSourceType::IST_ANY)
     {
-        event_trigger_t t = *i;
+        // The common case - already evaluated, see `updateEventValues()`
+        if (m_event_values_dirty || m_bindings_dirty)
+            this->updateEventValues();
+        return m_event_values[eventID];
+    }
+
+    if (m_bindings_dirty)
+        this->compileBindings();
+    return this->evaluateBindings(eventID, pure, valueSource);
+}
 
-        if (valueSource == InputSourceType::IST_DIGITAL || valueSource == InputSourceType::IST_ANY)
+void InputEngine::compileBindings()
+{
+    m_bindings.clear();
+    m_binding_offsets.resize(EV_MODE_LAST + 1);
+    for (int eventID = 0; eventID < EV_MODE_LAST; eventID++)
+    {
+        m_binding_offsets[eventID] = m_bindings.size();
+        auto itor = events.find(eventID);
+        if (itor == events.end())
+            continue;
+
+        for (event_trigger_t const& t: itor->second)
         {
+            event_binding_t b;
+            b.eventtype = t.eventtype;
+            b.keyCode = t.keyCode;
+            b.explicite = t.explicite;
+            b.ctrl = t.ctrl;
+            b.shift = t.shift;
+            b.alt = t.alt;
+            b.joystickNumber = t.joystickNumber;
+            b.component = 0;
+            b.joystickPovDirection = t.joystickPovDirection;
+            b.joystickAxisDeadzone = t.joystickAxisDeadzone;
+            b.joystickAxisLinearity = t.joystickAxisLinearity;
+            b.joystickAxisRegion = t.joystickAxisRegion;
+            b.joystickAxisReverse = t.joystickAxisReverse;
+            b.joystickAxisHalf = t.joystickAxisHalf;
+            b.joystickAxisUseDigital = t.joystickAxisUseDigital;
+            b.joystickSliderReverse = t.joystickSliderReverse;
+
+            // Validate against the connected devices once, instead of on every evaluation.
             switch (t.eventtype)
             {
             case ET_NONE:
-                break;
+                continue;
             case ET_Keyboard:
-                if (!keyState[t.keyCode])
-                    break;
-
-                // only use explicite mapping, if two keys with different modifiers exist, i.e. F1 and SHIFT+F1.
-                // check for modificators
-                if (t.explicite)
-                {
-                    if (t.ctrl != (keyState[KC_LCONTROL] || keyState[KC_RCONTROL]))
-                        break;
-                    if (t.shift != (keyState[KC_LSHIFT] || keyState[KC_RSHIFT]))
-                        break;
-                    if (t.alt != (keyState[KC_LMENU] || keyState[KC_RMENU]))
-                        break;
-                }
-                else
-                {
-                    if (t.ctrl && !(keyState[KC_LCONTROL] || keyState[KC_RCONTROL]))
-                        break;
-                    if (t.shift && !(keyState[KC_LSHIFT] || keyState[KC_RSHIFT]))
-                        break;
-                    if (t.alt && !(keyState[KC_LMENU] || keyState[KC_RMENU]))
-                        break;
-                }
-                value = 1;
+                if (t.keyCode < 0 || t.keyCode >= (int)keyState.size())
+                    continue;
+                break;
+            case ET_JoystickButton:
+            case ET_JoystickPov:
+            case ET_JoystickAxisAbs:
+            case ET_JoystickAxisRel:
+            case ET_JoystickSliderX:
+            case ET_JoystickSliderY:
+                if (t.joystickNumber < 0 || t.joystickNumber >= free_joysticks || !mJoy[t.joystickNumber])
+                    continue; // Not connected
                 break;
-            case ET_MouseButton:
-                //if (t.mouseButtonNumber == 0)
-                // TODO: FIXME
-                value = mouseState.buttonDown(MB_Left);
+            default:
                 break;
+            }
+
+            switch (t.eventtype)
+            {
             case ET_JoystickButton:
+                if (t.joystickButtonNumber >= (int)mJoy[t.joystickNumber]->getNumberOfComponents(OIS_Button))
                 {
-                    if (t.joystickNumber > free_joysticks || !mJoy[t.joystickNumber])
-                    {
-                        value = 0;
-                        continue;
-                    }
-                    if (t.joystickButtonNumber >= (int)mJoy[t.joystickNumber]->getNumberOfComponents(OIS_Button))
-                    {
-#ifndef NOOGRE
-                        LOG("*** Joystick has not enough buttons for mapping: need button "+TOSTRING(t.joystickButtonNumber) + ", availabe buttons: "+TOSTRING(mJoy[t.joystickNumber]->getNumberOfComponents(OIS_Button)));
-#endif
-                        value = 0;
-                        continue;
-                    }
-                    value = joyState[t.joystickNumber].mButtons[t.joystickButtonNumber];
+                    LOG("*** Joystick has not enough buttons for mapping: need button "+TOSTRING(t.joystickButtonNumber) + ", availabe buttons: "+TOSTRING(mJoy[t.joystickNumber]->getNumberOfComponents(OIS_Button)));
+                    continue;
                 }
+                b.component = t.joystickButtonNumber;
                 break;
             case ET_JoystickPov:
+                if (t.joystickPovNumber >= (int)mJoy[t.joystickNumber]->getNumberOfComponents(OIS_POV))
                 {
-                    if (t.joystickNumber > free_joysticks || !mJoy[t.joystickNumber])
-                    {
-                        value = 0;
-                        continue;
-                    }
-                    if (t.joystickPovNumber >= (int)mJoy[t.joystickNumber]->getNumberOfComponents(OIS_POV))
-                    {
-#ifndef NOOGRE
-                        LOG("*** Joystick has not enough POVs for mapping: need POV "+TOSTRING(t.joystickPovNumber) + ", availabe POVs: "+TOSTRING(mJoy[t.joystickNumber]->getNumberOfComponents(OIS_POV)));
-#endif
-                        value = 0;
-                        continue;
-                    }
-                    if (joyState[t.joystickNumber].mPOV[t.joystickPovNumber].direction & t.joystickPovDirection)
-                        value = 1;
-                    else
-                        value = 0;
+                    LOG("*** Joystick has not enough POVs for mapping: need POV "+TOSTRING(t.joystickPovNumber) + ", availabe POVs: "+TOSTRING(mJoy[t.joystickNumber]->getNumberOfComponents(OIS_POV)));
+                    continue;
+                }
+                b.component = t.joystickPovNumber;
+                break;
+            case ET_JoystickAxisAbs:
+            case ET_JoystickAxisRel:
+                if (t.joystickAxisNumber >= (int)joyState[t.joystickNumber].mAxes.size())
+                {
+                    LOG("*** Joystick has not enough axis for mapping: need axe "+TOSTRING(t.joystickAxisNumber) + ", availabe axis: "+TOSTRING(joyState[t.joystickNumber].mAxes.size()));
+                    continue;
                 }
+                b.component = t.joystickAxisNumber;
+                break;
+            case ET_JoystickSliderX:
+            case ET_JoystickSliderY:
+                b.component = t.joystickSliderNumber;
+                break;
+            default:
+                break;
+            }
+
+            m_bindings.push_back(b);
+        }
+    }
+    m_binding_offsets[EV_MODE_LAST] = m_bindings.size();
+    m_bindings_dirty = false;
+    m_event_values_dirty = true;
+}
+
+void InputEngine::updateEventValues()
+{
+    if (m_bindings_dirty)
+        this->compileBindings();
+
+    for (int eventID = 0; eventID < EV_MODE_LAST; eventID++)
+    {
+        m_event_values[eventID] = this->evaluateBindings(eventID, /*pure:*/false, InputSourceType::IST_ANY);
+    }
+    m_event_values_dirty = false;
+}
+
+float InputEngine::evaluateBindings(int eventID, bool pure, InputSourceType valueSource)
+{
+    float returnValue = 0;
+    for (size_t i = m_binding_offsets[eventID]; i < m_binding_offsets[eventID + 1]; i++)
+    {
+        // only return if grater zero, otherwise check all other bombinations
+        const float value = this->evaluateBinding(m_bindings[i], pure, valueSource);
+        if (value > returnValue)
+            returnValue = value;
+    }
+    return returnValue;
+}
+
+float InputEngine::evaluateBinding(event_binding_t const& t, bool pure, InputSourceType valueSource)
+{
+    float value = 0;
+    if (valueSource == InputSourceType::IST_DIGITAL || valueSource == InputSourceType::IST_ANY)
+    {
+        switch (t.eventtype)
+        {
+        case ET_Keyboard:
+            if (!keyState[t.keyCode])
                 break;
+
+            // only use explicite mapping, if two keys with different modifiers exist, i.e. F1 and SHIFT+F1.
+            // check for modificators
+            if (t.explicite)
+            {
+                if (t.ctrl != (keyState[KC_LCONTROL] || keyState[KC_RCONTROL]))
+                    break;
+                if (t.shift != (keyState[KC_LSHIFT] || keyState[KC_RSHIFT]))
+                    break;
+                if (t.alt != (keyState[KC_LMENU] || keyState[KC_RMENU]))
+                    break;
             }
+            else
+            {
+                if (t.ctrl && !(keyState[KC_LCONTROL] || keyState[KC_RCONTROL]))
+                    break;
+                if (t.shift && !(keyState[KC_LSHIFT] || keyState[KC_RSHIFT]))
+                    break;
+                if (t.alt && !(keyState[KC_LMENU] || keyState[KC_RMENU]))
+                    break;
+            }
+            value = 1;
+            break;
+        case ET_MouseButton:
+            //if (t.mouseButtonNumber == 0)
+            // TODO: FIXME
+            value = mouseState.buttonDown(MB_Left);
+            break;
+        case ET_JoystickButton:
+            value = joyState[t.joystickNumber].mButtons[t.component];
+            break;
+        case ET_JoystickPov:
+            if (joyState[t.joystickNumber].mPOV[t.component].direction & t.joystickPovDirection)
+                value = 1;
+            else
+                value = 0;
+            break;
+        default:
+            break;
         }
-        if (valueSource == InputSourceType::IST_ANALOG || valueSource == InputSourceType::IST_ANY)
+    }
+    if (valueSource == InputSourceType::IST_ANALOG || valueSource == InputSourceType::IST_ANY)
+    {
+        switch (t.eventtype)
         {
-            switch (t.eventtype)
+        case ET_MouseAxisX:
+            value = mouseState.X.abs / 32767;
+            break;
+        case ET_MouseAxisY:
+            value = mouseState.Y.abs / 32767;
+            break;
+        case ET_MouseAxisZ:
+            value = mouseState.Z.abs / 32767;
+            break;
+
+        case ET_JoystickAxisRel:
+        case ET_JoystickAxisAbs:
             {
-            case ET_MouseAxisX:
-                value = mouseState.X.abs / 32767;
-                break;
-            case ET_MouseAxisY:
-                value = mouseState.Y.abs / 32767;
-                break;
-            case ET_MouseAxisZ:
-                value = mouseState.Z.abs / 32767;
-                break;
+                Axis const& axe = joyState[t.joystickNumber].mAxes[t.component];
 
-            case ET_JoystickAxisRel:
-            case ET_JoystickAxisAbs:
+                if (t.eventtype == ET_JoystickAxisRel)
                 {
-                    if (t.joystickNumber > free_joysticks || !mJoy[t.joystickNumber])
-                    {
-                        value = 0;
-                        continue;
-                    }
-                    if (t.joystickAxisNumber >= (int)joyState[t.joystickNumber].mAxes.size())
+                    value = (float)axe.rel / (float)mJoy[t.joystickNumber]->MAX_AXIS;
+                }
+                else
+                {
+                    value = (float)axe.abs / (float)mJoy[t.joystickNumber]->MAX_AXIS;
+                    switch (t.joystickAxisRegion)
                     {
-#ifndef NOOGRE
-                        LOG("*** Joystick has not enough axis for mapping: need axe "+TOSTRING(t.joystickAxisNumber) + ", availabe axis: "+TOSTRING(joyState[t.joystickNumber].mAxes.size()));
-#endif
-                        value = 0;
-                        continue;
+                    case 0:
+                        // normal case, full axis used
+                        value = (value + 1) / 2;
+                        break;
+                    case -1:
+                        // lower range used
+                        if (value > 0)
+                            value = 0;
+                        else
+                            value = -value;
+                        break;
+                    case 1:
+                        // upper range used
+                        if (value < 0)
+                            value = 0;
+                        break;
                     }
-                    Axis axe = joyState[t.joystickNumber].mAxes[t.joystickAxisNumber];
 
-                    if (t.eventtype == ET_JoystickAxisRel)
+                    if (t.joystickAxisHalf)
                     {
-                        value = (float)axe.rel / (float)mJoy[t.joystickNumber]->MAX_AXIS;
+                        //no dead zone in half axis
+                        value = (1.0 + value) / 2.0;
+                        if (t.joystickAxisReverse)
+                            value = 1.0 - value;
+                        if (!pure)
+                            value = axisLinearity(value, t.joystickAxisLinearity);
                     }
                     else
                     {
-                        value = (float)axe.abs / (float)mJoy[t.joystickNumber]->MAX_AXIS;
-                        switch (t.joystickAxisRegion)
-                        {
-                        case 0:
-                            // normal case, full axis used
-                            value = (value + 1) / 2;
-                            break;
-                        case -1:
-                            // lower range used
-                            if (value > 0)
-                                value = 0;
-                            else
-                                value = -value;
-                            break;
-                        case 1:
-                            // upper range used
-                            if (value < 0)
-                                value = 0;
-                            break;
-                        }
-
-                        if (t.joystickAxisHalf)
-                        {
-                            // XXX: TODO: write this
-                            //float a = (double)((value+1.0)/2.0);
-                            //float b = (double)(1.0-(value+1.0)/2.0);
-                            //LOG("half: "+TOSTRING(value)+" / "+TOSTRING(a)+" / "+TOSTRING(b));
-                            //no dead zone in half axis
-                            value = (1.0 + value) / 2.0;
-                            if (t.joystickAxisReverse)
-                                value = 1.0 - value;
-                            if (!pure)
-                                value = axisLinearity(value, t.joystickAxisLinearity);
-                        }
-                        else
-                        {
-                            //LOG("not half: "+TOSTRING(value)+" / "+TOSTRING(deadZone(value, t.joystickAxisDeadzone)) +" / "+TOSTRING(t.joystickAxisDeadzone) );
-                            if (t.joystickAxisReverse)
-                                value = 1 - value;
-                            if (!pure)
-                            // no deadzone when using oure value
-                                value = deadZone(value, t.joystickAxisDeadzone);
-                            if (!pure)
-                                value = axisLinearity(value, t.joystickAxisLinearity);
-                        }
-                        // digital mapping of analog axis
-                        if (t.joystickAxisUseDigital)
-                            if (value >= 0.5)
-                                value = 1;
-                            else
-                                value = 0;
-                    }
-                }
-                break;
-            case ET_JoystickSliderX:
-            case ET_JoystickSliderY:
-                {
-                    if (t.joystickNumber > free_joysticks || !mJoy[t.joystickNumber])
-                    {
-                        value = 0;
-                        continue;
+                        if (t.joystickAxisReverse)
+                            value = 1 - value;
+                        if (!pure)
+                        // no deadzone when using oure value
+                            value = deadZone(value, t.joystickAxisDeadzone);
+                        if (!pure)
+                            value = axisLinearity(value, t.joystickAxisLinearity);
                     }
-                    if (t.eventtype == ET_JoystickSliderX)
-                        value = (float)joyState[t.joystickNumber].mSliders[t.joystickSliderNumber].abX / (float)mJoy[t.joystickNumber]->MAX_AXIS;
-                    else if (t.eventtype == ET_JoystickSliderY)
-                        value = (float)joyState[t.joystickNumber].mSliders[t.joystickSliderNumber].abY / (float)mJoy[t.joystickNumber]->MAX_AXIS;
-                    value = (value + 1) / 2; // full axis
-                    if (t.joystickSliderReverse)
-                        value = 1.0 - value; // reversed
+                    // digital mapping of analog axis
+                    if (t.joystickAxisUseDigital)
+                        if (value >= 0.5)
+                            value = 1;
+                        else
+                            value = 0;
                 }
-                break;
             }
+            break;
+        case ET_JoystickSliderX:
+        case ET_JoystickSliderY:
+            {
+                if (t.eventtype == ET_JoystickSliderX)
+                    value = (float)joyState[t.joystickNumber].mSliders[t.component].abX / (float)mJoy[t.joystickNumber]->MAX_AXIS;
+                else if (t.eventtype == ET_JoystickSliderY)
+                    value = (float)joyState[t.joystickNumber].mSliders[t.component].abY / (float)mJoy[t.joystickNumber]->MAX_AXIS;
+                value = (value + 1) / 2; // full axis
+                if (t.joystickSliderReverse)
+                    value = 1.0 - value; // reversed
+            }
+            break;
+        default:
+            break;
         }
-        // only return if grater zero, otherwise check all other bombinations
-        if (value > returnValue)
-            returnValue = value;
     }
-    return returnValue;
+    return value;
 }
 
 bool InputEngine::isKeyDown(OIS::KeyCode key)
@@ -1183,7 +1278,7 @@ bool InputEngine::isKeyDown(OIS::KeyCode key)
 
 bool InputEngine::isKeyDownEffective(OIS::KeyCode mod)
 {
-    return this->keyState[mod];
+    return mod < (int)keyState.size() && this->keyState[mod];
 }
 
 bool InputEngine::isKeyDownValueBounce(OIS::KeyCode mod, float time)
@@ -1248,13 +1343,14 @@ void InputEngine::addEvent(int eventID, event_trigger_t& t)
 {
     this->addEvent(eventID);
     events[eventID].push_back(t);
+    m_bindings_dirty = true;
 }
 
 void InputEngine::addEvent(int eventID)
 {
     uniqueCounter++;
 
-    if (eventID == -1)
+    if (eventID < 0 || eventID >= EV_MODE_LAST)
     //unknown event, discard
         return;
     if (events.find(eventID) == events.end())
@@ -1286,6 +1382,7 @@ void InputEngine::updateEvent(int eventID, const event_trigger_t& t)
         events[eventID].clear();
     }
     events[eventID].push_back(t);
+    m_bindings_dirty = true;
 }
 
 void InputEngine::eraseEvent(int eventID, const event_trigger_t* t)
@@ -1298,6 +1395,7 @@ void InputEngine::eraseEvent(int eventID, const event_trigger_t* t)
             if (t == &triggers[i])
             {
                 triggers.erase(triggers.begin() + i);
+                m_bindings_dirty = true;
                 return;
             }
         }
@@ -1310,6 +1408,7 @@ void InputEngine::clearEvents(int eventID)
     {
         events[eventID].clear();
     }
+    m_bindings_dirty = true;
 }
 
 void InputEngine::clearEventsByDevice(int deviceID)
@@ -1328,11 +1427,13 @@ void InputEngine::clearEventsByDevice(int deviceID)
             }
         }
     }
+    m_bindings_dirty = true;
 }
 
 void InputEngine::clearAllEvents()
 {
     events.clear(); // remove all bindings
+    m_bindings_dirty = true;
     this->resetKeysAndMouseButtons(); // reset input states
 }
 
@@ -1750,19 +1851,18 @@ JoyStickState* InputEngine::getCurrentJoyState(int joystickNumber)
 
 int InputEngine::getCurrentKeyCombo(String* combo)
 {
-    std::map<int, bool>::iterator i;
     int keyCounter = 0;
     int modCounter = 0;
 
     // list all modificators first
-    for (i = keyState.begin(); i != keyState.end(); i++)
+    for (int i = 0; i < (int)keyState.size(); i++)
     {
-        if (i->second)
+        if (keyState[i])
         {
-            if (i->first != KC_LSHIFT && i->first != KC_RSHIFT && i->first != KC_LCONTROL && i->first != KC_RCONTROL && i->first != KC_LMENU && i->first != KC_RMENU)
+            if (i != KC_LSHIFT && i != KC_RSHIFT && i != KC_LCONTROL && i != KC_RCONTROL && i != KC_LMENU && i != KC_RMENU)
                 continue;
             modCounter++;
-            String keyName = getKeyNameForKeyCode((OIS::KeyCode)i->first);
+            String keyName = getKeyNameForKeyCode((OIS::KeyCode)i);
             if (*combo == "")
                 *combo = keyName;
             else
@@ -1771,13 +1871,13 @@ int InputEngine::getCurrentKeyCombo(String* combo)
     }
 
     // now list all keys
-    for (i = keyState.begin(); i != keyState.end(); i++)
+    for (int i = 0; i < (int)keyState.size(); i++)
     {
-        if (i->second)
+        if (keyState[i])
         {
-            if (i->first == KC_LSHIFT || i->first == KC_RSHIFT || i->first == KC_LCONTROL || i->first == KC_RCONTROL || i->first == KC_LMENU || i->first == KC_RMENU)
+            if (i == KC_LSHIFT || i == KC_RSHIFT || i == KC_LCONTROL || i == KC_RCONTROL || i == KC_LMENU || i == KC_RMENU)
                 continue;
-            String keyName = getKeyNameForKeyCode((OIS::KeyCode)i->first);
+            String keyName = getKeyNameForKeyCode((OIS::KeyCode)i);
             if (*combo == "")
                 *combo = keyName;
             else
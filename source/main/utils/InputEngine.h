@@ -36,6 +36,8 @@
 #include "OISKeyboard.h"
 #include "OISMouse.h"
 
+#include <array>
+
 #define MAX_JOYSTICKS 10
 #define MAX_JOYSTICK_POVS 4
 #define MAX_JOYSTICK_SLIDERS 4
@@ -456,6 +458,27 @@ struct event_trigger_t
     char comments[1024];
 };
 
+/// The part of `event_trigger_t` needed to evaluate it, see `InputEngine::compileBindings()`
+struct event_binding_t
+{
+    eventtypes eventtype;
+    int keyCode;
+    bool explicite;
+    bool ctrl;
+    bool shift;
+    bool alt;
+    int joystickNumber;
+    int component;                 //!< Button, axis, POV or slider number, by `eventtype`
+    int joystickPovDirection;
+    float joystickAxisDeadzone;
+    float joystickAxisLinearity;
+    int joystickAxisRegion;
+    bool joystickAxisReverse;
+    bool joystickAxisHalf;
+    bool joystickAxisUseDigital;
+    int joystickSliderReverse;
+};
+
 /// Manages controller configuration, evaluates input events
 class InputEngine
 {
@@ -509,7 +532,7 @@ public:
     int                 getJoyComponentCount(OIS::ComponentType type, int joystickNumber);
     std::string         getJoyVendor(int joystickNumber);
     int                 getNumJoysticks() { return free_joysticks; }
-    EventMap&           getEvents() { return events; };
+    EventMap&           getEvents() { m_bindings_dirty = true; return events; }; //!< For editing; the bindings are recompiled on next use.
     /// @}
 
     /// @name Event config files
@@ -583,15 +606,26 @@ protected:
     int uniqueCounter;
 
     // this stores the key/button/axis values
-    std::map<int, bool> keyState;
+    std::array<bool, 256> keyState;
     OIS::JoyStickState joyState[MAX_JOYSTICKS];
     OIS::MouseState mouseState;
 
     // define event aliases
     std::map<int, std::vector<event_trigger_t>> events;
-    std::map<int, float> event_values_simulated;
+    std::array<float, EV_MODE_LAST> event_values_simulated;
     std::map<int, float> event_times;
-    std::map<int, bool> event_states_supressed;
+    std::array<bool, EV_MODE_LAST> event_states_supressed;
+
+    // bindings compiled from `events`, evaluated once per frame
+    std::vector<event_binding_t> m_bindings;          //!< Grouped by event
+    std::vector<size_t> m_binding_offsets;            //!< Event ID -> first binding in `m_bindings`; has EV_MODE_LAST+1 entries
+    std::array<float, EV_MODE_LAST> m_event_values;   //!< Event ID -> `getEventValue()` with default args, minus simulated/supressed states
+    bool m_bindings_dirty = true;
+    bool m_event_values_dirty = true;
+    void compileBindings();
+    void updateEventValues();
+    float evaluateBindings(int eventID, bool pure, InputSourceType valueSource);
+    float evaluateBinding(event_binding_t const& b, bool pure, InputSourceType valueSource);
     std::string m_loaded_configs[MAX_JOYSTICKS];
     bool loadMapping(Ogre::String fileName, int deviceID);
     bool saveMapping(Ogre::String fileName, int deviceID);
@@ -34,6 +34,8 @@
 #else
     #include <sys/types.h>
     #include <sys/stat.h>
+    #include <sys/mman.h> // mmap()
+    #include <fcntl.h> // open()
     #include <unistd.h> // readlink()
 #endif
 
@@ -154,6 +156,60 @@ void OpenUrlInDefaultBrowser(std::string const& url)
     ::ShellExecute(0, 0, url.c_str(), 0, 0 , SW_SHOW );
 }
 
+bool MappedFile::Open(std::string const& path)
+{
+    this->Close();
+
+    std::wstring wpath = MSW_Utf8ToWchar(path.c_str());
+    HANDLE file = CreateFileW(wpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file_handle = file;
+    m_mapping_handle = mapping;
+    m_data = static_cast<const char*>(data);
+    m_size = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data)
+    {
+        UnmapViewOfFile(m_data);
+        CloseHandle(m_mapping_handle);
+        CloseHandle(m_file_handle);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_file_handle = nullptr;
+    m_mapping_handle = nullptr;
+}
+
 #else
 
 // -------------------------- File/path utils for Linux/*nix --------------------------
@@ -202,6 +258,48 @@ void OpenUrlInDefaultBrowser(std::string const& url)
     ::system(buf.c_str());
 }
 
+bool MappedFile::Open(std::string const& path)
+{
+    this->Close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_data = static_cast<const char*>(data);
+    m_size = static_cast<size_t>(st.st_size);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data)
+    {
+        munmap(const_cast<char*>(m_data), m_size);
+        ::close(m_fd);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_fd = -1;
+}
+
 #endif // _MSC_VER
 
 // -------------------------- File/path common utils --------------------------
@@ -55,6 +55,32 @@ std::time_t GetFileLastModifiedTime(std::string const & path);
 
 void OpenUrlInDefaultBrowser(std::string const& url);
 
+/// Read-only memory mapping of a whole file; unmapped on destruction.
+class MappedFile
+{
+public:
+    MappedFile() {}
+    ~MappedFile() { this->Close(); }
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    bool        Open(std::string const& path); //!< Path must be UTF-8 encoded. Returns false (and stays closed) on error or empty file.
+    void        Close();
+    bool        IsOpen() const  { return m_data != nullptr; }
+    const char* GetData() const { return m_data; }
+    size_t      GetSize() const { return m_size; }
+
+private:
+    const char* m_data = nullptr;
+    size_t      m_size = 0;
+#ifdef _MSC_VER
+    void*       m_file_handle = nullptr;
+    void*       m_mapping_handle = nullptr;
+#else
+    int         m_fd = -1;
+#endif
+};
+
 /// @} // addtogroup Application
 
 } // namespace RoR
@@ -0,0 +1,322 @@
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define FLEXBODY_USE_SSE
+#   include <emmintrin.h>
+#endif
+
+// Flexbody deformation (FlexBody::computeFlexbody()):
+//  sol1 = original, scalar per-vertex with AoS locators (each vertex fetches 3 nodes and computes its own basis)
+//  sol2 = locators grouped by ref/nx/ny, SoA, basis once per group, 4 vertices per iteration with SSE
+
+// ---------------------------------------------------------------------------
+// Minimal stand-ins for Ogre::Vector3 and RoR's fast_normalise()
+
+struct Vec3
+{
+    float x, y, z;
+    Vec3() {}
+    Vec3(float _x, float _y, float _z): x(_x), y(_y), z(_z) {}
+    Vec3 operator+(Vec3 const& o) const { return Vec3(x + o.x, y + o.y, z + o.z); }
+    Vec3 operator-(Vec3 const& o) const { return Vec3(x - o.x, y - o.y, z - o.z); }
+    Vec3 operator*(float f) const { return Vec3(x * f, y * f, z * f); }
+    float squaredLength() const { return x*x + y*y + z*z; }
+    Vec3 crossProduct(Vec3 const& o) const { return Vec3(y * o.z - z * o.y, z * o.x - x * o.z, x * o.y - y * o.x); }
+};
+
+inline float fast_invSqrt(const float v)
+{
+    float y = v;
+    int i = 0x5f3759df - ( (*(int *)&y) >>1);
+    y = *(float *)&i;
+
+    y *= (1.5f - (0.5f * v * y * y));
+    return y;
+}
+
+inline Vec3 fast_normalise(Vec3 v)
+{
+    return v*fast_invSqrt(v.squaredLength());
+}
+
+struct Locator_t
+{
+    uint16_t ref, nx, ny;
+    Vec3 coords;
+};
+
+const int NUM_NODES = 400;
+const int NUM_VERTS = 40000;
+
+std::vector<Vec3>      nodes;
+std::vector<Locator_t> locators;
+std::vector<Vec3>      src_normals;
+std::vector<Vec3>      dst_pos(NUM_VERTS);
+std::vector<Vec3>      dst_normals(NUM_VERTS);
+Vec3                   flexit_center(1.f, 2.f, 3.f);
+
+void PrepareData()
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> dist(-2.f, 2.f);
+    for (int i = 0; i < NUM_NODES; i++)
+    {
+        nodes.push_back(Vec3(dist(rng), dist(rng), dist(rng)));
+    }
+    // Like real flexbodies: each node is the ref of a cluster of vertices, mostly with the same nx/ny
+    std::uniform_int_distribution<int> node_dist(0, NUM_NODES - 3);
+    std::uniform_int_distribution<int> variant_dist(0, 3);
+    for (int i = 0; i < NUM_VERTS; i++)
+    {
+        Locator_t loc;
+        loc.ref = (uint16_t)node_dist(rng);
+        loc.nx = (uint16_t)(loc.ref + 1);
+        loc.ny = (uint16_t)(loc.ref + 2 + (variant_dist(rng) == 0));
+        loc.coords = Vec3(dist(rng), dist(rng), dist(rng));
+        locators.push_back(loc);
+        src_normals.push_back(fast_normalise(Vec3(dist(rng), dist(rng), dist(rng))));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// sol1: original
+
+static void Bench_sol1__ScalarAoS(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        for (int i=0; i<NUM_VERTS; i++)
+        {
+            Vec3 diffX = nodes[locators[i].nx] - nodes[locators[i].ref];
+            Vec3 diffY = nodes[locators[i].ny] - nodes[locators[i].ref];
+            Vec3 nCross = fast_normalise(diffX.crossProduct(diffY));
+
+            dst_pos[i].x = diffX.x * locators[i].coords.x + diffY.x * locators[i].coords.y + nCross.x * locators[i].coords.z;
+            dst_pos[i].y = diffX.y * locators[i].coords.x + diffY.y * locators[i].coords.y + nCross.y * locators[i].coords.z;
+            dst_pos[i].z = diffX.z * locators[i].coords.x + diffY.z * locators[i].coords.y + nCross.z * locators[i].coords.z;
+
+            dst_pos[i] = dst_pos[i] + nodes[locators[i].ref] - flexit_center;
+
+            dst_normals[i].x = diffX.x * src_normals[i].x + diffY.x * src_normals[i].y + nCross.x * src_normals[i].z;
+            dst_normals[i].y = diffX.y * src_normals[i].x + diffY.y * src_normals[i].y + nCross.y * src_normals[i].z;
+            dst_normals[i].z = diffX.z * src_normals[i].x + diffY.z * src_normals[i].y + nCross.z * src_normals[i].z;
+
+            dst_normals[i] = fast_normalise(dst_normals[i]);
+        }
+        benchmark::DoNotOptimize(dst_pos.data());
+        benchmark::DoNotOptimize(dst_normals.data());
+    }
+}
+BENCHMARK(Bench_sol1__ScalarAoS);
+
+// ---------------------------------------------------------------------------
+// sol2: grouped SoA (see FlexBody::buildLocatorGroups())
+
+struct LocatorGroup
+{
+    uint16_t ref, nx, ny;
+    uint32_t soa_start, count;
+};
+
+std::vector<LocatorGroup> groups;
+std::vector<float>        soa_coords[3];
+std::vector<float>        soa_normals[3];
+std::vector<uint32_t>     soa_vert_index;
+
+void PrepareBench_sol2()
+{
+    std::vector<uint32_t> order(NUM_VERTS);
+    for (uint32_t i = 0; i < NUM_VERTS; i++) { order[i] = i; }
+    std::stable_sort(order.begin(), order.end(), [](uint32_t a, uint32_t b)
+        {
+            if (locators[a].ref != locators[b].ref) { return locators[a].ref < locators[b].ref; }
+            if (locators[a].nx != locators[b].nx)   { return locators[a].nx < locators[b].nx; }
+            return locators[a].ny < locators[b].ny;
+        });
+
+    for (uint32_t vert: order)
+    {
+        Locator_t const& loc = locators[vert];
+        if (groups.empty() || groups.back().ref != loc.ref || groups.back().nx != loc.nx || groups.back().ny != loc.ny)
+        {
+            LocatorGroup g = { loc.ref, loc.nx, loc.ny, 0, 0 };
+            g.soa_start = (groups.empty()) ? 0 : groups.back().soa_start + ((groups.back().count + 3) & ~3u);
+            groups.push_back(g);
+        }
+        groups.back().count++;
+    }
+
+    const size_t soa_size = groups.back().soa_start + ((groups.back().count + 3) & ~3u);
+    for (int i = 0; i < 3; i++)
+    {
+        soa_coords[i].assign(soa_size, 0.f);
+        soa_normals[i].assign(soa_size, 0.f);
+    }
+    soa_vert_index.assign(soa_size, 0);
+
+    size_t pos = 0;
+    for (LocatorGroup const& g: groups)
+    {
+        for (uint32_t i = 0; i < g.count; i++)
+        {
+            const uint32_t vert = order[pos++];
+            const uint32_t s = g.soa_start + i;
+            soa_coords[0][s] = locators[vert].coords.x;
+            soa_coords[1][s] = locators[vert].coords.y;
+            soa_coords[2][s] = locators[vert].coords.z;
+            soa_normals[0][s] = src_normals[vert].x;
+            soa_normals[1][s] = src_normals[vert].y;
+            soa_normals[2][s] = src_normals[vert].z;
+            soa_vert_index[s] = vert;
+        }
+    }
+    std::cout << "sol2: " << NUM_VERTS << " vertices in " << groups.size() << " locator groups" << std::endl;
+}
+
+#ifdef FLEXBODY_USE_SSE
+void ComputeLocatorGroup(
+    Vec3 const& diffX, Vec3 const& diffY, Vec3 const& nCross, Vec3 const& origin,
+    const float* cx, const float* cy, const float* cz,
+    const float* snx, const float* sny, const float* snz,
+    const uint32_t* vert_index, uint32_t count, Vec3* out_pos, Vec3* out_normals)
+{
+    const __m128 dx_x = _mm_set1_ps(diffX.x),  dx_y = _mm_set1_ps(diffX.y),  dx_z = _mm_set1_ps(diffX.z);
+    const __m128 dy_x = _mm_set1_ps(diffY.x),  dy_y = _mm_set1_ps(diffY.y),  dy_z = _mm_set1_ps(diffY.z);
+    const __m128 nc_x = _mm_set1_ps(nCross.x), nc_y = _mm_set1_ps(nCross.y), nc_z = _mm_set1_ps(nCross.z);
+    const __m128 or_x = _mm_set1_ps(origin.x), or_y = _mm_set1_ps(origin.y), or_z = _mm_set1_ps(origin.z);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 three_halves = _mm_set1_ps(1.5f);
+    const __m128 min_len2 = _mm_set1_ps(FLT_MIN);
+
+    for (uint32_t i = 0; i < count; i += 4)
+    {
+        __m128 c_x = _mm_loadu_ps(cx + i), c_y = _mm_loadu_ps(cy + i), c_z = _mm_loadu_ps(cz + i);
+        __m128 p_x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx_x, c_x), _mm_mul_ps(dy_x, c_y)), _mm_add_ps(_mm_mul_ps(nc_x, c_z), or_x));
+        __m128 p_y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx_y, c_x), _mm_mul_ps(dy_y, c_y)), _mm_add_ps(_mm_mul_ps(nc_y, c_z), or_y));
+        __m128 p_z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx_z, c_x), _mm_mul_ps(dy_z, c_y)), _mm_add_ps(_mm_mul_ps(nc_z, c_z), or_z));
+
+        __m128 s_x = _mm_loadu_ps(snx + i), s_y = _mm_loadu_ps(sny + i), s_z = _mm_loadu_ps(snz + i);
+        __m128 n_x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx_x, s_x), _mm_mul_ps(dy_x, s_y)), _mm_mul_ps(nc_x, s_z));
+        __m128 n_y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx_y, s_x), _mm_mul_ps(dy_y, s_y)), _mm_mul_ps(nc_y, s_z));
+        __m128 n_z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx_z, s_x), _mm_mul_ps(dy_z, s_y)), _mm_mul_ps(nc_z, s_z));
+
+        __m128 len2 = _mm_max_ps(min_len2, _mm_add_ps(_mm_add_ps(_mm_mul_ps(n_x, n_x), _mm_mul_ps(n_y, n_y)), _mm_mul_ps(n_z, n_z)));
+        __m128 inv = _mm_rsqrt_ps(len2);
+        inv = _mm_mul_ps(inv, _mm_sub_ps(three_halves, _mm_mul_ps(_mm_mul_ps(half, len2), _mm_mul_ps(inv, inv))));
+        n_x = _mm_mul_ps(n_x, inv);
+        n_y = _mm_mul_ps(n_y, inv);
+        n_z = _mm_mul_ps(n_z, inv);
+
+        __m128 p_w = _mm_setzero_ps();
+        __m128 n_w = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(p_x, p_y, p_z, p_w);
+        _MM_TRANSPOSE4_PS(n_x, n_y, n_z, n_w);
+        float pos[4][4];
+        float nrm[4][4];
+        _mm_storeu_ps(pos[0], p_x); _mm_storeu_ps(pos[1], p_y); _mm_storeu_ps(pos[2], p_z); _mm_storeu_ps(pos[3], p_w);
+        _mm_storeu_ps(nrm[0], n_x); _mm_storeu_ps(nrm[1], n_y); _mm_storeu_ps(nrm[2], n_z); _mm_storeu_ps(nrm[3], n_w);
+
+        const uint32_t num_lanes = std::min(4u, count - i);
+        for (uint32_t lane = 0; lane < num_lanes; ++lane)
+        {
+            const uint32_t vert = vert_index[i + lane];
+            out_pos[vert] = Vec3(pos[lane][0], pos[lane][1], pos[lane][2]);
+            out_normals[vert] = Vec3(nrm[lane][0], nrm[lane][1], nrm[lane][2]);
+        }
+    }
+}
+#else
+void ComputeLocatorGroup(
+    Vec3 const& diffX, Vec3 const& diffY, Vec3 const& nCross, Vec3 const& origin,
+    const float* cx, const float* cy, const float* cz,
+    const float* snx, const float* sny, const float* snz,
+    const uint32_t* vert_index, uint32_t count, Vec3* out_pos, Vec3* out_normals)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const uint32_t vert = vert_index[i];
+        out_pos[vert] = diffX * cx[i] + diffY * cy[i] + nCross * cz[i] + origin;
+        out_normals[vert] = fast_normalise(diffX * snx[i] + diffY * sny[i] + nCross * snz[i]);
+    }
+}
+#endif
+
+void ComputeGrouped(Vec3* out_pos, Vec3* out_normals)
+{
+    for (LocatorGroup const& g: groups)
+    {
+        const Vec3 ref_pos = nodes[g.ref];
+        const Vec3 diffX = nodes[g.nx] - ref_pos;
+        const Vec3 diffY = nodes[g.ny] - ref_pos;
+        const Vec3 nCross = fast_normalise(diffX.crossProduct(diffY));
+        const uint32_t s = g.soa_start;
+
+        ComputeLocatorGroup(diffX, diffY, nCross, ref_pos - flexit_center,
+            &soa_coords[0][s], &soa_coords[1][s], &soa_coords[2][s],
+            &soa_normals[0][s], &soa_normals[1][s], &soa_normals[2][s],
+            &soa_vert_index[s], g.count, out_pos, out_normals);
+    }
+}
+
+static void Bench_sol2__GroupedSoA(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        ComputeGrouped(dst_pos.data(), dst_normals.data());
+        benchmark::DoNotOptimize(dst_pos.data());
+        benchmark::DoNotOptimize(dst_normals.data());
+    }
+}
+BENCHMARK(Bench_sol2__GroupedSoA);
+
+// ---------------------------------------------------------------------------
+
+void VerifyResults()
+{
+    // Run sol1 once, keep results, compare with sol2
+    std::vector<Vec3> ref_pos(NUM_VERTS), ref_normals(NUM_VERTS);
+    for (int i=0; i<NUM_VERTS; i++)
+    {
+        Vec3 diffX = nodes[locators[i].nx] - nodes[locators[i].ref];
+        Vec3 diffY = nodes[locators[i].ny] - nodes[locators[i].ref];
+        Vec3 nCross = fast_normalise(diffX.crossProduct(diffY));
+        ref_pos[i] = diffX * locators[i].coords.x + diffY * locators[i].coords.y + nCross * locators[i].coords.z
+                   + nodes[locators[i].ref] - flexit_center;
+        ref_normals[i] = fast_normalise(diffX * src_normals[i].x + diffY * src_normals[i].y + nCross * src_normals[i].z);
+    }
+
+    ComputeGrouped(dst_pos.data(), dst_normals.data());
+    float max_err = 0.f;
+    for (int i=0; i<NUM_VERTS; i++)
+    {
+        max_err = std::max(max_err, std::sqrt((dst_pos[i] - ref_pos[i]).squaredLength()));
+        max_err = std::max(max_err, std::sqrt((dst_normals[i] - ref_normals[i]).squaredLength()));
+    }
+    std::cout << "sol2: max difference from sol1: " << max_err << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    using namespace std;
+
+    // prepare
+    cout << "Preparing..." << endl;
+    PrepareData();
+    PrepareBench_sol2();
+    VerifyResults();
+
+    // benchmark
+    ::benchmark::Initialize(&argc, argv);
+    ::benchmark::RunSpecifiedBenchmarks();
+#ifdef _MSC_VER
+    system("pause");
+#endif
+    return 0;
+}
@@ -0,0 +1,1339 @@
+#include "benchmark/benchmark.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctype.h>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// GenericDocument tokenizer (GenericDocument::loadFromDataStream()):
+//  sol1 = original, each byte fed to `DocumentParser::ProcessChar()`, token and string pool vectors grow on demand
+//  sol2 = `DocumentParser::ProcessBuffer()` - runs of characters which only extend the current token (comments, strings,
+//         keywords, digits) are found with memchr()/tight loops and appended at once; vectors reserved from the file size.
+//
+// Pass real files on the command line to use them as corpus,
+// i.e. `Bench_GenericDocument_Tokenize --benchmark_filter=Corpus resources/gadgets/*.gadget *.tuneup *.addonpart`
+// Without files, the example document below is used.
+
+// ---------------------------------------------------------------------------
+// Minimal stand-ins for RoR/Ogre - warnings are discarded, numbers converted with the C library.
+
+typedef uint32_t BitMask_t;
+#define BITMASK( OFFSET )           ( 1  << ((OFFSET) - 1) )
+
+namespace fmt {
+template<typename... ARGS> std::string format(const char*, ARGS...) { return std::string(); }
+}
+
+namespace Ogre {
+struct StringConverter
+{
+    static int parseInt(const char* s) { return (int)strtol(s, nullptr, 10); }
+    static float parseReal(const char* s) { return strtof(s, nullptr); }
+};
+}
+
+struct Console
+{
+    enum { CONSOLE_MSGTYPE_INFO, CONSOLE_SYSTEM_WARNING };
+    void putMessage(int, int, std::string const&) {}
+};
+
+namespace App {
+inline Console* GetConsole() { static Console console; return &console; }
+}
+
+namespace RoR {
+
+enum class TokenType
+{
+    NONE,
+    LINEBREAK,
+    COMMENT,
+    STRING,
+    FLOAT,
+    INT,
+    BOOL,
+    KEYWORD,
+};
+
+struct Token
+{
+    TokenType type;
+    float     data;
+};
+
+struct GenericDocument
+{
+    static const BitMask_t OPTION_ALLOW_NAKED_STRINGS = BITMASK(1);
+    static const BitMask_t OPTION_ALLOW_SLASH_COMMENTS = BITMASK(2);
+    static const BitMask_t OPTION_FIRST_LINE_IS_TITLE = BITMASK(3);
+    static const BitMask_t OPTION_ALLOW_SEPARATOR_COLON = BITMASK(4);
+    static const BitMask_t OPTION_PARENTHESES_CAPTURE_SPACES = BITMASK(5);
+    static const BitMask_t OPTION_ALLOW_BRACED_KEYWORDS = BITMASK(6);
+    static const BitMask_t OPTION_ALLOW_SEPARATOR_EQUALS = BITMASK(7);
+    static const BitMask_t OPTION_ALLOW_HASH_COMMENTS = BITMASK(8);
+
+    std::vector<char> string_pool;
+    std::vector<Token> tokens;
+
+    void reserveForTextSize(size_t text_size);
+};
+
+} // namespace RoR
+
+using namespace RoR;
+
+// ---------------------------------------------------------------------------
+// Copy of the tokenizer from 'GenericFileFormat.cpp'
+
+enum class PartialToken
+{
+    NONE,
+    COMMENT_SEMICOLON,             // Comment starting with ';'
+    COMMENT_SLASH,                 // Comment starting with '//'
+    COMMENT_HASH,
+    STRING_QUOTED,                 // String starting/ending with '"'
+    STRING_NAKED,                  // String without '"' on either end
+    STRING_NAKED_CAPTURING_SPACES, // Only for OPTION_PARENTHESES_CAPTURE_SPACES - A naked string seeking the closing ')'.
+    TITLE_STRING,                  // A whole-line string, with spaces
+    NUMBER_STUB_MINUS,             // Sole '-' character, may start a number or a naked string.
+    NUMBER_INTEGER,                // Just digits and optionally leading '-'
+    NUMBER_DECIMAL,                // Like INTEGER but already containing '.'
+    NUMBER_SCIENTIFIC_STUB,        // Like DECIMAL, already containing 'e' or 'E' but not the exponent value.
+    NUMBER_SCIENTIFIC_STUB_MINUS,  // Like SCIENTIFIC_STUB but with only '-' in exponent. 
+    NUMBER_SCIENTIFIC,             // Valid decimal number in scientific notation.
+    KEYWORD,                       // Unqoted string at the start of line. Accepted characters: alphanumeric and underscore
+    KEYWORD_BRACED,                // Like KEYWORD but starting with '[' and ending with ']'
+    BOOL_TRUE,                     // Partial 'true'
+    BOOL_FALSE,                    // Partial 'false'
+    GARBAGE,                       // Text not fitting any above category, will be discarded
+};
+
+struct DocumentParser
+{
+    DocumentParser(GenericDocument& d, const BitMask_t opt, std::string const& name)
+        : doc(d), options(opt), doc_name(name) {}
+
+    // Config
+    GenericDocument& doc;
+    const BitMask_t options;
+    const std::string doc_name; // For messages only
+
+    // State
+    std::vector<char> tok;
+    size_t line_num = 0;
+    size_t line_pos = 0;
+    PartialToken partial_tok_type = PartialToken::NONE;
+    bool title_found = false; // Only for OPTION_FIRST_LINE_IS_TITLE
+
+    void ProcessBuffer(const char* buf, const size_t len);
+    void ProcessChar(const char c);
+    void ProcessEOF();
+    void ProcessSeparatorWithinBool();
+
+    void BeginToken(const char c);
+    void UpdateComment(const char c);
+    void UpdateString(const char c);
+    void UpdateNumber(const char c);
+    void UpdateBool(const char c);
+    void UpdateKeyword(const char c);
+    void UpdateTitle(const char c); // Only for OPTION_FIRST_LINE_IS_TITLE
+    void UpdateGarbage(const char c);
+
+    void DiscontinueBool();
+    void DiscontinueNumber();
+    void DiscontinueKeyword();
+    void FlushStringishToken(RoR::TokenType type);
+    void FlushNumericToken();
+
+    const char* FindSpanEnd(const char* pos, const char* end) const;
+};
+
+void DocumentParser::BeginToken(const char c)
+{
+    switch (c)
+    {
+    case '\r':
+        break;
+
+    case ' ':
+    case ',':
+    case '\t':
+        line_pos++;
+        break;
+
+    case ':':
+        if (options & GenericDocument::OPTION_ALLOW_SEPARATOR_COLON)
+        {
+            line_pos++;
+        }
+        else
+        {
+            if (options & GenericDocument::OPTION_ALLOW_NAKED_STRINGS)
+                partial_tok_type = PartialToken::STRING_NAKED;
+            else
+                partial_tok_type = PartialToken::GARBAGE;
+            tok.push_back(c);
+            line_pos++;
+        }
+        break;
+
+    case '=':
+        if (options & GenericDocument::OPTION_ALLOW_SEPARATOR_EQUALS)
+        {
+            line_pos++;
+        }
+        else
+        {
+            if (options & GenericDocument::OPTION_ALLOW_NAKED_STRINGS)
+                partial_tok_type = PartialToken::STRING_NAKED;
+            else
+                partial_tok_type = PartialToken::GARBAGE;
+            tok.push_back(c);
+            line_pos++;
+        }
+        break;
+
+    case '\n':
+        doc.tokens.push_back({ TokenType::LINEBREAK, 0.f });
+        line_num++;
+        line_pos = 0;
+        break;
+
+    case ';':
+        partial_tok_type = PartialToken::COMMENT_SEMICOLON;
+        line_pos++;
+        break;
+
+    case '/':
+        if (options & GenericDocument::OPTION_ALLOW_SLASH_COMMENTS)
+        {
+            partial_tok_type = PartialToken::COMMENT_SLASH;
+        }
+        else
+        {
+            if (options & GenericDocument::OPTION_ALLOW_NAKED_STRINGS)
+                partial_tok_type = PartialToken::STRING_NAKED;
+            else
+                partial_tok_type = PartialToken::GARBAGE;
+            tok.push_back(c);
+        }
+        line_pos++;
+        break;
+
+    case '#':
+        if (options & GenericDocument::OPTION_ALLOW_HASH_COMMENTS)
+        {
+            partial_tok_type = PartialToken::COMMENT_HASH;
+        }
+        else
+        {
+            if (options & GenericDocument::OPTION_ALLOW_NAKED_STRINGS)
+                partial_tok_type = PartialToken::STRING_NAKED;
+            else
+                partial_tok_type = PartialToken::GARBAGE;
+            tok.push_back(c);
+        }
+        line_pos++;
+        break;
+
+    case '[':
+        if (options & GenericDocument::OPTION_ALLOW_BRACED_KEYWORDS)
+        {
+            partial_tok_type = PartialToken::KEYWORD_BRACED;
+        }
+        else
+        {
+            if (options & GenericDocument::OPTION_ALLOW_NAKED_STRINGS)
+                partial_tok_type = PartialToken::STRING_NAKED;
+            else
+                partial_tok_type = PartialToken::GARBAGE;
+        }
+        tok.push_back(c);
+        line_pos++;
+        break;
+
+    case '"':
+        partial_tok_type = PartialToken::STRING_QUOTED;
+        line_pos++;
+        break;
+
+    case '.':
+        tok.push_back(c);
+        partial_tok_type = PartialToken::NUMBER_DECIMAL;
+        line_pos++;
+        break;
+
+    case 't':
+        tok.push_back(c);
+        partial_tok_type = PartialToken::BOOL_TRUE;
+        line_pos++;
+        break;
+
+    case 'f':
+        tok.push_back(c);
+        partial_tok_type = PartialToken::BOOL_FALSE;
+        line_pos++;
+        break;
+
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+        partial_tok_type = PartialToken::NUMBER_INTEGER;
+        tok.push_back(c);
+        line_pos++;
+        break;
+
+    case '-':
+        partial_tok_type = PartialToken::NUMBER_STUB_MINUS;
+        tok.push_back(c);
+        line_pos++;
+        break;
+
+    default:
+        if (isalpha(c) &&
+            (doc.tokens.size() == 0 || doc.tokens.back().type == TokenType::LINEBREAK)) // on line start?
+        {
+            tok.push_back(c);
+            partial_tok_type = PartialToken::KEYWORD;
+        }
+        else if (options & GenericDocument::OPTION_ALLOW_NAKED_STRINGS)
+        {
+            tok.push_back(c);
+            partial_tok_type = PartialToken::STRING_NAKED;
+        }
+        else
+        {
+            partial_tok_type = PartialToken::GARBAGE;
+            tok.push_back(c);
+        }
+        line_pos++;
+        break;
+    }
+
+    if (options & GenericDocument::OPTION_FIRST_LINE_IS_TITLE
+        && !title_found
+        && (doc.tokens.size() == 0 || doc.tokens.back().type == TokenType::LINEBREAK)
+        && partial_tok_type != PartialToken::NONE
+        && partial_tok_type != PartialToken::COMMENT_SEMICOLON
+        && partial_tok_type != PartialToken::COMMENT_SLASH)
+    {
+        title_found = true;
+        partial_tok_type = PartialToken::TITLE_STRING;
+    }
+
+    if (partial_tok_type == PartialToken::GARBAGE)
+    {
+        App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_WARNING,
+            fmt::format("{}, line {}, pos {}: stray character '{}'", doc_name, line_num, line_pos, c));
+    }
+}
+
+void DocumentParser::UpdateComment(const char c)
+{
+    switch (c)
+    {
+    case '\r':
+        break;
+
+    case '\n':
+        this->FlushStringishToken(TokenType::COMMENT);
+        // Break line
+        doc.tokens.push_back({ TokenType::LINEBREAK, 0.f });
+        line_num++;
+        line_pos = 0;
+        break;
+
+    case '/':
+        if (partial_tok_type != PartialToken::COMMENT_SLASH || tok.size() > 0) // With COMMENT_SLASH, skip any number of leading '/'
+        {
+            tok.push_back(c);
+        }
+        line_pos++;
+        break;
+
+    default:
+        tok.push_back(c);
+        line_pos++;
+        break;
+    }
+}
+
+void DocumentParser::UpdateString(const char c)
+{
+    switch (c)
+    {
+    case '\r':
+        break;
+
+    case ' ':
+        if (partial_tok_type == PartialToken::STRING_QUOTED
+            || partial_tok_type == PartialToken::STRING_NAKED_CAPTURING_SPACES)
+        {
+            tok.push_back(c);
+        }
+        else // (partial_tok_type == PartialToken::STRING_NAKED)
+        {
+            this->FlushStringishToken(TokenType::STRING);
+        }
+        line_pos++;
+        break;
+
+    case ',':
+    case '\t':
+        if (partial_tok_type == PartialToken::STRING_QUOTED)
+        {
+            tok.push_back(c);
+        }
+        else // (partial_tok_type == PartialToken::STRING_NAKED)
+        {
+            this->FlushStringishToken(TokenType::STRING);
+        }
+        line_pos++;
+        break;
+
+    case '\n':
+        if (partial_tok_type == PartialToken::STRING_QUOTED)
+        {
+            App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_WARNING,
+                fmt::format("{}, line {}, pos {}: quoted string interrupted by newline", doc_name, line_num, line_pos));
+        }
+        this->FlushStringishToken(TokenType::STRING);
+        // Break line
+        doc.tokens.push_back({ TokenType::LINEBREAK, 0.f });
+        line_num++;
+        line_pos = 0;
+        break;
+
+    case ':':
+        if (options & GenericDocument::OPTION_ALLOW_SEPARATOR_COLON
+            && (partial_tok_type == PartialToken::STRING_NAKED || partial_tok_type == PartialToken::STRING_NAKED_CAPTURING_SPACES))
+        {
+            this->FlushStringishToken(TokenType::STRING);
+        }
+        else
+        {
+            tok.push_back(c);
+        }
+        line_pos++;
+        break;
+
+    case '=':
+        if (options & GenericDocument::OPTION_ALLOW_SEPARATOR_EQUALS
+            && (partial_tok_type == PartialToken::STRING_NAKED || partial_tok_type == PartialToken::STRING_NAKED_CAPTURING_SPACES))
+        {
+            this->FlushStringishToken(TokenType::STRING);
+        }
+        else
+        {
+            tok.push_back(c);
+        }
+        line_pos++;
+        break;
+
+    case '"':
+        if (partial_tok_type == PartialToken::STRING_QUOTED)
+        {
+            this->FlushStringishToken(TokenType::STRING);
+        }
+        else // (partial_tok_type == PartialToken::STRING_NAKED)
+        {
+            partial_tok_type = PartialToken::GARBAGE;
+            tok.push_back(c);
+        }
+        line_pos++;
+        break;
+
+    case '(':
+        if (partial_tok_type == PartialToken::STRING_NAKED
+            && options & GenericDocument::OPTION_PARENTHESES_CAPTURE_SPACES)
+        {
+            partial_tok_type = PartialToken::STRING_NAKED_CAPTURING_SPACES;
+        }
+        tok.push_back(c);
+        line_pos++;
+        break;
+
+    case ')':
+        if (partial_tok_type == PartialToken::STRING_NAKED_CAPTURING_SPACES)
+        {
+            partial_tok_type = PartialToken::STRING_NAKED;
+        }
+        tok.push_back(c);
+        line_pos++;
+        break;
+
+    default:
+        tok.push_back(c);
+        line_pos++;
+        break;
+    }
+
+    if (partial_tok_type == PartialToken::GARBAGE)
+    {
+        App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_WARNING,
+            fmt::format("{}, line {}, pos {}: stray character '{}' in string", doc_name, line_num, line_pos, c));
+    }
+}
+
+void DocumentParser::UpdateNumber(const char c)
+{
+    switch (c)
+    {
+    case '\r':
+        break;
+
+    case ' ':
+    case ',':
+    case '\t':
+        if (partial_tok_type == PartialToken::NUMBER_STUB_MINUS 
+            && options & GenericDocument::OPTION_ALLOW_NAKED_STRINGS)
+        {
+            this->FlushStringishToken(TokenType::STRING);
+        }
+        else
+        {
+            this->FlushNumericToken();
+        }
+        line_pos++;
+        break;
+
+    case '\n':
+        if (partial_tok_type == PartialToken::NUMBER_STUB_MINUS 
+            && options & GenericDocument::OPTION_ALLOW_NAKED_STRINGS)
+        {
+            this->FlushStringishToken(TokenType::STRING);
+        }
+        else
+        {
+            this->FlushNumericToken();
+        }
+        // Break line
+        doc.tokens.push_back({ TokenType::LINEBREAK, 0.f });
+        line_num++;
+        line_pos = 0;
+        break;
+
+    case ':':
+        if (options & GenericDocument::OPTION_ALLOW_SEPARATOR_COLON)
+        {
+            if (partial_tok_type == PartialToken::NUMBER_STUB_MINUS 
+                && options & GenericDocument::OPTION_ALLOW_NAKED_STRINGS)
+            {
+                this->FlushStringishToken(TokenType::STRING);
+            }
+            else
+            {
+                this->FlushNumericToken();
+            }
+        }
+        else
+        {
+            this->DiscontinueNumber();
+            tok.push_back(c);
+        }
+        line_pos++;
+        break;
+
+    case '=':
+        if (options & GenericDocument::OPTION_ALLOW_SEPARATOR_EQUALS)
+        {
+            if (partial_tok_type == PartialToken::NUMBER_STUB_MINUS 
+                && options & GenericDocument::OPTION_ALLOW_NAKED_STRINGS)
+            {
+                this->FlushStringishToken(TokenType::STRING);
+            }
+            else
+            {
+                this->FlushNumericToken();
+            }
+        }
+        else
+        {
+            this->DiscontinueNumber();
+            tok.push_back(c);
+        }
+        line_pos++;
+        break;
+
+    case '.':
+        if (partial_tok_type == PartialToken::NUMBER_INTEGER
+            || partial_tok_type == PartialToken::NUMBER_STUB_MINUS)
+        {
+            partial_tok_type = PartialToken::NUMBER_DECIMAL;
+        }
+        else
+        {
+            this->DiscontinueNumber();
+        }
+        tok.push_back(c);
+        line_pos++;
+        break;
+
+    case 'e':
+    case 'E':
+        if (partial_tok_type == PartialToken::NUMBER_DECIMAL
+            || partial_tok_type == PartialToken::NUMBER_INTEGER)
+        {
+            partial_tok_type = PartialToken::NUMBER_SCIENTIFIC_STUB;
+        }
+        else
+        {
+            this->DiscontinueNumber();
+        }
+        tok.push_back(c);
+        line_pos++;
+        break;
+
+    case '-':
+        if (partial_tok_type == PartialToken::NUMBER_SCIENTIFIC_STUB)
+        {
+            partial_tok_type = PartialToken::NUMBER_SCIENTIFIC_STUB_MINUS;
+        }
+        else
+        {
+            this->DiscontinueNumber();
+        }
+        tok.push_back(c);
+        line_pos++;
+        break;
+
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+        if (partial_tok_type == PartialToken::NUMBER_SCIENTIFIC_STUB
+            || partial_tok_type == PartialToken::NUMBER_SCIENTIFIC_STUB_MINUS)
+        {
+            partial_tok_type = PartialToken::NUMBER_SCIENTIFIC;
+        }
+        else if (partial_tok_type == PartialToken::NUMBER_STUB_MINUS)
+        {
+            partial_tok_type = PartialToken::NUMBER_INTEGER;
+        }
+        tok.push_back(c);
+        line_pos++;
+        break;
+
+    default:
+        this->DiscontinueNumber();
+        tok.push_back(c);
+        line_pos++;
+        break;
+
+    }
+
+    if (partial_tok_type == PartialToken::GARBAGE)
+    {
+        App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_WARNING,
+            fmt::format("{}, line {}, pos {}: stray character '{}' in number", doc_name, line_num, line_pos, c));
+    }
+}
+
+void DocumentParser::ProcessSeparatorWithinBool()
+{
+    this->DiscontinueBool();
+    switch (partial_tok_type)
+    {
+        case PartialToken::KEYWORD:
+            this->FlushStringishToken(TokenType::KEYWORD);
+            break;
+        case PartialToken::STRING_NAKED:
+            this->FlushStringishToken(TokenType::STRING);
+            break;
+        default:
+            // Discard token
+            tok.push_back('\0');
+            App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_WARNING,
+                fmt::format("{}, line {}, pos {}: discarding incomplete boolean token '{}'", doc_name, line_num, line_pos, tok.data()));
+            tok.clear();
+            partial_tok_type = PartialToken::NONE;
+            break;
+    }
+}
+
+void DocumentParser::UpdateBool(const char c)
+{
+    switch (c)
+    {
+    case '\r':
+        break;
+
+    case ' ':
+    case ',':
+    case '\t':
+        this->ProcessSeparatorWithinBool();
+        line_pos++;
+        break;
+
+    case '\n':
+        this->ProcessSeparatorWithinBool();
+        // Break line
+        doc.tokens.push_back({ TokenType::LINEBREAK, 0.f });
+        line_num++;
+        line_pos = 0;
+        break;
+
+    case ':':
+        if (options & GenericDocument::OPTION_ALLOW_SEPARATOR_COLON)
+        {
+            this->ProcessSeparatorWithinBool();
+        }
+        else
+        {
+            this->DiscontinueBool();
+            tok.push_back(c);
+        }
+        line_pos++;
+        break;
+
+    case '=':
+        if (options & GenericDocument::OPTION_ALLOW_SEPARATOR_EQUALS)
+        {
+            this->ProcessSeparatorWithinBool();
+        }
+        else
+        {
+            this->DiscontinueBool();
+            tok.push_back(c);
+        }
+        line_pos++;
+        break;
+
+    case 'r':
+        if (partial_tok_type != PartialToken::BOOL_TRUE || tok.size() != 1)
+        {
+            this->DiscontinueBool();
+        }
+        tok.push_back(c);
+        line_pos++;
+        break;
+
+    case 'u':
+        if (partial_tok_type != PartialToken::BOOL_TRUE || tok.size() != 2)
+        {
+            this->DiscontinueBool();
+        }
+        tok.push_back(c);
+        line_pos++;
+        break;
+
+    case 'a':
+        if (partial_tok_type != PartialToken::BOOL_FALSE || tok.size() != 1)
+        {
+            this->DiscontinueBool();
+        }
+        tok.push_back(c);
+        line_pos++;
+        break;
+
+    case 'l':
+        if (partial_tok_type != PartialToken::BOOL_FALSE || tok.size() != 2)
+        {
+            this->DiscontinueBool();
+        }
+        tok.push_back(c);
+        line_pos++;
+        break;
+
+    case 's':
+        if (partial_tok_type != PartialToken::BOOL_FALSE || tok.size() != 3)
+        {
+            this->DiscontinueBool();
+        }
+        tok.push_back(c);
+        line_pos++;
+        break;
+
+    case 'e':
+        if (partial_tok_type == PartialToken::BOOL_TRUE && tok.size() == 3)
+        {
+            doc.tokens.push_back({ TokenType::BOOL, 1.f });
+            tok.clear();
+            partial_tok_type = PartialToken::NONE;
+        }
+        else if (partial_tok_type == PartialToken::BOOL_FALSE && tok.size() == 4)
+        {
+            doc.tokens.push_back({ TokenType::BOOL, 0.f });
+            tok.clear();
+            partial_tok_type = PartialToken::NONE;
+        }
+        else
+        {
+            this->DiscontinueBool();
+            tok.push_back(c);
+        }
+        line_pos++;
+        break;
+
+    default:
+        this->DiscontinueBool();
+        tok.push_back(c);
+        line_pos++;
+        break;
+    }
+
+    if (partial_tok_type == PartialToken::GARBAGE)
+    {
+        App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_WARNING,
+            fmt::format("{}, line {}, pos {}: stray character '{}' in boolean", doc_name, line_num, line_pos, c));
+    }
+}
+
+void DocumentParser::DiscontinueBool()
+{
+    if (doc.tokens.size() == 0 || doc.tokens.back().type == TokenType::LINEBREAK)
+        partial_tok_type = PartialToken::KEYWORD;
+    else if (options & GenericDocument::OPTION_ALLOW_NAKED_STRINGS)
+        partial_tok_type = PartialToken::STRING_NAKED;
+    else
+        partial_tok_type = PartialToken::GARBAGE;
+}
+
+void DocumentParser::DiscontinueNumber()
+{
+    if (options & GenericDocument::OPTION_ALLOW_NAKED_STRINGS)
+        partial_tok_type = PartialToken::STRING_NAKED;
+    else
+        partial_tok_type = PartialToken::GARBAGE;
+}
+
+void DocumentParser::DiscontinueKeyword()
+{
+    if (options & GenericDocument::OPTION_ALLOW_NAKED_STRINGS)
+        partial_tok_type = PartialToken::STRING_NAKED;
+    else
+        partial_tok_type = PartialToken::GARBAGE;
+}
+
+void DocumentParser::UpdateKeyword(const char c)
+{
+    switch (c)
+    {
+    case '\r':
+        break;
+
+    case ' ':
+    case ',':
+    case '\t':
+        this->FlushStringishToken(TokenType::KEYWORD);
+        line_pos++;
+        break;
+
+    case '\n':
+        this->FlushStringishToken(TokenType::KEYWORD);
+        // Break line
+        doc.tokens.push_back({ TokenType::LINEBREAK, 0.f });
+        line_num++;
+        line_pos = 0;
+        break;
+
+    case ':':
+        if (options & GenericDocument::OPTION_ALLOW_SEPARATOR_COLON)
+        {
+            this->FlushStringishToken(TokenType::KEYWORD);
+        }
+        else
+        {
+            this->DiscontinueKeyword();
+            tok.push_back(c);
+        }
+        line_pos++;
+        break;
+
+    case '=':
+        if (options & GenericDocument::OPTION_ALLOW_SEPARATOR_EQUALS)
+        {
+            this->FlushStringishToken(TokenType::KEYWORD);
+        }
+        else
+        {
+            this->DiscontinueKeyword();
+            tok.push_back(c);
+        }
+        line_pos++;
+        break;
+
+    case '_':
+        tok.push_back(c);
+        line_pos++;
+        break;
+
+    case '(':
+        if (options & GenericDocument::OPTION_ALLOW_NAKED_STRINGS)
+        {
+            if (options & GenericDocument::OPTION_PARENTHESES_CAPTURE_SPACES)
+                partial_tok_type = PartialToken::STRING_NAKED_CAPTURING_SPACES;
+            else
+                partial_tok_type = PartialToken::STRING_NAKED;
+        }
+        else
+        {
+            partial_tok_type = PartialToken::GARBAGE;
+        }
+        tok.push_back(c);
+        line_pos++;
+        break;
+
+    case ']':
+        if (partial_tok_type == PartialToken::KEYWORD_BRACED)
+        {
+            partial_tok_type = PartialToken::KEYWORD; // Do not allow any more ']'.
+        }
+        else
+        {
+            this->DiscontinueKeyword();
+        }
+        tok.push_back(c);
+        line_pos++;
+        break;
+
+    default:
+        if (!isalnum(c))
+        {
+            this->DiscontinueKeyword();
+        }
+        tok.push_back(c);
+        line_pos++;
+        break;
+    }
+
+    if (partial_tok_type == PartialToken::GARBAGE)
+    {
+        App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_WARNING,
+            fmt::format("{}, line {}, pos {}: stray character '{}' in keyword", doc_name, line_num, line_pos, c));
+    }
+}
+
+void DocumentParser::UpdateTitle(const char c)
+{
+    switch (c)
+    {
+    case '\r':
+        break;
+
+    case '\n':
+        this->FlushStringishToken(TokenType::STRING);
+        // Break line
+        doc.tokens.push_back({ TokenType::LINEBREAK, 0.f });
+        line_num++;
+        line_pos = 0;
+        break;
+
+    default:
+        tok.push_back(c);
+        line_pos++;
+        break;
+    }
+}
+
+void DocumentParser::UpdateGarbage(const char c)
+{
+    switch (c)
+    {
+    case '\r':
+        break;
+
+    case ' ':
+    case ',':
+    case '\t':
+    case '\n':
+        tok.push_back('\0');
+        App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_WARNING,
+            fmt::format("{}, line {}, pos {}: discarding garbage token '{}'", doc_name, line_num, line_pos, tok.data()));
+        tok.clear();
+        partial_tok_type = PartialToken::NONE;
+        line_pos++;
+        break;
+
+    default:
+        tok.push_back(c);
+        line_pos++;
+        break;
+    }
+}
+
+void DocumentParser::FlushStringishToken(RoR::TokenType type)
+{
+    doc.tokens.push_back({ type, (float)doc.string_pool.size() });
+    tok.push_back('\0');
+    doc.string_pool.insert(doc.string_pool.end(), tok.begin(), tok.end());
+    tok.clear();
+    partial_tok_type = PartialToken::NONE;
+}
+
+void DocumentParser::FlushNumericToken()
+{
+    tok.push_back('\0');
+    if (partial_tok_type == PartialToken::NUMBER_INTEGER)
+    {
+        doc.tokens.push_back({ TokenType::INT, (float)Ogre::StringConverter::parseInt(tok.data()) });
+    }
+    else
+    {
+        doc.tokens.push_back({ TokenType::FLOAT, (float)Ogre::StringConverter::parseReal(tok.data()) });
+    }
+    tok.clear();
+    partial_tok_type = PartialToken::NONE;
+}
+
+inline bool IsDigitChar(const char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline bool IsKeywordChar(const char c) // Like `isalnum()` in "C" locale, plus '_'
+{
+    return IsDigitChar(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+inline bool IsNakedStringChar(const char c) // Characters which `UpdateString()` just appends, regardless of options
+{
+    return c != ' ' && c != ',' && c != '\t' && c != '\r' && c != '\n' && c != ':' && c != '=' && c != '"' && c != '(' && c != ')';
+}
+
+const char* FindLineEnd(const char* pos, const char* end) // First '\r' or '\n'
+{
+    const char* lf = static_cast<const char*>(memchr(pos, '\n', end - pos));
+    const char* line_end = (lf != nullptr) ? lf : end;
+    const char* cr = static_cast<const char*>(memchr(pos, '\r', line_end - pos));
+    return (cr != nullptr) ? cr : line_end;
+}
+
+/// Returns the end of the run of characters which the current state would just append to `tok`.
+/// Such runs are copied in bulk; everything else goes through `ProcessChar()`.
+const char* DocumentParser::FindSpanEnd(const char* pos, const char* end) const
+{
+    switch (partial_tok_type)
+    {
+    case PartialToken::COMMENT_SLASH:
+        if (tok.empty()) // Leading '/' are skipped
+            return pos;
+        return FindLineEnd(pos, end);
+
+    case PartialToken::COMMENT_SEMICOLON:
+    case PartialToken::COMMENT_HASH:
+    case PartialToken::TITLE_STRING:
+        return FindLineEnd(pos, end);
+
+    case PartialToken::STRING_QUOTED:
+        while (pos != end && *pos != '"' && *pos != '\n' && *pos != '\r')
+            pos++;
+        return pos;
+
+    case PartialToken::STRING_NAKED:
+    case PartialToken::STRING_NAKED_CAPTURING_SPACES:
+        while (pos != end && IsNakedStringChar(*pos))
+            pos++;
+        return pos;
+
+    case PartialToken::NUMBER_INTEGER:
+    case PartialToken::NUMBER_DECIMAL:
+    case PartialToken::NUMBER_SCIENTIFIC:
+        while (pos != end && IsDigitChar(*pos))
+            pos++;
+        return pos;
+
+    case PartialToken::KEYWORD:
+    case PartialToken::KEYWORD_BRACED:
+        while (pos != end && IsKeywordChar(*pos))
+            pos++;
+        return pos;
+
+    default:
+        return pos;
+    }
+}
+
+void DocumentParser::ProcessBuffer(const char* buf, const size_t len)
+{
+    const char* pos = buf;
+    const char* end = buf + len;
+    while (pos != end)
+    {
+        if (partial_tok_type == PartialToken::NONE)
+        {
+            // Skip separators
+            while (pos != end && (*pos == ' ' || *pos == ',' || *pos == '\t'))
+            {
+                line_pos++;
+                pos++;
+            }
+            if (pos == end)
+                break;
+            this->ProcessChar(*pos++);
+        }
+        else
+        {
+            const char* span_end = this->FindSpanEnd(pos, end);
+            if (span_end != pos)
+            {
+                tok.insert(tok.end(), pos, span_end);
+                line_pos += span_end - pos;
+                pos = span_end;
+            }
+            else
+            {
+                this->ProcessChar(*pos++);
+            }
+        }
+    }
+}
+
+void DocumentParser::ProcessChar(const char c)
+{
+    switch (partial_tok_type)
+    {
+    case PartialToken::NONE:
+        this->BeginToken(c);
+        break;
+
+    case PartialToken::COMMENT_SEMICOLON:
+    case PartialToken::COMMENT_SLASH:
+    case PartialToken::COMMENT_HASH:
+        this->UpdateComment(c);
+        break;
+
+    case PartialToken::STRING_QUOTED:
+    case PartialToken::STRING_NAKED:
+    case PartialToken::STRING_NAKED_CAPTURING_SPACES:
+        this->UpdateString(c);
+        break;
+
+    case PartialToken::NUMBER_INTEGER:
+    case PartialToken::NUMBER_STUB_MINUS:
+    case PartialToken::NUMBER_DECIMAL:
+    case PartialToken::NUMBER_SCIENTIFIC:
+    case PartialToken::NUMBER_SCIENTIFIC_STUB:
+    case PartialToken::NUMBER_SCIENTIFIC_STUB_MINUS:
+        this->UpdateNumber(c);
+        break;
+
+    case PartialToken::BOOL_TRUE:
+    case PartialToken::BOOL_FALSE:
+        this->UpdateBool(c);
+        break;
+
+    case PartialToken::KEYWORD:
+    case PartialToken::KEYWORD_BRACED:
+        this->UpdateKeyword(c);
+        break;
+
+    case PartialToken::TITLE_STRING:
+        this->UpdateTitle(c);
+        break;
+
+    case PartialToken::GARBAGE:
+        this->UpdateGarbage(c);
+        break;
+    }
+}
+
+void DocumentParser::ProcessEOF()
+{
+    // Flush any partial token
+    switch (partial_tok_type)
+    {
+    case PartialToken::STRING_QUOTED:
+    case PartialToken::STRING_NAKED_CAPTURING_SPACES:
+    case PartialToken::TITLE_STRING:
+        this->FlushStringishToken(TokenType::STRING);
+        break;
+
+    case PartialToken::KEYWORD_BRACED:
+        this->FlushStringishToken(TokenType::KEYWORD);
+        break;
+
+    default:
+        this->ProcessChar(' '); // Pretend processing a separator to flush any partial whitespace-incompatible token.
+        break;
+    }
+
+    // Ensure newline at end of file
+    if (doc.tokens.size() == 0 || doc.tokens.back().type != TokenType::LINEBREAK)
+    {
+        doc.tokens.push_back({ TokenType::LINEBREAK, 0.f });
+    }
+}
+
+void GenericDocument::reserveForTextSize(size_t text_size)
+{
+    tokens.reserve(text_size / 5 + 1);
+    string_pool.reserve(text_size + 1);
+}
+
+// ---------------------------------------------------------------------------
+// Corpus
+
+const char* EXAMPLE_DOCUMENT = R"(// Example addonpart, with tuneup-like tweaks
+addonpart_name "Heavy duty bumper + light bar"
+addonpart_description "Replaces the front bumper, adds a roof-mounted light bar and tweaks suspension nodes"
+addonpart_author -1 "Example Author"
+addonpart_guid "3b8a4f4e-98e6-4c4a-9f8b-2f1e2a7d1e01"
+addonpart_category 108
+
+addonpart_unwanted_prop 4
+addonpart_unwanted_prop 5
+addonpart_unwanted_flexbody 12
+addonpart_tweak_wheel 0 "tracks/wheelface" "tracks/wheelband" 0.535 0.38
+addonpart_tweak_wheel 1 "tracks/wheelface" "tracks/wheelband" 0.535 0.38
+addonpart_tweak_node 31, 1.2405, 0.8821, -0.4455
+addonpart_tweak_node 32, 1.2405, 0.8821, 0.4455
+addonpart_tweak_prop 2 -0.15 0.02 0.0, 0, 90, 0 "beacon.mesh"
+addonpart_tweak_flexbody 7, 0.5, 0.5, 0.0, 0.0, 180.0, 0.0, "bumper_heavy.mesh"
+
+props
+// ref, x, y, offsetX, offsetY, offsetZ, rotX, rotY, rotZ, mesh
+    1, 2, 3, 0.50, 0.25, 0.12, 90, 0, 180, lightbar_frame.mesh
+    1, 2, 3, 0.50, 0.25, 0.32, 90, 0, 180, lightbar_lamp_left.mesh
+    1, 2, 3, 0.50, 0.25, -0.32, 90, 0, 180, lightbar_lamp_right.mesh
+
+flares2
+// refnode, xnode, ynode, offsetx, offsety, offsetz, type, controlnumber, blinkdelay, size, materialname
+    1, 2, 3, 0.55, 0.30, 0.32, u, 1, 500, 0.3, tracks/beaconflare
+    1, 2, 3, 0.55, 0.30, -0.32, u, 1, 500, 0.3, tracks/beaconflare
+
+flexbodies
+    4, 5, 6, 0.5, 0.5, 0.0, 0.0, 180.0, 0.0, bumper_heavy.mesh
+forset 4-12, 31-46, 55, 56, 57, 58
+enable_advanced_deformation true
+managedmaterials
+    lightbar_lamp mesh_standard lightbar_lamp.dds lightbar_lamp_spec.png
+    bumper_heavy mesh_standard bumper_heavy.dds
+)";
+
+const BitMask_t CORPUS_OPTIONS = GenericDocument::OPTION_ALLOW_SLASH_COMMENTS | GenericDocument::OPTION_ALLOW_NAKED_STRINGS;
+
+std::vector<std::string> corpus_files;
+size_t corpus_bytes = 0;
+
+void PrepareBench_corpus(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::ifstream file(argv[i], std::ios::binary);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        corpus_files.push_back(contents.str());
+    }
+
+    if (corpus_files.empty())
+    {
+        corpus_files.push_back(EXAMPLE_DOCUMENT);
+    }
+
+    for (std::string const& text: corpus_files)
+    {
+        corpus_bytes += text.size();
+    }
+}
+
+// Same as `loadFromDataStream()` did before: fixed-size reads, one `ProcessChar()` per byte, no reservation.
+void Tokenize_sol1(GenericDocument& doc, std::string const& text)
+{
+    doc.tokens.clear();
+    doc.string_pool.clear();
+    DocumentParser parser(doc, CORPUS_OPTIONS, "corpus");
+    for (const char c: text)
+    {
+        parser.ProcessChar(c);
+    }
+    parser.ProcessEOF();
+}
+
+// Same as `GenericDocument::loadFromBuffer()`
+void Tokenize_sol2(GenericDocument& doc, std::string const& text)
+{
+    doc.tokens.clear();
+    doc.string_pool.clear();
+    doc.reserveForTextSize(text.size());
+    DocumentParser parser(doc, CORPUS_OPTIONS, "corpus");
+    parser.ProcessBuffer(text.data(), text.size());
+    parser.ProcessEOF();
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks - a new document per file, like the cache rebuild does.
+
+static void Bench_Corpus_sol1_PerChar(benchmark::State& state)
+{
+    while (state.KeepRunning())
+    {
+        for (std::string const& text: corpus_files)
+        {
+            GenericDocument doc;
+            Tokenize_sol1(doc, text);
+            benchmark::DoNotOptimize(doc.tokens.data());
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * corpus_bytes);
+}
+BENCHMARK(Bench_Corpus_sol1_PerChar);
+
+static void Bench_Corpus_sol2_Buffer(benchmark::State& state)
+{
+    while (state.KeepRunning())
+    {
+        for (std::string const& text: corpus_files)
+        {
+            GenericDocument doc;
+            Tokenize_sol2(doc, text);
+            benchmark::DoNotOptimize(doc.tokens.data());
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * corpus_bytes);
+}
+BENCHMARK(Bench_Corpus_sol2_Buffer);
+
+int main(int argc, char** argv)
+{
+    using namespace std;
+
+    // benchmark flags are removed from argv, leaving the corpus files
+    ::benchmark::Initialize(&argc, argv);
+
+    // prepare
+    cout << "Preparing..." << endl;
+    PrepareBench_corpus(argc, argv);
+
+    // verify - both solutions must produce identical documents
+    size_t num_tokens = 0;
+    size_t num_mismatches = 0;
+    for (std::string const& text: corpus_files)
+    {
+        GenericDocument doc1, doc2;
+        Tokenize_sol1(doc1, text);
+        Tokenize_sol2(doc2, text);
+        bool same = doc1.tokens.size() == doc2.tokens.size() && doc1.string_pool == doc2.string_pool;
+        for (size_t i = 0; same && i < doc1.tokens.size(); ++i)
+        {
+            same = doc1.tokens[i].type == doc2.tokens[i].type && doc1.tokens[i].data == doc2.tokens[i].data;
+        }
+        num_tokens += doc1.tokens.size();
+        num_mismatches += (same) ? 0 : 1;
+    }
+    cout << "Corpus: " << corpus_files.size() << " files, " << corpus_bytes << " bytes, " << num_tokens << " tokens; "
+         << "mismatched documents: " << num_mismatches << endl;
+
+    // run
+    cout << "Running..." << endl;
+    ::benchmark::RunSpecifiedBenchmarks();
+}
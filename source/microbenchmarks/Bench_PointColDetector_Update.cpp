@@ -0,0 +1,621 @@
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+// Inter-actor point collision (PointColDetector): per physics step, refresh cached node positions
+// and run one box query per collision cab triangle. Truck + trailer with more actors parked around the map;
+// partner set unchanged between steps.
+//  sol1 = original: positions refreshed by looping (all actors x points); kd-tree rebuilt lazily on every step
+//         (median partitioning of every visited slice - cheap, the order is kept from the previous step)
+//  sol2 = positions refreshed through cached pointers; same lazy kd-tree
+//  sol3 = like sol2, but the kd-tree topology is kept and the bounds are refit bottom-up in one pass
+//         (topology rebuilt every `REBUILD_INTERVAL` steps) - rejected: refit touches the whole tree,
+//         while the lazy rebuild only partitions the slices the queries visit.
+
+// ---------------------------------------------------------------------------
+// Minimal stand-ins
+
+struct Vec3
+{
+    float x, y, z;
+    Vec3() {}
+    Vec3(float _x, float _y, float _z): x(_x), y(_y), z(_z) {}
+    float operator[](int i) const { return (&x)[i]; }
+    float& operator[](int i) { return (&x)[i]; }
+};
+
+struct Node
+{
+    Vec3 AbsPosition;
+    Vec3 Velocity;
+};
+
+struct Actor
+{
+    int instance_id;
+    std::vector<Node> nodes;
+};
+
+const int NUM_ACTORS = 10;       // in the game, see `ActorManager::GetActors()`
+const int NUM_TRUCK_NODES = 600;
+const int NUM_TRAILER_NODES = 900;
+const int NUM_QUERIES = 500;   // collision cab triangles of the truck
+const int NUM_STEPS = 64;      // per benchmark iteration
+const float DT = 0.0005f;
+const float ENLARGE = 0.02f;   // ~ collision_range
+
+std::vector<Actor> actors;           // [0] = truck (querying actor), [1] = trailer, rest = parked
+std::vector<std::array<int, 3>> query_tris; // Truck node indices
+
+void StepNodes()
+{
+    for (int a = 0; a < 2; a++)
+    {
+        for (Node& n: actors[a].nodes)
+        {
+            n.AbsPosition.x += n.Velocity.x * DT;
+            n.AbsPosition.y += n.Velocity.y * DT;
+            n.AbsPosition.z += n.Velocity.z * DT;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// sol1, sol2
+
+namespace lazy {
+
+struct pointid_t { int actorid; int nodenum; };
+struct refelem_t
+{
+    int pidrefid;
+    std::array<float, 3> point;
+    void setPoint(const Vec3 pos) { point[0] = pos.x; point[1] = pos.y; point[2] = pos.z; }
+};
+struct kdnode_t { float min; int end; float max; int refid = -1; float middle; int begin; };
+
+std::vector<int> hit_list;
+std::vector<pointid_t> hit_pointid_list;
+std::vector<refelem_t> m_ref_list;
+std::vector<kdnode_t> m_kdtree;
+Vec3 m_bbmin, m_bbmax;
+int m_object_list_size;
+std::vector<const Vec3*> m_point_positions; // sol2; indexed like `hit_pointid_list`
+
+void partintwo(const int start, const int median, const int end, const int axis, float &minex, float &maxex)
+{
+    int i, j, l, m;
+    int k = median;
+    l = start;
+    m = end - 1;
+
+    float x = m_ref_list[k].point[axis];
+    while (l < m)
+    {
+        i = l;
+        j = m;
+        while (!(j < k || k < i))
+        {
+            while (m_ref_list[i].point[axis] < x) { i++; }
+            while (x < m_ref_list[j].point[axis]) { j--; }
+            std::swap(m_ref_list[i], m_ref_list[j]);
+            i++;
+            j--;
+        }
+        if (j < k) { l = i; }
+        if (k < i) { m = j; }
+        x = m_ref_list[k].point[axis];
+    }
+
+    minex = x;
+    maxex = x;
+    for (int i = start; i < median; ++i) { minex = std::min(m_ref_list[i].point[axis], minex); }
+    for (int i = median+1; i < end; ++i) { maxex = std::max(maxex, m_ref_list[i].point[axis]); }
+}
+
+void build_kdtree_incr(int axis, int index)
+{
+    int end = -m_kdtree[index].end;
+    m_kdtree[index].end = end;
+    int begin = m_kdtree[index].begin;
+    int median;
+    int slice_size = end - begin;
+    if (slice_size != 1)
+    {
+        int newindex=index+index+1;
+        if (slice_size == 2)
+        {
+            median = begin+1;
+            if (m_ref_list[begin].point[axis] > m_ref_list[median].point[axis])
+                std::swap(m_ref_list[begin], m_ref_list[median]);
+
+            m_kdtree[index].min = m_ref_list[begin].point[axis];
+            m_kdtree[index].max = m_ref_list[median].point[axis];
+            m_kdtree[index].middle = m_kdtree[index].max;
+            m_kdtree[index].refid = -1;
+
+            axis++;
+            if (axis >= 3) axis = 0;
+
+            m_kdtree[newindex].refid = begin;
+            m_kdtree[newindex].middle = m_ref_list[m_kdtree[newindex].refid].point[axis];
+            m_kdtree[newindex].min = m_kdtree[newindex].middle;
+            m_kdtree[newindex].max = m_kdtree[newindex].middle;
+            m_kdtree[newindex].end = median;
+            newindex++;
+
+            m_kdtree[newindex].refid = median;
+            m_kdtree[newindex].middle = m_ref_list[m_kdtree[newindex].refid].point[axis];
+            m_kdtree[newindex].min = m_kdtree[newindex].middle;
+            m_kdtree[newindex].max = m_kdtree[newindex].middle;
+            m_kdtree[newindex].end = end;
+            return;
+        }
+        else
+        {
+            median = begin + (slice_size / 2);
+            partintwo(begin, median, end, axis, m_kdtree[index].min, m_kdtree[index].max);
+        }
+
+        m_kdtree[index].middle = m_ref_list[median].point[axis];
+        m_kdtree[index].refid = -1;
+
+        m_kdtree[newindex].begin = begin;
+        m_kdtree[newindex].end = -median;
+
+        newindex++;
+        m_kdtree[newindex].begin = median;
+        m_kdtree[newindex].end = -end;
+    }
+    else
+    {
+        m_kdtree[index].refid = begin;
+        m_kdtree[index].middle = m_ref_list[m_kdtree[index].refid].point[axis];
+        m_kdtree[index].min = m_kdtree[index].middle;
+        m_kdtree[index].max = m_kdtree[index].middle;
+    }
+}
+
+void queryrec(int kdindex, int axis)
+{
+    for (;;)
+    {
+        if (m_kdtree[kdindex].end < 0)
+            build_kdtree_incr(axis, kdindex);
+
+        if (m_kdtree[kdindex].refid != -1)
+        {
+            const std::array<float, 3> point = m_ref_list[m_kdtree[kdindex].refid].point;
+            if (point[0] >= m_bbmin.x && point[0] <= m_bbmax.x &&
+                point[1] >= m_bbmin.y && point[1] <= m_bbmax.y &&
+                point[2] >= m_bbmin.z && point[2] <= m_bbmax.z)
+            {
+                hit_list.push_back(m_ref_list[m_kdtree[kdindex].refid].pidrefid);
+            }
+            return;
+        }
+
+        if (m_bbmax[axis] >= m_kdtree[kdindex].middle)
+        {
+            if (m_bbmin[axis] > m_kdtree[kdindex].max)
+                return;
+            int newaxis = axis + 1;
+            if (newaxis >= 3) newaxis = 0;
+            int newindex = kdindex + kdindex + 1;
+            if (m_bbmin[axis] <= m_kdtree[kdindex].middle)
+                queryrec(newindex, newaxis);
+            kdindex = newindex + 1;
+            axis = newaxis;
+        }
+        else
+        {
+            if (m_bbmax[axis] < m_kdtree[kdindex].min)
+                return;
+            kdindex = 2 * kdindex + 1;
+            axis++;
+            if (axis >= 3) axis = 0;
+        }
+    }
+}
+
+void Setup()
+{
+    // All trailer nodes are contactable for the truck
+    m_object_list_size = NUM_TRAILER_NODES;
+    m_ref_list.resize(m_object_list_size);
+    hit_pointid_list.resize(m_object_list_size);
+    for (int i = 0; i < NUM_TRAILER_NODES; i++)
+    {
+        hit_pointid_list[i].actorid = actors[1].instance_id;
+        hit_pointid_list[i].nodenum = i;
+        m_ref_list[i].pidrefid = i;
+        m_ref_list[i].setPoint(actors[1].nodes[i].AbsPosition);
+    }
+    m_point_positions.resize(m_object_list_size);
+    for (int i = 0; i < NUM_TRAILER_NODES; i++)
+    {
+        m_point_positions[i] = &actors[1].nodes[i].AbsPosition;
+    }
+    m_kdtree.resize(std::max(1.0, std::pow(2, std::ceil(std::log2(m_object_list_size)) + 1)));
+}
+
+void ResetRoot()
+{
+    m_kdtree[0].refid = -1;
+    m_kdtree[0].begin = 0;
+    m_kdtree[0].end = -m_object_list_size;
+}
+
+void Update_sol1()
+{
+    // refresh_node_positions()
+    for (Actor& actor: actors)
+    {
+        for (refelem_t& refelem: m_ref_list)
+        {
+            if (hit_pointid_list[refelem.pidrefid].actorid == actor.instance_id)
+                refelem.setPoint(actor.nodes[hit_pointid_list[refelem.pidrefid].nodenum].AbsPosition);
+        }
+    }
+    ResetRoot();
+}
+
+void Update_sol2()
+{
+    for (refelem_t& refelem: m_ref_list)
+    {
+        refelem.setPoint(*m_point_positions[refelem.pidrefid]);
+    }
+    ResetRoot();
+}
+
+} // namespace lazy
+
+// ---------------------------------------------------------------------------
+// sol3
+
+namespace refit {
+
+struct pointid_t { int actorid; int nodenum; };
+struct refelem_t
+{
+    int pidrefid;
+    std::array<float, 3> point;
+    const Vec3* abs_position;
+    void setPoint(const Vec3 pos) { point[0] = pos.x; point[1] = pos.y; point[2] = pos.z; }
+};
+struct kdnode_t
+{
+    float min;       // Slice bounds on the node's axis
+    float max;
+    float left_max;  // Children's bounds on the node's axis
+    float right_min;
+    int begin;
+    int end;
+    int refid = -1;
+};
+struct aabb_t { std::array<float, 3> min, max; };
+
+const int REBUILD_INTERVAL = 64;
+
+std::vector<int> hit_list;
+std::vector<pointid_t> hit_pointid_list;
+std::vector<refelem_t> m_ref_list;
+std::vector<kdnode_t> m_kdtree;
+Vec3 m_bbmin, m_bbmax;
+int m_object_list_size;
+int m_refits_left = 0;
+
+void partintwo(const int start, const int median, const int end, const int axis)
+{
+    // Same quickselect as lazy::partintwo(), without the bounds (they're computed by refit)
+    int i, j, l, m;
+    int k = median;
+    l = start;
+    m = end - 1;
+
+    float x = m_ref_list[k].point[axis];
+    while (l < m)
+    {
+        i = l;
+        j = m;
+        while (!(j < k || k < i))
+        {
+            while (m_ref_list[i].point[axis] < x) { i++; }
+            while (x < m_ref_list[j].point[axis]) { j--; }
+            std::swap(m_ref_list[i], m_ref_list[j]);
+            i++;
+            j--;
+        }
+        if (j < k) { l = i; }
+        if (k < i) { m = j; }
+        x = m_ref_list[k].point[axis];
+    }
+}
+
+void build_kdtree(int index, int axis, int begin, int end)
+{
+    kdnode_t& node = m_kdtree[index];
+    node.begin = begin;
+    node.end = end;
+    if (end - begin == 1)
+    {
+        node.refid = begin;
+        return;
+    }
+    node.refid = -1;
+    const int median = begin + (end - begin) / 2;
+    partintwo(begin, median, end, axis);
+    const int newaxis = (axis + 1) % 3;
+    build_kdtree(index * 2 + 1, newaxis, begin, median);
+    build_kdtree(index * 2 + 2, newaxis, median, end);
+}
+
+aabb_t refit_kdtree(int index, int axis)
+{
+    kdnode_t& node = m_kdtree[index];
+    aabb_t box;
+    if (node.refid != -1)
+    {
+        box.min = m_ref_list[node.refid].point;
+        box.max = box.min;
+    }
+    else
+    {
+        const int newaxis = (axis + 1) % 3;
+        const aabb_t left = refit_kdtree(index * 2 + 1, newaxis);
+        const aabb_t right = refit_kdtree(index * 2 + 2, newaxis);
+        for (int i = 0; i < 3; i++)
+        {
+            box.min[i] = std::min(left.min[i], right.min[i]);
+            box.max[i] = std::max(left.max[i], right.max[i]);
+        }
+        node.left_max = left.max[axis];
+        node.right_min = right.min[axis];
+    }
+    node.min = box.min[axis];
+    node.max = box.max[axis];
+    return box;
+}
+
+void queryrec(int kdindex, int axis)
+{
+    for (;;)
+    {
+        const kdnode_t& node = m_kdtree[kdindex];
+        if (m_bbmin[axis] > node.max || m_bbmax[axis] < node.min)
+            return;
+
+        if (node.refid != -1)
+        {
+            const std::array<float, 3>& point = m_ref_list[node.refid].point;
+            if (point[0] >= m_bbmin.x && point[0] <= m_bbmax.x &&
+                point[1] >= m_bbmin.y && point[1] <= m_bbmax.y &&
+                point[2] >= m_bbmin.z && point[2] <= m_bbmax.z)
+            {
+                hit_list.push_back(m_ref_list[node.refid].pidrefid);
+            }
+            return;
+        }
+
+        const bool visit_left = m_bbmin[axis] <= node.left_max;
+        const bool visit_right = m_bbmax[axis] >= node.right_min;
+        const int left_index = kdindex * 2 + 1;
+        axis = (axis + 1) % 3;
+        if (visit_left && visit_right)
+        {
+            queryrec(left_index, axis);
+            kdindex = left_index + 1;
+        }
+        else if (visit_left)
+            kdindex = left_index;
+        else if (visit_right)
+            kdindex = left_index + 1;
+        else
+            return;
+    }
+}
+
+void Setup()
+{
+    m_object_list_size = NUM_TRAILER_NODES;
+    m_ref_list.resize(m_object_list_size);
+    hit_pointid_list.resize(m_object_list_size);
+    for (int i = 0; i < NUM_TRAILER_NODES; i++)
+    {
+        hit_pointid_list[i].actorid = actors[1].instance_id;
+        hit_pointid_list[i].nodenum = i;
+        m_ref_list[i].pidrefid = i;
+        m_ref_list[i].abs_position = &actors[1].nodes[i].AbsPosition;
+        m_ref_list[i].setPoint(actors[1].nodes[i].AbsPosition);
+    }
+    m_kdtree.resize(std::max(1.0, std::pow(2, std::ceil(std::log2(m_object_list_size)) + 1)));
+    m_refits_left = 0;
+}
+
+void Update()
+{
+    for (refelem_t& refelem: m_ref_list)
+        refelem.setPoint(*refelem.abs_position);
+
+    if (m_refits_left == 0)
+    {
+        build_kdtree(0, 0, 0, m_object_list_size);
+        m_refits_left = REBUILD_INTERVAL;
+    }
+    m_refits_left--;
+    refit_kdtree(0, 0);
+}
+
+} // namespace refit
+
+// ---------------------------------------------------------------------------
+
+template <typename T>
+void RunQuery(int q, T& ns)
+{
+    const Vec3& v1 = actors[0].nodes[query_tris[q][0]].AbsPosition;
+    const Vec3& v2 = actors[0].nodes[query_tris[q][1]].AbsPosition;
+    const Vec3& v3 = actors[0].nodes[query_tris[q][2]].AbsPosition;
+    for (int a = 0; a < 3; a++)
+    {
+        ns.m_bbmin[a] = std::min(std::min(v1[a], v2[a]), v3[a]) - ENLARGE;
+        ns.m_bbmax[a] = std::max(std::max(v1[a], v2[a]), v3[a]) + ENLARGE;
+    }
+    ns.hit_list.clear();
+    ns.queryrec(0, 0);
+}
+
+struct LazyNs
+{
+    Vec3& m_bbmin = lazy::m_bbmin; Vec3& m_bbmax = lazy::m_bbmax; std::vector<int>& hit_list = lazy::hit_list;
+    void queryrec(int i, int a) { lazy::queryrec(i, a); }
+};
+struct RefitNs
+{
+    Vec3& m_bbmin = refit::m_bbmin; Vec3& m_bbmax = refit::m_bbmax; std::vector<int>& hit_list = refit::hit_list;
+    void queryrec(int i, int a) { refit::queryrec(i, a); }
+};
+
+void PrepareData()
+{
+    // Truck in front of the trailer, overlapping at the hitch; nodes on a jittered grid, moving together with some wobble.
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> jitter(-0.05f, 0.05f);
+    std::uniform_real_distribution<float> wobble(-0.5f, 0.5f);
+    actors.resize(NUM_ACTORS);
+    for (int a = 0; a < NUM_ACTORS; a++)
+    {
+        actors[a].instance_id = a + 1;
+        const int num_nodes = (a == 0) ? NUM_TRUCK_NODES : NUM_TRAILER_NODES;
+        const float start_z = (a == 0) ? 0.f : 3.0f * a; // Others parked behind, out of reach
+        actors[a].nodes.resize(num_nodes);
+        for (int i = 0; i < num_nodes; i++)
+        {
+            Node& n = actors[a].nodes[i];
+            n.AbsPosition = Vec3((i % 10) * 0.25f + jitter(rng), ((i / 10) % 10) * 0.3f + jitter(rng), start_z + (i / 100) * 0.6f + jitter(rng));
+            n.Velocity = Vec3(wobble(rng), wobble(rng), 15.f + wobble(rng));
+        }
+    }
+
+    std::uniform_int_distribution<int> pick(0, NUM_TRUCK_NODES - 1);
+    query_tris.resize(NUM_QUERIES);
+    for (auto& tri: query_tris)
+    {
+        const int n0 = pick(rng);
+        tri = { n0, std::min(n0 + 1, NUM_TRUCK_NODES - 1), std::min(n0 + 10, NUM_TRUCK_NODES - 1) };
+    }
+}
+
+std::vector<Actor> initial_actors;
+
+template <typename NS, void (*SETUP)(), void (*UPDATE)()>
+void RunSteps(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        actors = initial_actors;
+        SETUP();
+        state.ResumeTiming();
+        for (int s = 0; s < NUM_STEPS; s++)
+        {
+            StepNodes();
+            UPDATE();
+            NS ns;
+            for (int q = 0; q < NUM_QUERIES; q++)
+            {
+                RunQuery(q, ns);
+                benchmark::DoNotOptimize(ns.hit_list.data());
+            }
+        }
+    }
+}
+
+static void Bench_sol1__ActorsTimesPoints_LazyRebuild(benchmark::State& state)
+{
+    RunSteps<LazyNs, lazy::Setup, lazy::Update_sol1>(state);
+}
+BENCHMARK(Bench_sol1__ActorsTimesPoints_LazyRebuild);
+
+static void Bench_sol2__CachedPointers_LazyRebuild(benchmark::State& state)
+{
+    RunSteps<LazyNs, lazy::Setup, lazy::Update_sol2>(state);
+}
+BENCHMARK(Bench_sol2__CachedPointers_LazyRebuild);
+
+static void Bench_sol3__CachedPointers_Refit(benchmark::State& state)
+{
+    RunSteps<RefitNs, refit::Setup, refit::Update>(state);
+}
+BENCHMARK(Bench_sol3__CachedPointers_Refit);
+
+// ---------------------------------------------------------------------------
+
+void VerifyResults()
+{
+    // Same hits (as sets) for every query of every step; sol2 shares the kd-tree with sol1, compare both refreshes.
+    std::vector<Actor> actors_copy;
+    size_t num_mismatches_sol2 = 0;
+    size_t num_mismatches_sol3 = 0;
+    size_t num_hits = 0;
+    for (int s = 0; s < NUM_STEPS * 3; s++)
+    {
+        // sol1 vs sol2: refresh only, on the same positions
+        StepNodes();
+        if (s == 0)
+        {
+            lazy::Setup();
+            refit::Setup();
+        }
+        lazy::Update_sol1();
+        std::vector<lazy::refelem_t> refs_sol1 = lazy::m_ref_list;
+        lazy::Update_sol2();
+        for (size_t i = 0; i < refs_sol1.size(); i++)
+        {
+            if (refs_sol1[i].point != lazy::m_ref_list[i].point)
+                num_mismatches_sol2++;
+        }
+
+        refit::Update();
+        LazyNs ns1;
+        RefitNs ns3;
+        for (int q = 0; q < NUM_QUERIES; q++)
+        {
+            RunQuery(q, ns1);
+            RunQuery(q, ns3);
+            std::set<int> hits1(lazy::hit_list.begin(), lazy::hit_list.end());
+            std::set<int> hits3(refit::hit_list.begin(), refit::hit_list.end());
+            num_hits += hits1.size();
+            if (hits1 != hits3)
+                num_mismatches_sol3++;
+        }
+    }
+    std::cout << "sol2: " << num_mismatches_sol2 << " points refreshed differently than sol1" << std::endl;
+    std::cout << "sol3: " << num_mismatches_sol3 << " queries with different hits than sol1 (" << num_hits << " hits total)" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    using namespace std;
+
+    // prepare
+    cout << "Preparing..." << endl;
+    PrepareData();
+    initial_actors = actors;
+    VerifyResults();
+
+    // benchmark
+    ::benchmark::Initialize(&argc, argv);
+    ::benchmark::RunSpecifiedBenchmarks();
+#ifdef _MSC_VER
+    system("pause");
+#endif
+    return 0;
+}
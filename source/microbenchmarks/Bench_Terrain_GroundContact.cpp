@@ -0,0 +1,271 @@
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Terrain height + normal under a node, as done by Collisions::groundCollision() for every node, every physics step:
+//  sol1 = original: TerrainGeometryManager::getHeightAt() (terrain-space plane built from cross products)
+//         + getNormalAt() (two more getHeightAt() for finite differences)
+//  sol2 = single lookup in grid space; height interpolated within the triangle, normal from its slopes
+
+// ---------------------------------------------------------------------------
+// Minimal stand-in for Ogre::Vector3
+
+struct Vec3
+{
+    float x, y, z;
+    Vec3() {}
+    Vec3(float _x, float _y, float _z): x(_x), y(_y), z(_z) {}
+    Vec3 operator-(Vec3 const& o) const { return Vec3(x - o.x, y - o.y, z - o.z); }
+    float dotProduct(Vec3 const& o) const { return x*o.x + y*o.y + z*o.z; }
+    Vec3 crossProduct(Vec3 const& o) const { return Vec3(y * o.z - z * o.y, z * o.x - x * o.z, x * o.y - y * o.x); }
+    void normalise() { float len = std::sqrt(x*x + y*y + z*z); if (len > 1e-08f) { x /= len; y /= len; z /= len; } }
+};
+
+// Terrain like a typical 2km map: 1025x1025 samples, centered at (1024, 0, 1024)
+const int   SIZE = 1025;
+const float WORLD_SIZE = 2048.f;
+const float POS_X = 1024.f, POS_Z = 1024.f;
+const float BASE = -WORLD_SIZE * 0.5f;
+const float SCALE = WORLD_SIZE / (SIZE - 1);
+const float WATER_BOTTOM_HEIGHT = -30.f;
+const int   NUM_QUERIES = 10000; // ~ nodes of a few actors
+
+std::vector<float> height_data;
+std::vector<Vec3>  queries;
+std::vector<float> out_heights;
+std::vector<Vec3>  out_normals;
+
+// ---------------------------------------------------------------------------
+// sol1
+
+float GetHeightAtTerrainPosition_sol1(float x, float y)
+{
+    const float* mHeightData = height_data.data();
+    const int mSize = SIZE;
+
+    float factor = (float)mSize - 1.0f;
+    float invFactor = 1.0f / factor;
+
+    long startX = static_cast<long>(x * factor);
+    long startY = static_cast<long>(y * factor);
+    long endX = startX + 1;
+    long endY = startY + 1;
+
+    float startXTS = startX * invFactor;
+    float startYTS = startY * invFactor;
+    float endXTS = endX * invFactor;
+    float endYTS = endY * invFactor;
+
+    float xParam = (x * factor - startX);
+    float yParam = (y * factor - startY);
+
+    Vec3 v0(startXTS, startYTS, mHeightData[startY * mSize + startX]);
+    Vec3 v1(endXTS  , startYTS, mHeightData[startY * mSize + endX]);
+    Vec3 v2(endXTS  , endYTS  , mHeightData[endY   * mSize + endX]);
+    Vec3 v3(startXTS, endYTS  , mHeightData[endY   * mSize + startX]);
+
+    Vec3 normal;
+    float d;
+    if (startY % 2)
+    {
+        bool secondTri = ((1.0 - yParam) > xParam);
+        if (secondTri)
+        {
+            normal = (v1 - v0).crossProduct(v3 - v0);
+            d = -normal.dotProduct(v0);
+        }
+        else
+        {
+            normal = (v2 - v1).crossProduct(v3 - v1);
+            d = -normal.dotProduct(v1);
+        }
+    }
+    else
+    {
+        bool secondTri = (yParam > xParam);
+        if (secondTri)
+        {
+            normal = (v2 - v0).crossProduct(v3 - v0);
+            d = -normal.dotProduct(v0);
+        }
+        else
+        {
+            normal = (v1 - v0).crossProduct(v2 - v0);
+            d = -normal.dotProduct(v0);
+        }
+    }
+
+    return (-normal.x * x - normal.y * y - d) / normal.z;
+}
+
+float GetHeightAt_sol1(float x, float z)
+{
+    float tx = (x - BASE - POS_X) / ((SIZE - 1) *  SCALE);
+    float ty = (z + BASE - POS_Z) / ((SIZE - 1) * -SCALE);
+
+    if (tx <= 0.0f || ty <= 0.0f || tx >= 1.0f || ty >= 1.0f)
+        return WATER_BOTTOM_HEIGHT;
+
+    return GetHeightAtTerrainPosition_sol1(tx, ty);
+}
+
+Vec3 GetNormalAt_sol1(float x, float y, float z)
+{
+    const float precision = 0.1f;
+    Vec3 normal(GetHeightAt_sol1(x - precision, z) - y, precision, y - GetHeightAt_sol1(x, z + precision));
+    normal.normalise();
+    return normal;
+}
+
+static void Bench_sol1__PlanePlusFiniteDifferences(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        for (int i = 0; i < NUM_QUERIES; i++)
+        {
+            out_heights[i] = GetHeightAt_sol1(queries[i].x, queries[i].z);
+            out_normals[i] = GetNormalAt_sol1(queries[i].x, out_heights[i], queries[i].z);
+        }
+        benchmark::DoNotOptimize(out_heights.data());
+        benchmark::DoNotOptimize(out_normals.data());
+    }
+}
+BENCHMARK(Bench_sol1__PlanePlusFiniteDifferences);
+
+// ---------------------------------------------------------------------------
+// sol2
+
+const float INV_SCALE = 1.f / SCALE;
+
+float GetHeightAtGrid_sol2(float gx, float gy, Vec3* out_normal)
+{
+    const int cell_x = static_cast<int>(gx);
+    const int cell_y = static_cast<int>(gy);
+    const float fx = gx - cell_x;
+    const float fy = gy - cell_y;
+
+    const float* row0 = height_data.data() + cell_y * SIZE + cell_x;
+    const float* row1 = row0 + SIZE;
+    const float h0 = row0[0], h1 = row0[1], h2 = row1[1], h3 = row1[0];
+
+    float base, slope_x, slope_y;
+    if (cell_y % 2)
+    {
+        if ((1.f - fy) > fx) { base = h0;           slope_x = h1 - h0; slope_y = h3 - h0; }
+        else                 { base = h1 + h3 - h2; slope_x = h2 - h3; slope_y = h2 - h1; }
+    }
+    else
+    {
+        if (fy > fx)         { base = h0;           slope_x = h2 - h3; slope_y = h3 - h0; }
+        else                 { base = h0;           slope_x = h1 - h0; slope_y = h2 - h1; }
+    }
+
+    if (out_normal)
+    {
+        *out_normal = Vec3(-slope_x * INV_SCALE, 1.f, slope_y * INV_SCALE);
+        out_normal->normalise();
+    }
+    return base + slope_x * fx + slope_y * fy;
+}
+
+float GetHeightAndNormalAt_sol2(float x, float z, Vec3& out_normal)
+{
+    const float gx = (x - BASE - POS_X) * INV_SCALE;
+    const float gy = (POS_Z - BASE - z) * INV_SCALE;
+    if (gx <= 0.f || gy <= 0.f || gx >= SIZE - 1 || gy >= SIZE - 1)
+    {
+        out_normal = Vec3(0.f, 1.f, 0.f);
+        return WATER_BOTTOM_HEIGHT;
+    }
+    return GetHeightAtGrid_sol2(gx, gy, &out_normal);
+}
+
+static void Bench_sol2__GridSpaceSlopes(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        for (int i = 0; i < NUM_QUERIES; i++)
+        {
+            out_heights[i] = GetHeightAndNormalAt_sol2(queries[i].x, queries[i].z, out_normals[i]);
+        }
+        benchmark::DoNotOptimize(out_heights.data());
+        benchmark::DoNotOptimize(out_normals.data());
+    }
+}
+BENCHMARK(Bench_sol2__GridSpaceSlopes);
+
+// ---------------------------------------------------------------------------
+
+void PrepareData()
+{
+    // Rolling hills + noise
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+    height_data.resize(SIZE * SIZE);
+    for (int y = 0; y < SIZE; y++)
+    {
+        for (int x = 0; x < SIZE; x++)
+        {
+            height_data[y * SIZE + x] = 40.f + 25.f * std::sin(x * 0.02f) * std::cos(y * 0.03f) + noise(rng);
+        }
+    }
+
+    // Nodes of actors driving around; a few near the edges
+    std::uniform_real_distribution<float> pos(-50.f, WORLD_SIZE + 50.f);
+    queries.resize(NUM_QUERIES);
+    for (Vec3& q : queries)
+    {
+        q = Vec3(pos(rng), 0.f, pos(rng));
+    }
+    out_heights.resize(NUM_QUERIES);
+    out_normals.resize(NUM_QUERIES);
+}
+
+void VerifyResults()
+{
+    float max_height_err = 0.f;
+    float max_normal_err = 0.f;
+    for (int i = 0; i < NUM_QUERIES; i++)
+    {
+        const float ref_height = GetHeightAt_sol1(queries[i].x, queries[i].z);
+        Vec3 ref_normal = GetNormalAt_sol1(queries[i].x, ref_height, queries[i].z);
+        Vec3 normal;
+        const float height = GetHeightAndNormalAt_sol2(queries[i].x, queries[i].z, normal);
+        max_height_err = std::max(max_height_err, std::abs(height - ref_height));
+
+        // Finite differences cross into the neighbour triangle near the edges, only compare well inside.
+        const float gx = (queries[i].x - BASE - POS_X) / SCALE;
+        const float gy = (POS_Z - BASE - queries[i].z) / SCALE;
+        const float fx = gx - std::floor(gx), fy = gy - std::floor(gy);
+        const float margin = 0.1f / SCALE;
+        if (gx > 1.f && gy > 1.f && gx < SIZE - 2 && gy < SIZE - 2
+            && fx > margin && fx < 1.f - margin && fy > margin && fy < 1.f - margin
+            && std::abs(fx - fy) > margin && std::abs(1.f - fy - fx) > margin)
+        {
+            Vec3 diff = normal - ref_normal;
+            max_normal_err = std::max(max_normal_err, std::sqrt(diff.dotProduct(diff)));
+        }
+    }
+    std::cout << "sol2: max difference from sol1: height " << max_height_err << ", normal " << max_normal_err << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    using namespace std;
+
+    // prepare
+    cout << "Preparing..." << endl;
+    PrepareData();
+    VerifyResults();
+
+    // benchmark
+    ::benchmark::Initialize(&argc, argv);
+    ::benchmark::RunSpecifiedBenchmarks();
+#ifdef _MSC_VER
+    system("pause");
+#endif
+    return 0;
+}
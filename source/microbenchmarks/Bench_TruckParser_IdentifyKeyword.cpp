@@ -1,7 +1,13 @@
 
 #include "benchmark/benchmark.h"
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <regex>
 #include <iostream>
+#include <string>
+#include <vector>
 
     enum Keyword
     {
@@ -1841,17 +1847,414 @@ static void Bench_sol2b_SwitchPreCond(benchmark::State& state)
 }
 BENCHMARK(Bench_sol2b_SwitchPreCond);
 
+// ################################# Solution 3 - hashtable ######################################
+// Same approach as `RigDef::Parser::IdentifyKeyword()`: look up the leading word
+// in a case-insensitive hashtable, then check what follows the keyword.
+
+enum KeywordForm
+{
+    FORM_BLOCK,          // Alone on line
+    FORM_INLINE,         // Followed by space and arguments
+    FORM_INLINE_TOLERANT // Followed by space or comma and arguments
+};
+
+struct KeywordDef
+{
+    const char* name;
+    KeywordForm form;
+};
+
+// Indexed by Keyword - 1
+const KeywordDef KEYWORD_DEFS[] =
+{
+    { "add_animation",                 FORM_INLINE_TOLERANT },
+    { "airbrakes",                     FORM_BLOCK },
+    { "animators",                     FORM_BLOCK },
+    { "AntiLockBrakes",                FORM_INLINE },
+    { "axles",                         FORM_BLOCK },
+    { "author",                        FORM_INLINE },
+    { "backmesh",                      FORM_BLOCK },
+    { "beams",                         FORM_BLOCK },
+    { "brakes",                        FORM_BLOCK },
+    { "cab",                           FORM_BLOCK },
+    { "camerarail",                    FORM_BLOCK },
+    { "cameras",                       FORM_BLOCK },
+    { "cinecam",                       FORM_BLOCK },
+    { "collisionboxes",                FORM_BLOCK },
+    { "commands",                      FORM_BLOCK },
+    { "commands2",                     FORM_BLOCK },
+    { "contacters",                    FORM_BLOCK },
+    { "cruisecontrol",                 FORM_INLINE },
+    { "description",                   FORM_BLOCK },
+    { "detacher_group",                FORM_INLINE },
+    { "disabledefaultsounds",          FORM_BLOCK },
+    { "enable_advanced_deformation",   FORM_BLOCK },
+    { "end",                           FORM_BLOCK },
+    { "end_section",                   FORM_BLOCK },
+    { "engine",                        FORM_BLOCK },
+    { "engoption",                     FORM_BLOCK },
+    { "engturbo",                      FORM_BLOCK },
+    { "envmap",                        FORM_BLOCK },
+    { "exhausts",                      FORM_BLOCK },
+    { "extcamera",                     FORM_INLINE },
+    { "fileformatversion",             FORM_INLINE },
+    { "fileinfo",                      FORM_INLINE },
+    { "fixes",                         FORM_BLOCK },
+    { "flares",                        FORM_BLOCK },
+    { "flares2",                       FORM_BLOCK },
+    { "flexbodies",                    FORM_BLOCK },
+    { "flexbody_camera_mode",          FORM_INLINE },
+    { "flexbodywheels",                FORM_BLOCK },
+    { "forwardcommands",               FORM_BLOCK },
+    { "fusedrag",                      FORM_BLOCK },
+    { "globals",                       FORM_BLOCK },
+    { "guid",                          FORM_INLINE },
+    { "guisettings",                   FORM_BLOCK },
+    { "help",                          FORM_BLOCK },
+    { "hideInChooser",                 FORM_BLOCK },
+    { "hookgroup",                     FORM_BLOCK },
+    { "hooks",                         FORM_BLOCK },
+    { "hydros",                        FORM_BLOCK },
+    { "importcommands",                FORM_BLOCK },
+    { "lockgroups",                    FORM_BLOCK },
+    { "lockgroup_default_nolock",      FORM_BLOCK },
+    { "managedmaterials",              FORM_BLOCK },
+    { "materialflarebindings",         FORM_BLOCK },
+    { "meshwheels",                    FORM_BLOCK },
+    { "meshwheels2",                   FORM_BLOCK },
+    { "minimass",                      FORM_BLOCK },
+    { "nodecollision",                 FORM_BLOCK },
+    { "nodes",                         FORM_BLOCK },
+    { "nodes2",                        FORM_BLOCK },
+    { "particles",                     FORM_BLOCK },
+    { "pistonprops",                   FORM_BLOCK },
+    { "prop_camera_mode",              FORM_INLINE },
+    { "props",                         FORM_BLOCK },
+    { "railgroups",                    FORM_BLOCK },
+    { "rescuer",                       FORM_BLOCK },
+    { "rigidifiers",                   FORM_BLOCK },
+    { "rollon",                        FORM_BLOCK },
+    { "ropables",                      FORM_BLOCK },
+    { "ropes",                         FORM_BLOCK },
+    { "rotators",                      FORM_BLOCK },
+    { "rotators2",                     FORM_BLOCK },
+    { "screwprops",                    FORM_BLOCK },
+    { "section",                       FORM_INLINE },
+    { "sectionconfig",                 FORM_INLINE },
+    { "set_beam_defaults",             FORM_INLINE },
+    { "set_beam_defaults_scale",       FORM_INLINE },
+    { "set_collision_range",           FORM_INLINE },
+    { "set_inertia_defaults",          FORM_INLINE },
+    { "set_managedmaterials_options",  FORM_INLINE },
+    { "set_node_defaults",             FORM_INLINE },
+    { "set_shadows",                   FORM_BLOCK },
+    { "set_skeleton_settings",         FORM_INLINE },
+    { "shocks",                        FORM_BLOCK },
+    { "shocks2",                       FORM_BLOCK },
+    { "slidenode_connect_instantly",   FORM_BLOCK },
+    { "slidenodes",                    FORM_BLOCK },
+    { "SlopeBrake",                    FORM_INLINE },
+    { "soundsources",                  FORM_BLOCK },
+    { "soundsources2",                 FORM_BLOCK },
+    { "speedlimiter",                  FORM_INLINE },
+    { "submesh",                       FORM_BLOCK },
+    { "submesh_groundmodel",           FORM_INLINE },
+    { "texcoords",                     FORM_BLOCK },
+    { "ties",                          FORM_BLOCK },
+    { "torquecurve",                   FORM_BLOCK },
+    { "TractionControl",               FORM_INLINE },
+    { "triggers",                      FORM_BLOCK },
+    { "turbojets",                     FORM_BLOCK },
+    { "turboprops",                    FORM_BLOCK },
+    { "turboprops2",                   FORM_BLOCK },
+    { "videocamera",                   FORM_BLOCK },
+    { "wheeldetachers",                FORM_BLOCK },
+    { "wheels",                        FORM_BLOCK },
+    { "wheels2",                       FORM_BLOCK },
+    { "wings",                         FORM_BLOCK }
+};
+
+const size_t NUM_KEYWORDS = sizeof(KEYWORD_DEFS) / sizeof(KeywordDef);
+const size_t NUM_SLOTS = 512; // Power of 2
+const size_t SLOT_MASK = NUM_SLOTS - 1;
+
+struct KeywordSlot
+{
+    unsigned keyword;  // 0 = empty
+    size_t   name_len;
+};
+
+KeywordSlot keyword_slots[NUM_SLOTS];
+
+inline char ToLowerAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (c + ('a' - 'A')) : c;
+}
+
+inline bool IsKeywordChar(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || (c == '_');
+}
+
+inline bool IsBlank(char c)
+{
+    return (c == ' ') || (c == '\t');
+}
+
+inline size_t HashNocase(const char* str, size_t len) // FNV-1a
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; ++i)
+    {
+        hash = (hash ^ static_cast<unsigned char>(ToLowerAscii(str[i]))) * 16777619u;
+    }
+    return hash;
+}
+
+void PrepareBench_sol3()
+{
+    for (size_t i = 0; i < NUM_KEYWORDS; ++i)
+    {
+        const size_t len = strlen(KEYWORD_DEFS[i].name);
+        size_t slot = HashNocase(KEYWORD_DEFS[i].name, len) & SLOT_MASK;
+        while (keyword_slots[slot].keyword != 0)
+        {
+            slot = (slot + 1) & SLOT_MASK;
+        }
+        keyword_slots[slot].keyword = (unsigned)(i + 1);
+        keyword_slots[slot].name_len = len;
+    }
+}
+
+Keyword IdentifyKeywordHashtable(const char* line)
+{
+    const char* pos = line;
+    while (IsKeywordChar(*pos))
+    {
+        ++pos;
+    }
+    const size_t len = pos - line;
+    if (len == 0)
+    {
+        return KEYWORD_INVALID;
+    }
+
+    for (size_t slot = HashNocase(line, len) & SLOT_MASK; keyword_slots[slot].keyword != 0; slot = (slot + 1) & SLOT_MASK)
+    {
+        KeywordSlot const& s = keyword_slots[slot];
+        if (s.name_len != len)
+        {
+            continue;
+        }
+        KeywordDef const& def = KEYWORD_DEFS[s.keyword - 1];
+        size_t i = 0;
+        while (i < len && ToLowerAscii(def.name[i]) == ToLowerAscii(line[i]))
+        {
+            ++i;
+        }
+        if (i != len)
+        {
+            continue;
+        }
+
+        switch (def.form)
+        {
+        case FORM_BLOCK:
+            while (IsBlank(*pos)) { ++pos; }
+            return (*pos == '\0') ? (Keyword)s.keyword : KEYWORD_INVALID;
+        case FORM_INLINE:
+            return IsBlank(*pos) ? (Keyword)s.keyword : KEYWORD_INVALID;
+        default:
+            return (IsBlank(*pos) || *pos == ',') ? (Keyword)s.keyword : KEYWORD_INVALID;
+        }
+    }
+    return KEYWORD_INVALID;
+}
+
+static void Bench_sol3__Hashtable(benchmark::State& state)
+{
+    while (state.KeepRunning()) 
+    {
+        int count = sizeof(trucklines)/sizeof(const char*);
+        for (int i = 0; i < count; ++i)
+        {
+            keyword = (int) IdentifyKeywordHashtable(trucklines[i]);
+        }
+    }
+}
+BENCHMARK(Bench_sol3__Hashtable);
+
+// ################################# Whole corpus ######################################
+// Pass truck files on command line (after benchmark flags) to run these on real data,
+// i.e. `Bench_TruckParser_IdentifyKeyword --benchmark_filter=Corpus *.truck *.load`
+// Without files, the example truck above is used. Lines are trimmed like `RigDef::Parser` does.
+
+std::vector<std::string> corpus_lines;
+
+void AddCorpusLine(std::string line)
+{
+    const size_t first = line.find_first_not_of(" \t\r\n");
+    const size_t last = line.find_last_not_of(" \t\r\n");
+    corpus_lines.push_back((first == std::string::npos) ? "" : line.substr(first, (last - first) + 1));
+}
+
+void PrepareBench_corpus(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::ifstream file(argv[i]);
+        std::string line;
+        while (std::getline(file, line))
+        {
+            AddCorpusLine(line);
+        }
+    }
+
+    if (corpus_lines.empty())
+    {
+        for (const char* line: trucklines)
+        {
+            AddCorpusLine(line);
+        }
+    }
+}
+
+inline bool IsCorpusKeywordCandidate(std::string const& line) // The parser's quick check
+{
+    const char c = ToLowerAscii(line.c_str()[0]);
+    return (c >= 'a' && c <= 'z');
+}
+
+// Same as `RigDef::Parser::TokenizeCurrentLine()`
+struct Token
+{
+    const char* start;
+    int         length;
+};
+
+const int LINE_MAX_ARGS = 100;
+Token line_args[LINE_MAX_ARGS];
+
+inline bool IsSeparator(char c)
+{
+    return IsBlank(c) || (c == ':') || (c == '|') || (c == ',');
+}
+
+int TokenizeLine(const char* line)
+{
+    int cur_arg = 0;
+    const char* cur_char = line;
+    int arg_len = 0;
+    while ((*cur_char != '\0') && (cur_arg < LINE_MAX_ARGS))
+    {
+        const bool is_arg = !IsSeparator(*cur_char);
+        if ((arg_len == 0) && is_arg)
+        {
+            line_args[cur_arg].start = cur_char;
+            arg_len = 1;
+        }
+        else if ((arg_len > 0) && !is_arg)
+        {
+            line_args[cur_arg].length = arg_len;
+            arg_len = 0;
+            ++cur_arg;
+        }
+        else if (is_arg)
+        {
+            ++arg_len;
+        }
+        ++cur_char;
+    }
+    if (arg_len > 0)
+    {
+        line_args[cur_arg].length = arg_len;
+        ++cur_arg;
+    }
+    return cur_arg;
+}
+
+static void Bench_Corpus_sol1_Regex(benchmark::State& state)
+{
+    std::smatch results;
+    while (state.KeepRunning()) 
+    {
+        for (std::string const& line: corpus_lines)
+        {
+            if (IsCorpusKeywordCandidate(line))
+            {
+                std::regex_search(line, results, IDENTIFY_KEYWORD_IGNORE_CASE); // Always returns true.
+                keyword = FindKeywordMatch(results);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * corpus_lines.size());
+}
+BENCHMARK(Bench_Corpus_sol1_Regex);
+
+static void Bench_Corpus_sol3_Hashtable(benchmark::State& state)
+{
+    while (state.KeepRunning()) 
+    {
+        for (std::string const& line: corpus_lines)
+        {
+            if (IsCorpusKeywordCandidate(line))
+            {
+                keyword = (int) IdentifyKeywordHashtable(line.c_str());
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * corpus_lines.size());
+}
+BENCHMARK(Bench_Corpus_sol3_Hashtable);
+
+static void Bench_Corpus_sol3_HashtableTokenize(benchmark::State& state)
+{
+    // Full per-line pass of the parser: split to arguments, then identify keyword.
+    while (state.KeepRunning()) 
+    {
+        for (std::string const& line: corpus_lines)
+        {
+            keyword = TokenizeLine(line.c_str());
+            if (IsCorpusKeywordCandidate(line))
+            {
+                keyword = (int) IdentifyKeywordHashtable(line.c_str());
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * corpus_lines.size());
+}
+BENCHMARK(Bench_Corpus_sol3_HashtableTokenize);
+
 int main(int argc, char** argv)
 {
     using namespace std;
 
+    // benchmark flags are removed from argv, leaving the corpus files
+    ::benchmark::Initialize(&argc, argv);  
+
     // prepare
     cout << "Preparing..." << endl;
     PrepareBench_sol1();
+    PrepareBench_sol3();
+    PrepareBench_corpus(argc, argv);
+
+    // verify solution 3 against the regex
+    size_t num_mismatches = 0;
+    for (std::string const& line: corpus_lines)
+    {
+        std::smatch results;
+        std::regex_search(line, results, IDENTIFY_KEYWORD_IGNORE_CASE);
+        const unsigned expected = FindKeywordMatch(results);
+        const unsigned actual = (unsigned) IdentifyKeywordHashtable(line.c_str());
+        if (expected != actual && !(expected == INT_MAX && actual == (unsigned) KEYWORD_INVALID))
+        {
+            ++num_mismatches;
+        }
+    }
+    cout << "Corpus: " << corpus_lines.size() << " lines, keyword mismatches (regex vs. hashtable): " << num_mismatches << endl;
 
 
     // benchmark
-    ::benchmark::Initialize(&argc, argv);  
     ::benchmark::RunSpecifiedBenchmarks(); 
 #ifdef _MSC_VER
     system("pause");